@@ -28,68 +28,9 @@ struct AdxHeaderInfo {
   int16_t Hist2_R;
 };
 
-// Thanks https://github.com/kode54/vgmstream/blob/master/src/util.h
-
-static int nibble_to_int[16] = {0,  1,  2,  3,  4,  5,  6,  7,
-                                -8, -7, -6, -5, -4, -3, -2, -1};
-
-static inline int get_high_nibble_signed(uint8_t n) {
-  return nibble_to_int[n >> 4];
-}
-
-static inline int get_low_nibble_signed(uint8_t n) {
-  return nibble_to_int[n & 0xf];
-}
-
-static inline int clamp16(int32_t val) {
-  if (val > 32767) return 32767;
-  if (val < -32768) return -32768;
-  return val;
-}
-
-void AdxAudioStream::SetCoefficients(double cutoff, double sample_rate) {
-  // https://wiki.multimedia.cx/index.php/CRI_ADX_ADPCM#Coefficients
-
-  /* temps to keep the calculation simple */
-  double z, a, b, c;
-
-  z = cos(2.0 * std::numbers::pi * cutoff / sample_rate);
-
-  a = std::numbers::sqrt2 - z;
-  b = std::numbers::sqrt2 - 1.0;
-  c = (a - sqrt((a + b) * (a - b))) / b;
-
-  /* compute the coefficients as fixed point values, with 12 fractional bits */
-  Coef1 = (int16_t)floor(c * 8192);
-  Coef2 = (int16_t)floor(c * c * -4096);
-}
-
-// https://github.com/kode54/vgmstream/blob/master/src/coding/adx_decoder.c
 bool AdxAudioStream::DecodeBuffer() {
-  int16_t* output = DecodedBuffer;
-  uint8_t* input = EncodedBuffer;
-
-  for (int c = 0; c < ChannelCount; c++) {
-    /* the +1 becomes important on quiet ADXs */
-    int scale = SDL_SwapBE16(*(uint16_t*)input) + 1;
-    input += 2;
-
-    for (int i = 0; i < SamplesPerBuffer; i++) {
-      /* this byte contains nibbles for two samples */
-      uint8_t sample_byte = input[i / 2];
-
-      output[i * ChannelCount + c] = (int16_t)(clamp16(
-          (i & 1 ? get_low_nibble_signed(sample_byte)
-                 : get_high_nibble_signed(sample_byte)) *
-              scale +
-          (Coef1 * Hist1[c] >> 12) + (Coef2 * Hist2[c] >> 12)));
-
-      Hist2[c] = Hist1[c];
-      Hist1[c] = output[i * ChannelCount + c];
-    }
-    input += SamplesPerBuffer / 2;
-  }
-
+  AdxDecodeFrames(Decoder, EncodedBuffer, FramesPerBuffer, DecodedBuffer,
+                  LaneScratch.data());
   return true;
 }
 
@@ -200,17 +141,27 @@ AdxAudioStream::~AdxAudioStream() {}
 void AdxAudioStream::InitWithInfo(AdxHeaderInfo* info) {
   ChannelCount = info->ChannelCount;
   SampleRate = info->SampleRate;
-  EncodedBytesPerBuffer = info->FrameSize * ChannelCount;
   StreamDataOffset = info->StreamDataOffset;
-  Hist1[0] = info->Hist1_L;
-  Hist1[1] = info->Hist1_R;
-  Hist2[0] = info->Hist2_L;
-  Hist2[1] = info->Hist2_R;
-  SamplesPerBuffer = (info->FrameSize - 2) * 2;
+
+  Decoder.ChannelCount = ChannelCount;
+  Decoder.FrameSize = info->FrameSize;
+  Decoder.Hist1[0] = info->Hist1_L;
+  Decoder.Hist1[1] = info->Hist1_R;
+  Decoder.Hist2[0] = info->Hist2_L;
+  Decoder.Hist2[1] = info->Hist2_R;
+  AdxSetCoefficients(Decoder, info->Highpass, SampleRate);
+
+  EncodedBytesPerBuffer = info->FrameSize * ChannelCount * FramesPerBuffer;
+  SamplesPerBuffer = Decoder.SamplesPerFrame() * FramesPerBuffer;
+  EncodedData.resize(EncodedBytesPerBuffer);
+  DecodedData.resize(SamplesPerBuffer * ChannelCount);
+  LaneScratch.resize(SamplesPerBuffer * ChannelCount);
+  EncodedBuffer = EncodedData.data();
+  DecodedBuffer = DecodedData.data();
+
   Duration = info->SampleCount;
   LoopStart = info->HasLoop ? info->LoopStart : 0;
   LoopEnd = info->HasLoop ? info->LoopEnd : Duration;
-  SetCoefficients(info->Highpass, SampleRate);
 
   BitDepth = 16;
 
@@ -3,6 +3,7 @@
 #include "audiostream.h"
 #include "../impacto.h"
 #include "buffering.h"
+#include "adxdecoder.h"
 
 namespace Impacto {
 namespace Audio {
@@ -21,20 +22,20 @@ class AdxAudioStream : public AudioStream,
 
  protected:
   bool DecodeBuffer();
-  int16_t DecodedBuffer[127] = {0};
-  uint8_t EncodedBuffer[256] = {0};
 
  private:
   static AudioStream* Create(Io::Stream* stream);
   AdxAudioStream() {}
   void InitWithInfo(AdxHeaderInfo* info);
-  void SetCoefficients(double cutoff, double sampleRate);
 
-  int32_t Coef1;
-  int32_t Coef2;
+  // Frames decoded per buffer, so each base stream read and decode call
+  // covers a few thousand samples instead of a single frame
+  static int constexpr FramesPerBuffer = 64;
 
-  int32_t Hist1[2];
-  int32_t Hist2[2];
+  AdxDecoderState Decoder;
+  std::vector<uint8_t> EncodedData;
+  std::vector<int16_t> DecodedData;
+  std::vector<int16_t> LaneScratch;
 
   static bool _registered;
 };
@@ -0,0 +1,155 @@
+#include "adxdecoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMPACTO_ADX_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define IMPACTO_ADX_NEON 1
+#endif
+
+namespace Impacto {
+namespace Audio {
+
+void AdxSetCoefficients(AdxDecoderState& state, double cutoff,
+                        double sampleRate) {
+  // https://wiki.multimedia.cx/index.php/CRI_ADX_ADPCM#Coefficients
+
+  /* temps to keep the calculation simple */
+  double z, a, b, c;
+
+  z = cos(2.0 * std::numbers::pi * cutoff / sampleRate);
+
+  a = std::numbers::sqrt2 - z;
+  b = std::numbers::sqrt2 - 1.0;
+  c = (a - sqrt((a + b) * (a - b))) / b;
+
+  /* compute the coefficients as fixed point values, with 12 fractional bits */
+  state.Coef1 = (int16_t)floor(c * 8192);
+  state.Coef2 = (int16_t)floor(c * c * -4096);
+}
+
+static inline int16_t PredictSample(int32_t nibble, int32_t scale,
+                                    int32_t coef1, int32_t coef2, int32_t& h1,
+                                    int32_t& h2) {
+  const int32_t sample = std::clamp(
+      nibble * scale + (coef1 * h1 >> 12) + (coef2 * h2 >> 12), -32768, 32767);
+  h2 = h1;
+  h1 = sample;
+  return (int16_t)sample;
+}
+
+// Decodes a single frame of one channel into a contiguous lane
+// https://github.com/kode54/vgmstream/blob/master/src/coding/adx_decoder.c
+static void DecodeFrame(const uint8_t* input, int samples, int32_t coef1,
+                        int32_t coef2, int32_t& hist1, int32_t& hist2,
+                        int16_t* lane) {
+  /* the +1 becomes important on quiet ADXs */
+  const int32_t scale = ((input[0] << 8) | input[1]) + 1;
+  input += 2;
+
+  int32_t h1 = hist1;
+  int32_t h2 = hist2;
+  for (int i = 0; i < samples; i += 2) {
+    /* this byte contains nibbles for two samples */
+    const int8_t sampleByte = (int8_t)input[i / 2];
+    lane[i] = PredictSample(sampleByte >> 4, scale, coef1, coef2, h1, h2);
+    lane[i + 1] = PredictSample((int8_t)(sampleByte << 4) >> 4, scale, coef1,
+                                coef2, h1, h2);
+  }
+
+  hist1 = h1;
+  hist2 = h2;
+}
+
+// Same as DecodeFrame for the left and right frames at once. Every sample
+// depends on the two before it, so running both channels' predictions side by
+// side is what lets them overlap.
+static void DecodeFramePair(const uint8_t* left, const uint8_t* right,
+                            int samples, AdxDecoderState& state,
+                            int16_t* leftLane, int16_t* rightLane) {
+  const int32_t coef1 = state.Coef1;
+  const int32_t coef2 = state.Coef2;
+  const int32_t leftScale = ((left[0] << 8) | left[1]) + 1;
+  const int32_t rightScale = ((right[0] << 8) | right[1]) + 1;
+  left += 2;
+  right += 2;
+
+  int32_t lh1 = state.Hist1[0], lh2 = state.Hist2[0];
+  int32_t rh1 = state.Hist1[1], rh2 = state.Hist2[1];
+  for (int i = 0; i < samples; i += 2) {
+    const int8_t leftByte = (int8_t)left[i / 2];
+    const int8_t rightByte = (int8_t)right[i / 2];
+    leftLane[i] =
+        PredictSample(leftByte >> 4, leftScale, coef1, coef2, lh1, lh2);
+    rightLane[i] =
+        PredictSample(rightByte >> 4, rightScale, coef1, coef2, rh1, rh2);
+    leftLane[i + 1] = PredictSample((int8_t)(leftByte << 4) >> 4, leftScale,
+                                    coef1, coef2, lh1, lh2);
+    rightLane[i + 1] = PredictSample((int8_t)(rightByte << 4) >> 4,
+                                     rightScale, coef1, coef2, rh1, rh2);
+  }
+
+  state.Hist1[0] = lh1;
+  state.Hist2[0] = lh2;
+  state.Hist1[1] = rh1;
+  state.Hist2[1] = rh2;
+}
+
+static void InterleaveStereo(const int16_t* left, const int16_t* right,
+                             int samples, int16_t* output) {
+  int i = 0;
+#if IMPACTO_ADX_SSE2
+  for (; i + 8 <= samples; i += 8) {
+    const __m128i l = _mm_loadu_si128((const __m128i*)(left + i));
+    const __m128i r = _mm_loadu_si128((const __m128i*)(right + i));
+    _mm_storeu_si128((__m128i*)(output + i * 2), _mm_unpacklo_epi16(l, r));
+    _mm_storeu_si128((__m128i*)(output + i * 2 + 8), _mm_unpackhi_epi16(l, r));
+  }
+#elif IMPACTO_ADX_NEON
+  for (; i + 8 <= samples; i += 8) {
+    int16x8x2_t lr;
+    lr.val[0] = vld1q_s16(left + i);
+    lr.val[1] = vld1q_s16(right + i);
+    vst2q_s16(output + i * 2, lr);
+  }
+#endif
+  for (; i < samples; i++) {
+    output[i * 2] = left[i];
+    output[i * 2 + 1] = right[i];
+  }
+}
+
+void AdxDecodeFrames(AdxDecoderState& state, const uint8_t* input,
+                     int frameCount, int16_t* output, int16_t* laneScratch) {
+  const int samplesPerFrame = state.SamplesPerFrame();
+
+  if (state.ChannelCount == 1) {
+    // A single lane already is the interleaved output
+    for (int frame = 0; frame < frameCount; frame++) {
+      DecodeFrame(input, samplesPerFrame, state.Coef1, state.Coef2,
+                  state.Hist1[0], state.Hist2[0],
+                  output + frame * samplesPerFrame);
+      input += state.FrameSize;
+    }
+    return;
+  }
+
+  const int laneSize = frameCount * samplesPerFrame;
+  for (int frame = 0; frame < frameCount; frame++) {
+    DecodeFramePair(input, input + state.FrameSize, samplesPerFrame, state,
+                    laneScratch + frame * samplesPerFrame,
+                    laneScratch + laneSize + frame * samplesPerFrame);
+    input += state.FrameSize * 2;
+  }
+
+  InterleaveStereo(laneScratch, laneScratch + laneSize, laneSize, output);
+}
+
+}  // namespace Audio
+}  // namespace Impacto
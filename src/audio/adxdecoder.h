@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+// ADX frame decoding, kept free of any stream handling so it can be used by
+// tools outside of the engine as well
+
+namespace Impacto {
+namespace Audio {
+
+struct AdxDecoderState {
+  int ChannelCount;
+  // Bytes per frame and channel, including the 2 byte scale
+  int FrameSize;
+
+  // Prediction coefficients with 12 fractional bits
+  int32_t Coef1;
+  int32_t Coef2;
+
+  int32_t Hist1[2];
+  int32_t Hist2[2];
+
+  int SamplesPerFrame() const { return (FrameSize - 2) * 2; }
+};
+
+void AdxSetCoefficients(AdxDecoderState& state, double cutoff,
+                        double sampleRate);
+
+// Decodes frameCount consecutive frames of every channel (as they're laid out
+// in the stream, channels alternating per frame) into interleaved samples.
+// Each channel is first decoded into its own contiguous lane, laneScratch
+// needs room for frameCount * SamplesPerFrame() samples of every channel.
+void AdxDecodeFrames(AdxDecoderState& state, const uint8_t* input,
+                     int frameCount, int16_t* output, int16_t* laneScratch);
+
+}  // namespace Audio
+}  // namespace Impacto
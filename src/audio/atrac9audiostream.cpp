@@ -1,6 +1,8 @@
 #include "atrac9audiostream.h"
 #include "../log.h"
 
+#include <utility>
+
 using namespace Impacto::Io;
 
 namespace Impacto {
@@ -140,6 +142,7 @@ AudioStream* Atrac9AudioStream::Create(Stream* stream) {
   Atrac9CodecInfo codecinfo;
 
   void* At9 = Atrac9GetHandle();
+  void* LoopAt9 = 0;
   if (!At9) {
     ImpLog(LogLevel::Error, LogChannel::Audio, "Atrac9GetHandle failed\n");
     goto fail;
@@ -150,7 +153,19 @@ AudioStream* Atrac9AudioStream::Create(Stream* stream) {
     goto fail;
   }
 
+  // Only looping files get a second decoder, to prime the loop start on
+  if (container.HasLoop) {
+    LoopAt9 = Atrac9GetHandle();
+    if (!LoopAt9) {
+      ImpLog(LogLevel::Error, LogChannel::Audio, "Atrac9GetHandle failed\n");
+      goto fail;
+    }
+  }
+
   ret = Atrac9InitDecoder(At9, container.ConfigData);
+  if (ret == 0 && LoopAt9) {
+    ret = Atrac9InitDecoder(LoopAt9, container.ConfigData);
+  }
   if (ret != 0) {
     ImpLog(LogLevel::Error, LogChannel::Audio,
            "Atrac9InitDecoder failed with {:d}\n", ret);
@@ -167,6 +182,7 @@ AudioStream* Atrac9AudioStream::Create(Stream* stream) {
 
   result = new Atrac9AudioStream;
   result->At9 = At9;
+  result->LoopAt9 = LoopAt9;
   result->BaseStream = stream;
   result->InitWithInfo(&container, &codecinfo);
 
@@ -174,8 +190,10 @@ AudioStream* Atrac9AudioStream::Create(Stream* stream) {
 
 fail:
   if (At9) Atrac9ReleaseHandle(At9);
+  if (LoopAt9) Atrac9ReleaseHandle(LoopAt9);
   if (result) {
     result->At9 = 0;
+    result->LoopAt9 = 0;
     result->BaseStream = 0;
     delete result;
   }
@@ -195,6 +213,11 @@ void Atrac9AudioStream::InitWithInfo(At9ContainerInfo* container,
 
   BitDepth = 16;
 
+  // libatrac9 has no way to reset its state, but the frames' IMDCT overlap
+  // and scale factor prediction only reach into the previous superframe
+  SeekPrerollBuffers = 1;
+  PrimeLoops = LoopAt9 != 0;
+
   SamplesPerFrame = codecinfo->frameSamples;
   FramesPerSuperframe = codecinfo->framesInSuperframe;
   SamplesPerBuffer = SamplesPerFrame * FramesPerSuperframe;
@@ -216,6 +239,7 @@ void Atrac9AudioStream::InitWithInfo(At9ContainerInfo* container,
 
 Atrac9AudioStream::~Atrac9AudioStream() {
   if (At9) Atrac9ReleaseHandle(At9);
+  if (LoopAt9) Atrac9ReleaseHandle(LoopAt9);
   if (DecodedBuffer) free(DecodedBuffer);
   if (EncodedBuffer) free(EncodedBuffer);
 }
@@ -247,6 +271,8 @@ bool Atrac9AudioStream::DecodeBuffer() {
 
 void Atrac9AudioStream::Seek(int samples) { return SeekBuffered(samples); }
 
+void Atrac9AudioStream::SwapDecoders() { std::swap(At9, LoopAt9); }
+
 bool Atrac9AudioStream::_registered =
     AudioStream::AddAudioStreamCreator(&Atrac9AudioStream::Create);
 
@@ -22,6 +22,7 @@ class Atrac9AudioStream : public AudioStream,
 
  protected:
   bool DecodeBuffer();
+  void SwapDecoders();
 
  private:
   static AudioStream* Create(Io::Stream* stream);
@@ -30,6 +31,8 @@ class Atrac9AudioStream : public AudioStream,
   void InitWithInfo(At9ContainerInfo* container, Atrac9CodecInfo* codecinfo);
 
   void* At9 = 0;
+  // Primed with the loop start while the end of the loop plays
+  void* LoopAt9 = 0;
   int SamplesPerFrame;
   int FramesPerSuperframe;
   int EncoderDelay;
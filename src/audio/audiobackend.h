@@ -9,6 +9,8 @@ class AudioBackend {
  public:
   virtual bool Init() { return true; };
 
+  virtual void Update(float dt) {};
+
   virtual void Shutdown() {};
 };
 
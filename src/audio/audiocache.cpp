@@ -0,0 +1,226 @@
+#include "audiocache.h"
+
+#include "memorypcmaudiostream.h"
+#include "../io/vfs.h"
+#include "../log.h"
+#include "../workqueue.h"
+
+#include <list>
+#include <map>
+
+namespace Impacto {
+namespace Audio {
+namespace AudioCache {
+
+struct CacheEntry {
+  std::string Key;
+  std::shared_ptr<const DecodedPcm> Pcm;
+};
+
+static size_t BudgetBytes = 0;
+static float MaxClipDuration = 0.0f;
+
+// Most recently played first
+static std::list<CacheEntry> Entries;
+static ankerl::unordered_dense::map<std::string,
+                                    std::list<CacheEntry>::iterator>
+    EntryLookup;
+static size_t CachedBytes = 0;
+// Keys being decoded in the background
+static ankerl::unordered_dense::set<std::string> Pending;
+// Bumped on shutdown so fills still in flight get thrown away
+static uint32_t Generation = 0;
+static uint64_t Hits = 0;
+static uint64_t Misses = 0;
+
+void Init(size_t budgetBytes, float maxClipDuration) {
+  BudgetBytes = budgetBytes;
+  MaxClipDuration = maxClipDuration;
+}
+
+void Shutdown() {
+  Entries.clear();
+  EntryLookup.clear();
+  Pending.clear();
+  CachedBytes = 0;
+  Generation++;
+}
+
+static void Evict() {
+  while (CachedBytes > BudgetBytes && !Entries.empty()) {
+    CacheEntry& entry = Entries.back();
+    CachedBytes -= entry.Pcm->Samples.size();
+    EntryLookup.erase(entry.Key);
+    Entries.pop_back();
+  }
+}
+
+static bool ShouldCache(const AudioStream& stream) {
+  if (stream.Duration <= 0) return false;
+
+  const size_t size = (size_t)stream.Duration * stream.BytesPerSample();
+  return size <= BudgetBytes &&
+         (float)stream.Duration / stream.SampleRate <= MaxClipDuration;
+}
+
+static void Insert(std::string key, std::shared_ptr<const DecodedPcm> pcm) {
+  Entries.push_front(CacheEntry{std::move(key), std::move(pcm)});
+  EntryLookup[Entries.front().Key] = Entries.begin();
+  CachedBytes += Entries.front().Pcm->Samples.size();
+  Evict();
+}
+
+static Io::Stream* OpenFile(std::string const& mountpoint, uint32_t fileId) {
+  Io::Stream* stream;
+  IoError err = Io::VfsOpen(mountpoint, fileId, &stream);
+  if (err != IoError_OK) {
+    ImpLog(LogLevel::Error, LogChannel::Audio,
+           "Could not open audio file with ID {:d} from mountpoint {:s}!\n",
+           fileId, mountpoint);
+    return nullptr;
+  }
+  return stream;
+}
+
+static Io::Stream* OpenFile(std::string const& mountpoint,
+                            std::string const& fileName) {
+  Io::Stream* stream;
+  IoError err = Io::VfsOpen(mountpoint, fileName, &stream);
+  if (err != IoError_OK) {
+    ImpLog(LogLevel::Error, LogChannel::Audio,
+           "Could not open audio file {:s} from mountpoint {:s}!\n", fileName,
+           mountpoint);
+    return nullptr;
+  }
+  return stream;
+}
+
+static std::unique_ptr<AudioStream> CreateStream(Io::Stream* stream) {
+  if (!stream) return nullptr;
+
+  std::unique_ptr<AudioStream> audioStream(AudioStream::Create(stream));
+  if (!audioStream) delete stream;
+  return audioStream;
+}
+
+struct FillJob {
+  std::string Key;
+  std::string Mountpoint;
+  std::string FileName;
+  uint32_t FileId;
+  uint32_t Generation;
+  std::shared_ptr<const DecodedPcm> Result;
+};
+
+static void FillWorker(void* ptr) {
+  FillJob* job = (FillJob*)ptr;
+  std::unique_ptr<AudioStream> stream =
+      CreateStream(job->FileName.empty()
+                       ? OpenFile(job->Mountpoint, job->FileId)
+                       : OpenFile(job->Mountpoint, job->FileName));
+  if (stream) job->Result = DecodedPcm::Decode(*stream);
+}
+
+static void OnFilled(void* ptr) {
+  FillJob* job = (FillJob*)ptr;
+  if (job->Generation == Generation) {
+    Pending.erase(job->Key);
+    if (job->Result && !EntryLookup.contains(job->Key)) {
+      Insert(std::move(job->Key), std::move(job->Result));
+    }
+  }
+  delete job;
+}
+
+// Plays a miss from its regular decoding stream, decoding a copy for the
+// cache in the background so the next play of it is a hit
+static std::unique_ptr<AudioStream> OpenUncached(std::string key,
+                                                 std::string const& mountpoint,
+                                                 std::string fileName,
+                                                 uint32_t fileId,
+                                                 Io::Stream* stream) {
+  std::unique_ptr<AudioStream> audioStream = CreateStream(stream);
+  if (!audioStream || !ShouldCache(*audioStream)) return audioStream;
+
+  if (!Pending.contains(key)) {
+    Pending.insert(key);
+    WorkQueue::Push(new FillJob{std::move(key), mountpoint,
+                                std::move(fileName), fileId, Generation,
+                                nullptr},
+                    &FillWorker, &OnFilled);
+  }
+  return audioStream;
+}
+
+static std::unique_ptr<AudioStream> Lookup(std::string const& key) {
+  auto it = EntryLookup.find(key);
+  if (it == EntryLookup.end()) {
+    Misses++;
+    return nullptr;
+  }
+
+  Hits++;
+  Entries.splice(Entries.begin(), Entries, it->second);
+  return std::make_unique<MemoryPcmAudioStream>(it->second->Pcm);
+}
+
+std::unique_ptr<AudioStream> Open(std::string const& mountpoint,
+                                  uint32_t fileId) {
+  std::string key = fmt::format("{}/{:d}", mountpoint, fileId);
+  if (auto cached = Lookup(key)) return cached;
+
+  Io::Stream* stream = OpenFile(mountpoint, fileId);
+  if (!stream) return nullptr;
+  return OpenUncached(std::move(key), mountpoint, "", fileId, stream);
+}
+
+std::unique_ptr<AudioStream> Open(std::string const& mountpoint,
+                                  std::string const& fileName) {
+  std::string key = fmt::format("{}/{:s}", mountpoint, fileName);
+  if (auto cached = Lookup(key)) return cached;
+
+  Io::Stream* stream = OpenFile(mountpoint, fileName);
+  if (!stream) return nullptr;
+  return OpenUncached(std::move(key), mountpoint, fileName, 0, stream);
+}
+
+void Preload(std::string const& mountpoint) {
+  if (BudgetBytes == 0) return;
+
+  std::map<uint32_t, std::string> listing;
+  if (Io::VfsListFiles(mountpoint, listing) != IoError_OK) return;
+
+  // Done up front while loading rather than in the background, so these are
+  // hits from the very first play
+  for (const auto& [id, name] : listing) {
+    std::string key = fmt::format("{}/{:d}", mountpoint, id);
+    if (EntryLookup.contains(key)) continue;
+
+    std::unique_ptr<AudioStream> stream =
+        CreateStream(OpenFile(mountpoint, id));
+    if (!stream || !ShouldCache(*stream)) continue;
+    if (auto pcm = DecodedPcm::Decode(*stream)) {
+      Insert(std::move(key), std::move(pcm));
+    }
+    // Don't push out what we just preloaded
+    if (CachedBytes >= BudgetBytes) break;
+  }
+  Hits = 0;
+  Misses = 0;
+
+  ImpLog(LogLevel::Info, LogChannel::Audio,
+         "Preloaded {:d} clips from {:s}, {:d} KiB decoded audio cached\n",
+         Entries.size(), mountpoint, CachedBytes / 1024);
+}
+
+CacheStats GetStats() {
+  return CacheStats{.Entries = Entries.size(),
+                    .Bytes = CachedBytes,
+                    .BudgetBytes = BudgetBytes,
+                    .Hits = Hits,
+                    .Misses = Misses};
+}
+
+}  // namespace AudioCache
+}  // namespace Audio
+}  // namespace Impacto
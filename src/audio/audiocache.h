@@ -0,0 +1,42 @@
+#pragma once
+
+#include "audiostream.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Impacto {
+namespace Audio {
+namespace AudioCache {
+
+// Keeps short clips that get replayed a lot (UI and script sound effects)
+// fully decoded, evicting the least recently played ones once the byte budget
+// is exceeded
+void Init(size_t budgetBytes, float maxClipDuration);
+void Shutdown();
+
+// Returns a stream served from the cache. Misses get their regular decoding
+// stream, and are decoded into the cache in the background if they're short
+// enough.
+std::unique_ptr<AudioStream> Open(std::string const& mountpoint,
+                                  uint32_t fileId);
+std::unique_ptr<AudioStream> Open(std::string const& mountpoint,
+                                  std::string const& fileName);
+
+// Decodes every clip of a mountpoint that fits, for sets of sounds that are
+// bound to be played, like system sound effects
+void Preload(std::string const& mountpoint);
+
+struct CacheStats {
+  size_t Entries = 0;
+  size_t Bytes = 0;
+  size_t BudgetBytes = 0;
+  uint64_t Hits = 0;
+  uint64_t Misses = 0;
+};
+CacheStats GetStats();
+
+}  // namespace AudioCache
+}  // namespace Audio
+}  // namespace Impacto
@@ -1,9 +1,11 @@
 #include "audiochannel.h"
 #include "audiostream.h"
+#include "audiocache.h"
 
 #ifndef IMPACTO_DISABLE_OPENAL
 #include "openal/openalaudiochannel.h"
 #endif
+#include "mixer/mixeraudiochannel.h"
 
 #include "../io/stream.h"
 #include "../io/vfs.h"
@@ -22,6 +24,10 @@ std::unique_ptr<AudioChannel> AudioChannel::Create(
                                                           channelGroup);
     } break;
 #endif
+    case AudioBackendType::Mixer: {
+      return std::make_unique<Mixer::MixerAudioChannel>(channelId,
+                                                        channelGroup);
+    } break;
     case AudioBackendType::None:
     default:
       return std::make_unique<EmptyAudioChannel>(channelId, channelGroup);
@@ -31,6 +37,13 @@ std::unique_ptr<AudioChannel> AudioChannel::Create(
 void AudioChannel::Play(std::string const& mountpoint,
                         std::string const& fileName, bool loop,
                         float fadeInDuration) {
+  if (Group == ACG_SE) {
+    // Sound effects are short and replayed a lot, so they are kept decoded
+    auto stream = AudioCache::Open(mountpoint, fileName);
+    if (stream) Play(std::move(stream), loop, fadeInDuration);
+    return;
+  }
+
   Io::Stream* stream;
   IoError err = Io::VfsOpen(mountpoint, fileName, &stream);
   if (err == IoError_OK) {
@@ -45,6 +58,12 @@ void AudioChannel::Play(std::string const& mountpoint,
 
 void AudioChannel::Play(std::string const& mountpoint, uint32_t fileId,
                         bool loop, float fadeInDuration) {
+  if (Group == ACG_SE) {
+    auto stream = AudioCache::Open(mountpoint, fileId);
+    if (stream) Play(std::move(stream), loop, fadeInDuration);
+    return;
+  }
+
   Io::Stream* stream;
   IoError err = Io::VfsOpen(mountpoint, fileId, &stream);
   if (err == IoError_OK) {
@@ -55,7 +55,8 @@ class AudioChannel {
   float Volume = 1.0f;
   bool Looping = false;
 
-  std::unique_ptr<AudioStream> Stream;
+  // Shared with the streaming thread decoding it
+  std::shared_ptr<AudioStream> Stream;
 };
 
 class EmptyAudioChannel : public AudioChannel {
@@ -21,7 +21,7 @@ class AudioStream {
   virtual int Read(void* buffer, int samples) = 0;
   virtual void Seek(int samples) = 0;
 
-  const Io::Stream* GetBaseStream() const { return BaseStream; }
+  virtual const Io::Stream* GetBaseStream() const { return BaseStream; }
 
   int BytesPerSample() const { return (BitDepth / 8) * ChannelCount; }
 
@@ -31,6 +31,9 @@ class AudioStream {
 
   int LoopStart = 0;
   int LoopEnd = 0;
+  // Whether the stream is being played back wrapping around at LoopEnd, set
+  // by the reader before every Read
+  bool Looping = false;
   // negative indicates no fixed length
   int Duration = -1;
   int ReadPosition = 0;
@@ -0,0 +1,200 @@
+#include "audiostreamer.h"
+
+#include "../log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#if IMPACTO_HAVE_THREADS
+#include <condition_variable>
+#include <thread>
+#endif
+
+namespace Impacto {
+namespace Audio {
+
+StreamDecoder::StreamDecoder(AudioChannelId channel,
+                             std::shared_ptr<AudioStream> stream, bool looping)
+    : Channel(channel),
+      Stream(std::move(stream)),
+      BytesPerSample(Stream->BytesPerSample()),
+      Ring(RingSizeInBytes / BytesPerSample, BytesPerSample),
+      Looping(looping),
+      Position(Stream->ReadPosition) {}
+
+size_t StreamDecoder::Read(uint8_t* dest, size_t bytes) {
+  const size_t read = Ring.Read(dest, bytes);
+  if (read == 0) return 0;
+
+  // Mirror the loop points the producer seeked at, which it never reads past
+  int position = ConsumedPosition() + (int)(read / BytesPerSample);
+  const int loopLength = Stream->LoopEnd - Stream->LoopStart;
+  if (Looping.load(std::memory_order_relaxed) && loopLength > 0) {
+    while (position >= Stream->LoopEnd) position -= loopLength;
+  }
+  Position.store(position, std::memory_order_relaxed);
+
+  AudioStreamer::Wake();
+  return read;
+}
+
+bool StreamDecoder::Decode() {
+  if (Finished.load(std::memory_order_relaxed)) return false;
+
+  bool decoded = false;
+  AudioChannelStats& stats = ChannelStats[Channel];
+
+  while (!IsCancelled()) {
+    if (Stream->ReadPosition >= Stream->Duration) {
+      Finished.store(true, std::memory_order_release);
+      break;
+    }
+
+    std::span<uint8_t> region = Ring.WritableRegion();
+    int maxSamples =
+        (int)std::min(region.size() / BytesPerSample, MaxSamplesPerRead);
+    if (maxSamples == 0) break;
+
+    const bool looping = Looping.load(std::memory_order_relaxed);
+    Stream->Looping = looping;
+
+    int end = looping ? Stream->LoopEnd : Stream->Duration;
+    int samplesToRead = std::min(maxSamples, end - Stream->ReadPosition);
+
+    const auto startTime = std::chrono::steady_clock::now();
+    int samplesRead = Stream->Read(region.data(), samplesToRead);
+    const uint32_t decodeTimeUs =
+        (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime)
+            .count();
+
+    stats.DecodedSamples += samplesRead;
+    stats.DecodeTimeUs += decodeTimeUs;
+    if (decodeTimeUs > stats.PeakDecodeTimeUs) {
+      stats.PeakDecodeTimeUs = decodeTimeUs;
+    }
+
+    Ring.CommitWrite(samplesRead * BytesPerSample);
+    decoded |= samplesRead > 0;
+
+    if (looping && Stream->ReadPosition >= Stream->LoopEnd) {
+      Stream->Seek(Stream->LoopStart);
+    } else if (samplesRead == 0) {
+      ImpLog(LogLevel::Error, LogChannel::Audio,
+             "Failed to decode audio on channel {:d}\n", Channel);
+      Finished.store(true, std::memory_order_release);
+      break;
+    }
+  }
+
+  return decoded;
+}
+
+namespace AudioStreamer {
+
+static std::mutex DecodersMutex;
+static std::vector<std::shared_ptr<StreamDecoder>> Decoders;
+
+// Decodes for every active stream, dropping cancelled ones
+static void DecodeAll(std::vector<std::shared_ptr<StreamDecoder>>& active) {
+  {
+    std::lock_guard lock(DecodersMutex);
+    std::erase_if(Decoders, [](const auto& decoder) {
+      return decoder->IsCancelled();
+    });
+    active.assign(Decoders.begin(), Decoders.end());
+  }
+
+  for (const auto& decoder : active) decoder->Decode();
+
+  // Release our references outside of the lock, so the last one of a stopped
+  // channel destroys its stream here rather than while holding it
+  active.clear();
+}
+
+#if IMPACTO_HAVE_THREADS
+
+static std::thread StreamerThread;
+static std::condition_variable WakeCondition;
+static std::atomic<bool> WakeRequested = false;
+static bool StopStreamer = false;
+
+static void StreamerThreadProc() {
+  std::vector<std::shared_ptr<StreamDecoder>> active;
+
+  while (true) {
+    {
+      std::unique_lock lock(DecodersMutex);
+      // Refills are requested as playback consumes samples, the timeout only
+      // catches streams that are filling up for the first time
+      WakeCondition.wait_for(lock, std::chrono::milliseconds(5),
+                             [] { return WakeRequested || StopStreamer; });
+      if (StopStreamer) return;
+      WakeRequested = false;
+    }
+
+    DecodeAll(active);
+  }
+}
+
+void Init() {
+  StopStreamer = false;
+  StreamerThread = std::thread(StreamerThreadProc);
+}
+
+void Shutdown() {
+  {
+    std::lock_guard lock(DecodersMutex);
+    StopStreamer = true;
+  }
+  WakeCondition.notify_one();
+  if (StreamerThread.joinable()) StreamerThread.join();
+
+  Decoders.clear();
+}
+
+void Start(std::shared_ptr<StreamDecoder> decoder) {
+  {
+    std::lock_guard lock(DecodersMutex);
+    Decoders.push_back(std::move(decoder));
+    WakeRequested = true;
+  }
+  WakeCondition.notify_one();
+}
+
+void Wake() {
+  // Without taking the lock a wakeup can get lost between the streaming
+  // thread checking the flag and starting to wait, which its timeout covers
+  WakeRequested = true;
+  WakeCondition.notify_one();
+}
+
+void Update() {}
+
+#else
+
+// Without threads (i.e. on web) decoding happens at the start of each audio
+// update instead, which still keeps the channels reading from a filled ring
+
+void Init() {}
+void Shutdown() { Decoders.clear(); }
+
+void Start(std::shared_ptr<StreamDecoder> decoder) {
+  Decoders.push_back(std::move(decoder));
+}
+
+void Wake() {}
+
+void Update() {
+  static std::vector<std::shared_ptr<StreamDecoder>> active;
+  DecodeAll(active);
+}
+
+#endif
+
+}  // namespace AudioStreamer
+
+}  // namespace Audio
+}  // namespace Impacto
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "audiocommon.h"
+#include "audiostream.h"
+#include "pcmring.h"
+
+#include <atomic>
+#include <memory>
+
+namespace Impacto {
+namespace Audio {
+
+struct AudioChannelStats {
+  // Times playback ran dry before the decoder caught up
+  std::atomic<uint32_t> Underruns = 0;
+  std::atomic<uint64_t> DecodedSamples = 0;
+  std::atomic<uint64_t> DecodeTimeUs = 0;
+  // Longest single AudioStream::Read call
+  std::atomic<uint32_t> PeakDecodeTimeUs = 0;
+
+  void Reset() {
+    Underruns = 0;
+    DecodedSamples = 0;
+    DecodeTimeUs = 0;
+    PeakDecodeTimeUs = 0;
+  }
+};
+
+inline AudioChannelStats ChannelStats[AC_Count];
+
+// Decodes an audio stream ahead of playback into a ring of PCM. All
+// AudioStream::Read and Seek calls happen in Decode(), which runs on the audio
+// streaming thread; the channel only ever consumes decoded samples.
+class StreamDecoder {
+ public:
+  StreamDecoder(AudioChannelId channel, std::shared_ptr<AudioStream> stream,
+                bool looping);
+
+  // Consumer side
+  size_t Read(uint8_t* dest, size_t bytes);
+  // Stream position of the next sample Read() returns, may be queried from
+  // another thread than the consumer's
+  int ConsumedPosition() const {
+    return Position.load(std::memory_order_relaxed);
+  }
+  // Everything up to the end of the stream has been consumed
+  bool Drained() const {
+    return Finished.load(std::memory_order_acquire) &&
+           Ring.BytesAvailable() == 0;
+  }
+
+  void SetLooping(bool looping) {
+    Looping.store(looping, std::memory_order_relaxed);
+  }
+  void Cancel() { Cancelled.store(true, std::memory_order_relaxed); }
+  bool IsCancelled() const {
+    return Cancelled.load(std::memory_order_relaxed);
+  }
+
+  // Producer side, fills the ring as far as it can. Returns whether anything
+  // was decoded.
+  bool Decode();
+
+ private:
+  static size_t constexpr RingSizeInBytes = 256 * 1024;
+  // Upper bound for a single AudioStream::Read, so decode times stay
+  // comparable and a cancelled stream is let go of quickly
+  static size_t constexpr MaxSamplesPerRead = 8 * 1024;
+
+  AudioChannelId Channel;
+  std::shared_ptr<AudioStream> Stream;
+  const int BytesPerSample;
+  PcmRing Ring;
+
+  std::atomic<bool> Looping;
+  std::atomic<bool> Finished = false;
+  std::atomic<bool> Cancelled = false;
+
+  // Only written by the consumer
+  std::atomic<int> Position;
+};
+
+namespace AudioStreamer {
+
+void Init();
+void Shutdown();
+
+// Hands a decoder to the streaming thread, it's let go of once cancelled
+void Start(std::shared_ptr<StreamDecoder> decoder);
+// Lets the streaming thread know there is space to refill, doesn't block so
+// it's safe to call from an audio callback
+void Wake();
+// Without threads, decodes on the calling thread instead
+void Update();
+
+}  // namespace AudioStreamer
+
+}  // namespace Audio
+}  // namespace Impacto
@@ -3,10 +3,14 @@
 #include "../profile/game.h"
 #include "../profile/scriptvars.h"
 #include "../profile/configsystem.h"
+#include "audiostreamer.h"
+#include "audiocache.h"
+#include "voiceprefetch.h"
 
 #ifndef IMPACTO_DISABLE_OPENAL
 #include "openal/audiobackend.h"
 #endif
+#include "mixer/audiobackend.h"
 
 #include <utility>
 
@@ -21,6 +25,9 @@ void AudioShutdown() {
   for (int i = 0; i < AC_Count; i++) {
     Channels[i] = nullptr;
   }
+  AudioStreamer::Shutdown();
+  AudioCache::Shutdown();
+  VoicePrefetch::Shutdown();
   IsInit = false;
   Backend->Shutdown();
 }
@@ -35,6 +42,9 @@ void AudioInit() {
       Backend = new OpenAL::AudioBackend();
     } break;
 #endif
+    case AudioBackendType::Mixer: {
+      Backend = new Mixer::AudioBackend();
+    } break;
     case AudioBackendType::None:
     default: {
       ImpLog(LogLevel::Warning, LogChannel::Audio,
@@ -45,6 +55,7 @@ void AudioInit() {
   }
 
   if (!Backend->Init()) return;
+  AudioStreamer::Init();
   for (int i = AC_SE0; i <= AC_SE2; i++)
     Channels[i] = AudioChannel::Create((AudioChannelId)i, ACG_SE);
   for (int i = AC_VOICE0; i <= AC_REV; i++)
@@ -53,6 +64,15 @@ void AudioInit() {
     Channels[i] = AudioChannel::Create((AudioChannelId)i, ACG_BGM);
   Channels[AC_SSE] = AudioChannel::Create(AC_SSE, ACG_SE);
 
+  // Nothing would play the decoded audio without a backend
+  if (Profile::ActiveAudioBackend != +AudioBackendType::None) {
+    AudioCache::Init(Profile::AudioCacheBudget,
+                     Profile::AudioCacheMaxClipDuration);
+    AudioCache::Preload("sysse");
+    VoicePrefetch::Init(Profile::VoicePrefetchDepth,
+                        Profile::VoicePrefetchDuration);
+  }
+
   IsInit = true;
 }
 
@@ -68,6 +88,8 @@ void AudioUpdate(float dt) {
     Channels[i]->SetVolume(voiceVolumeModifier);
   }
 
+  AudioStreamer::Update();
+  Backend->Update(dt);
   for (int i = 0; i < AC_Count; i++) {
     Channels[i]->Update(dt);
   }
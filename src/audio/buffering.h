@@ -1,15 +1,25 @@
 #pragma once
 
 #include <algorithm>
+#include <vector>
 #include "../impacto.h"
 
 namespace Impacto {
 namespace Audio {
 
+// Reading and seeking for codecs made of fixed-size encoded buffers, so any
+// sample can be reached by jumping straight to the buffer containing it
 template <typename T, typename SampleType>
 class Buffering {
  protected:
   bool DecodeBuffer();
+  // Codecs carrying decoder state from one buffer to the next shadow these.
+  // ResetDecoder clears that state before decoding from a new position,
+  // SwapDecoders exchanges the active decoder with a second one, which lets
+  // the loop start be decoded ahead of time when PrimeLoops is set.
+  void ResetDecoder() {}
+  void SwapDecoders() {}
+
   SampleType* DecodedBuffer = 0;
   uint8_t* EncodedBuffer = 0;
 
@@ -19,6 +29,11 @@ class Buffering {
   int EncodedBytesPerBuffer = 0;
   int StreamDataOffset;
 
+  // Buffers decoded and thrown away ahead of a seek target, to rebuild the
+  // state the target's decoding depends on (e.g. MDCT overlap)
+  int SeekPrerollBuffers = 0;
+  bool PrimeLoops = false;
+
   int ReadBuffered(SampleType* out, int samples) {
     T* stream = static_cast<T*>(this);
     int read = 0;
@@ -41,19 +56,8 @@ class Buffering {
         DecodedSamplesConsumed += samplesWrittenNow;
       } else {
         // decode more data
-        int samplesLeft = stream->Duration - stream->ReadPosition;
-        if (samplesLeft == 0)
-          //
-          return read;
-
-        DecodedSamplesAvailable = SamplesPerBuffer;
-        DecodedSamplesConsumed = 0;
-        stream->BaseStream->Read(stream->EncodedBuffer, EncodedBytesPerBuffer);
-        bool decodeSuccess = stream->DecodeBuffer();
-
-        DecodedSamplesAvailable =
-            std::min(DecodedSamplesAvailable, samplesLeft);
-        if (!decodeSuccess) return read;
+        if (stream->ReadPosition >= stream->Duration) return read;
+        if (!DecodeNextBuffer()) return read;
       }
     }
     return read;
@@ -64,24 +68,105 @@ class Buffering {
     int buffer = samples / SamplesPerBuffer;
     int offset = samples % SamplesPerBuffer;
     int currentBuffer = stream->ReadPosition / SamplesPerBuffer;
-    if (currentBuffer != buffer) {
-      // seek base stream
+
+    if (LoopStartPrimed && buffer == PrimedBuffer) {
+      // Looping back, the other decoder already continues from here
+      stream->SwapDecoders();
+      LoopStartPrimed = false;
+      memcpy(stream->DecodedBuffer, LoopStartDecoded.data(),
+             LoopStartDecoded.size() * sizeof(SampleType));
+      stream->BaseStream->Seek(
+          StreamDataOffset + (buffer + 1) * EncodedBytesPerBuffer,
+          RW_SEEK_SET);
+      SetDecodedBuffer(buffer);
+    } else if (currentBuffer != buffer) {
+      // Jump to the target buffer, decoding only what its state depends on
+      int firstBuffer = std::max(0, buffer - SeekPrerollBuffers);
       stream->BaseStream->Seek(
-          StreamDataOffset + buffer * EncodedBytesPerBuffer, RW_SEEK_SET);
+          StreamDataOffset + firstBuffer * EncodedBytesPerBuffer,
+          RW_SEEK_SET);
+      stream->ResetDecoder();
+      for (int i = firstBuffer; i < buffer; i++) {
+        stream->BaseStream->Read(stream->EncodedBuffer, EncodedBytesPerBuffer);
+        stream->DecodeBuffer();
+      }
       stream->ReadPosition = buffer * SamplesPerBuffer;
       DecodedSamplesAvailable = 0;
       DecodedSamplesConsumed = 0;
     }
-    // ensure available
-    if (!DecodedSamplesAvailable) {
-      ReadBuffered(NULL, 1);
+    // ensure available, unless we're past the end and it's still decoded
+    if (!DecodedSamplesAvailable &&
+        stream->ReadPosition == buffer * SamplesPerBuffer) {
+      DecodeNextBuffer();
     }
     // skip
     stream->ReadPosition = samples;
-    DecodedSamplesAvailable = SamplesPerBuffer - offset;
+    SetDecodedBuffer(buffer);
+    DecodedSamplesAvailable = std::max(0, DecodedSamplesAvailable - offset);
     DecodedSamplesConsumed = offset;
   }
+
+ private:
+  // Set while LoopStartDecoded holds buffer PrimedBuffer and the inactive
+  // decoder's state continues right after it
+  bool LoopStartPrimed = false;
+  int PrimedBuffer = -1;
+  std::vector<SampleType> LoopStartDecoded;
+
+  void SetDecodedBuffer(int buffer) {
+    T* stream = static_cast<T*>(this);
+    DecodedSamplesAvailable = std::min(
+        SamplesPerBuffer, stream->Duration - buffer * SamplesPerBuffer);
+    DecodedSamplesConsumed = 0;
+  }
+
+  // Decodes the buffer the base stream is at, which starts at ReadPosition
+  bool DecodeNextBuffer() {
+    T* stream = static_cast<T*>(this);
+    const int buffer = stream->ReadPosition / SamplesPerBuffer;
+
+    stream->BaseStream->Read(stream->EncodedBuffer, EncodedBytesPerBuffer);
+    bool decodeSuccess = stream->DecodeBuffer();
+    SetDecodedBuffer(buffer);
+    if (!decodeSuccess) {
+      DecodedSamplesAvailable = 0;
+      return false;
+    }
+
+    // Once the loop end is in sight, get the loop start ready on the other
+    // decoder so wrapping around costs a copy instead of a seek and decode
+    if (PrimeLoops && stream->Looping && !LoopStartPrimed &&
+        stream->LoopEnd > 0 &&
+        buffer == (stream->LoopEnd - 1) / SamplesPerBuffer) {
+      PrimeLoopStart(stream->LoopStart / SamplesPerBuffer);
+    }
+    return true;
+  }
+
+  void PrimeLoopStart(int buffer) {
+    T* stream = static_cast<T*>(this);
+    const int64_t resumeOffset = stream->BaseStream->Position;
+    SampleType* decodedBuffer = stream->DecodedBuffer;
+    LoopStartDecoded.resize(SamplesPerBuffer * stream->ChannelCount);
+    stream->DecodedBuffer = LoopStartDecoded.data();
+    stream->SwapDecoders();
+
+    int firstBuffer = std::max(0, buffer - SeekPrerollBuffers);
+    stream->BaseStream->Seek(
+        StreamDataOffset + firstBuffer * EncodedBytesPerBuffer, RW_SEEK_SET);
+    stream->ResetDecoder();
+    LoopStartPrimed = true;
+    for (int i = firstBuffer; i <= buffer && LoopStartPrimed; i++) {
+      stream->BaseStream->Read(stream->EncodedBuffer, EncodedBytesPerBuffer);
+      LoopStartPrimed = stream->DecodeBuffer();
+    }
+    PrimedBuffer = buffer;
+
+    stream->SwapDecoders();
+    stream->DecodedBuffer = decodedBuffer;
+    stream->BaseStream->Seek(resumeOffset, RW_SEEK_SET);
+  }
 };
 
 }  // namespace Audio
-}  // namespace Impacto
\ No newline at end of file
+}  // namespace Impacto
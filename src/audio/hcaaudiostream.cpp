@@ -3,6 +3,8 @@
 #include "../util.h"
 #include "../log.h"
 
+#include <utility>
+
 using namespace Impacto::Io;
 
 namespace Impacto {
@@ -10,6 +12,7 @@ namespace Audio {
 
 AudioStream* HcaAudioStream::Create(Stream* stream) {
   clHCA* Decoder = 0;
+  clHCA* LoopDecoder = 0;
   HcaAudioStream* result = 0;
 
   clHCA_stInfo info;
@@ -30,6 +33,14 @@ AudioStream* HcaAudioStream::Create(Stream* stream) {
 
   Decoder = clHCA_new();
   err = clHCA_DecodeHeader(Decoder, header, headerSize);
+  if (!err) {
+    clHCA_getInfo(Decoder, &info);
+    // Only looping files get a second decoder, to prime the loop start on
+    if (info.loopEnabled) {
+      LoopDecoder = clHCA_new();
+      err = clHCA_DecodeHeader(LoopDecoder, header, headerSize);
+    }
+  }
   ImpStackFree(header);
   if (err) {
     ImpLog(LogLevel::Error, LogChannel::Audio,
@@ -37,8 +48,6 @@ AudioStream* HcaAudioStream::Create(Stream* stream) {
     goto fail;
   }
 
-  clHCA_getInfo(Decoder, &info);
-
   if (info.channelCount != 1 && info.channelCount != 2) {
     ImpLog(LogLevel::Error, LogChannel::Audio,
            "Unsupported channel count {:d} in HCA\n", info.channelCount);
@@ -48,14 +57,17 @@ AudioStream* HcaAudioStream::Create(Stream* stream) {
   result = new HcaAudioStream;
   result->BaseStream = stream;
   result->Decoder = Decoder;
+  result->LoopDecoder = LoopDecoder;
   result->InitWithInfo(&info);
 
   return result;
 
 fail:
   if (Decoder) clHCA_delete(Decoder);
+  if (LoopDecoder) clHCA_delete(LoopDecoder);
   if (result) {
     result->Decoder = 0;
+    result->LoopDecoder = 0;
     result->BaseStream = 0;
     delete result;
   }
@@ -81,11 +93,16 @@ void HcaAudioStream::InitWithInfo(clHCA_stInfo* info) {
 
   BitDepth = 16;
 
+  // Each block's IMDCT overlaps into the next one
+  SeekPrerollBuffers = 1;
+  PrimeLoops = LoopDecoder != 0;
+
   EncodedBuffer = (uint8_t*)malloc(EncodedBytesPerBuffer);
   DecodedBuffer =
       (int16_t*)malloc(sizeof(int16_t) * SamplesPerBuffer * ChannelCount);
 
   clHCA_SetKey(Decoder, 0xCF222F1FE0748978u);  // default key
+  if (LoopDecoder) clHCA_SetKey(LoopDecoder, 0xCF222F1FE0748978u);
 
   clHCA_DecodeReset(Decoder);
   Seek(info->encoderDelay);
@@ -95,6 +112,7 @@ HcaAudioStream::~HcaAudioStream() {
   if (EncodedBuffer) free(EncodedBuffer);
   if (DecodedBuffer) free(DecodedBuffer);
   if (Decoder) clHCA_delete(Decoder);
+  if (LoopDecoder) clHCA_delete(LoopDecoder);
 }
 
 int HcaAudioStream::Read(void* buffer, int samples) {
@@ -104,13 +122,16 @@ int HcaAudioStream::Read(void* buffer, int samples) {
 void HcaAudioStream::Seek(int samples) { SeekBuffered(samples); }
 
 bool HcaAudioStream::DecodeBuffer() {
-  // TODO clHCA_DecodeReset after seek?
   int err = clHCA_DecodeBlock(Decoder, EncodedBuffer, EncodedBytesPerBuffer);
   if (err < 0) return false;
   clHCA_ReadSamples16(Decoder, DecodedBuffer);
   return true;
 }
 
+void HcaAudioStream::ResetDecoder() { clHCA_DecodeReset(Decoder); }
+
+void HcaAudioStream::SwapDecoders() { std::swap(Decoder, LoopDecoder); }
+
 bool HcaAudioStream::_registered =
     AudioStream::AddAudioStreamCreator(&HcaAudioStream::Create);
 
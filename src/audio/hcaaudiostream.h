@@ -21,6 +21,8 @@ class HcaAudioStream : public AudioStream,
 
  protected:
   bool DecodeBuffer();
+  void ResetDecoder();
+  void SwapDecoders();
 
  private:
   static AudioStream* Create(Io::Stream* stream);
@@ -29,6 +31,8 @@ class HcaAudioStream : public AudioStream,
   void InitWithInfo(clHCA_stInfo* info);
 
   clHCA* Decoder = 0;
+  // Primed with the loop start while the end of the loop plays
+  clHCA* LoopDecoder = 0;
 
   static bool _registered;
 };
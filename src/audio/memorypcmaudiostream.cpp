@@ -0,0 +1,67 @@
+#include "memorypcmaudiostream.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Impacto {
+namespace Audio {
+
+std::shared_ptr<const DecodedPcm> DecodedPcm::Decode(AudioStream& stream) {
+  if (stream.Duration <= 0) return nullptr;
+
+  auto pcm = std::make_shared<DecodedPcm>();
+  pcm->ChannelCount = stream.ChannelCount;
+  pcm->SampleRate = stream.SampleRate;
+  pcm->BitDepth = stream.BitDepth;
+  pcm->LoopStart = stream.LoopStart;
+  pcm->LoopEnd = stream.LoopEnd;
+  pcm->Duration = stream.Duration;
+  pcm->Samples.resize((size_t)stream.Duration * stream.BytesPerSample());
+
+  int samplesRead = 0;
+  while (samplesRead < stream.Duration) {
+    int read = stream.Read(&pcm->Samples[samplesRead * stream.BytesPerSample()],
+                           stream.Duration - samplesRead);
+    if (read == 0) break;
+    samplesRead += read;
+  }
+
+  // Trust what the decoder actually delivered over the header
+  if (samplesRead < pcm->Duration) {
+    pcm->Duration = samplesRead;
+    pcm->Samples.resize((size_t)samplesRead * stream.BytesPerSample());
+    pcm->LoopEnd = std::min(pcm->LoopEnd, samplesRead);
+    pcm->LoopStart = std::min(pcm->LoopStart, pcm->LoopEnd);
+  }
+
+  return pcm;
+}
+
+MemoryPcmAudioStream::MemoryPcmAudioStream(
+    std::shared_ptr<const DecodedPcm> pcm)
+    : Pcm(std::move(pcm)) {
+  ChannelCount = Pcm->ChannelCount;
+  SampleRate = Pcm->SampleRate;
+  BitDepth = Pcm->BitDepth;
+  LoopStart = Pcm->LoopStart;
+  LoopEnd = Pcm->LoopEnd;
+  Duration = Pcm->Duration;
+}
+
+int MemoryPcmAudioStream::Read(void* buffer, int samples) {
+  samples = std::min(samples, Duration - ReadPosition);
+  if (samples <= 0) return 0;
+
+  const int bytesPerSample = BytesPerSample();
+  memcpy(buffer, &Pcm->Samples[ReadPosition * bytesPerSample],
+         samples * bytesPerSample);
+  ReadPosition += samples;
+  return samples;
+}
+
+void MemoryPcmAudioStream::Seek(int samples) {
+  ReadPosition = std::clamp(samples, 0, Duration);
+}
+
+}  // namespace Audio
+}  // namespace Impacto
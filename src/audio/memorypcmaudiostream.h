@@ -0,0 +1,38 @@
+#pragma once
+
+#include "audiostream.h"
+
+#include <memory>
+#include <vector>
+
+namespace Impacto {
+namespace Audio {
+
+// A fully decoded clip, shared between every stream playing it
+struct DecodedPcm {
+  int ChannelCount;
+  int SampleRate;
+  int BitDepth;
+  int LoopStart;
+  int LoopEnd;
+  int Duration;
+
+  std::vector<uint8_t> Samples;
+
+  static std::shared_ptr<const DecodedPcm> Decode(AudioStream& stream);
+};
+
+// Serves reads from an immutable decoded clip instead of a decoder
+class MemoryPcmAudioStream : public AudioStream {
+ public:
+  MemoryPcmAudioStream(std::shared_ptr<const DecodedPcm> pcm);
+
+  int Read(void* buffer, int samples) override;
+  void Seek(int samples) override;
+
+ private:
+  std::shared_ptr<const DecodedPcm> Pcm;
+};
+
+}  // namespace Audio
+}  // namespace Impacto
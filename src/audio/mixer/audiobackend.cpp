@@ -0,0 +1,272 @@
+#include "audiobackend.h"
+#include "mixer.h"
+
+#include "../../log.h"
+#include "../../io/physicalfilestream.h"
+#include "../../profile/game.h"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <vector>
+
+#if IMPACTO_HAVE_THREADS
+#include <atomic>
+#include <chrono>
+#include <thread>
+#endif
+
+namespace Impacto {
+namespace Audio {
+namespace Mixer {
+
+// Where the mixed stream ends up
+class AudioSink {
+ public:
+  virtual ~AudioSink() = default;
+
+  // Creates MainMixer at the rate the sink runs at
+  virtual bool Open() = 0;
+  virtual void Close() = 0;
+
+  // Called every game update with the time that passed
+  virtual void Update(float dt) {}
+};
+
+class DeviceSink : public AudioSink {
+ public:
+  bool Open() override {
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) != 0) {
+      ImpLog(LogLevel::Fatal, LogChannel::Audio,
+             "Could not initialize SDL audio: {:s}\n", SDL_GetError());
+      return false;
+    }
+
+    SDL_AudioSpec want{};
+    want.freq = Profile::AudioMixerSampleRate;
+    want.format = AUDIO_F32SYS;
+    want.channels = AudioMixer::OutputChannels;
+    want.samples = 1024;
+    want.callback = &DeviceSink::Callback;
+
+    SDL_AudioSpec have;
+    Device = SDL_OpenAudioDevice(nullptr, 0, &want, &have,
+                                 SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+    if (Device == 0) {
+      ImpLog(LogLevel::Fatal, LogChannel::Audio,
+             "Could not open audio device: {:s}\n", SDL_GetError());
+      SDL_QuitSubSystem(SDL_INIT_AUDIO);
+      return false;
+    }
+
+    ImpLog(LogLevel::Info, LogChannel::Audio,
+           "Mixing at {:d} Hz in blocks of {:d} frames\n", have.freq,
+           have.samples);
+    MainMixer = std::make_unique<AudioMixer>(have.freq, have.samples);
+    SDL_PauseAudioDevice(Device, 0);
+    return true;
+  }
+
+  void Close() override {
+    if (Device == 0) return;
+    SDL_CloseAudioDevice(Device);
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    Device = 0;
+  }
+
+ private:
+  static void SDLCALL Callback(void*, Uint8* stream, int len) {
+    MainMixer->Render((float*)stream,
+                      len / (sizeof(float) * AudioMixer::OutputChannels));
+  }
+
+  SDL_AudioDeviceID Device = 0;
+};
+
+#if IMPACTO_HAVE_THREADS
+// Renders without a device, for machines without audio output and for
+// profiling the mixer in isolation. Either in real time on its own thread, or
+// offline in lockstep with game time, as fast as the game updates and waiting
+// for decoders instead of running dry.
+class PacedSink : public AudioSink {
+ public:
+  static int constexpr BlockFrames = 1024;
+
+  bool Open() override {
+    Offline = Profile::AudioMixerOffline;
+    MainMixer = std::make_unique<AudioMixer>(Profile::AudioMixerSampleRate,
+                                             BlockFrames, Offline);
+    if (!OpenOutput()) {
+      MainMixer = nullptr;
+      return false;
+    }
+
+    Block.resize(BlockFrames * AudioMixer::OutputChannels);
+    PendingFrames = 0.0;
+    if (!Offline) {
+      Running = true;
+      Thread = std::thread(&PacedSink::Run, this);
+    }
+    return true;
+  }
+
+  void Close() override {
+    if (!MainMixer) return;
+    if (Running) {
+      Running = false;
+      Thread.join();
+    }
+    CloseOutput();
+  }
+
+  void Update(float dt) override {
+    if (!Offline) return;
+
+    PendingFrames += (double)dt * MainMixer->GetOutputRate();
+    while (PendingFrames >= 1.0) {
+      const int frames = std::min((int)PendingFrames, BlockFrames);
+      MainMixer->Render(Block.data(), frames);
+      Output(Block.data(), frames);
+      PendingFrames -= frames;
+    }
+  }
+
+ protected:
+  virtual bool OpenOutput() { return true; }
+  virtual void CloseOutput() {}
+  virtual void Output(const float*, int) {}
+
+ private:
+  void Run() {
+    using Clock = std::chrono::steady_clock;
+
+    const auto blockDuration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>((double)BlockFrames /
+                                      MainMixer->GetOutputRate()));
+
+    auto nextBlock = Clock::now();
+    while (Running) {
+      MainMixer->Render(Block.data(), BlockFrames);
+      Output(Block.data(), BlockFrames);
+
+      nextBlock += blockDuration;
+      std::this_thread::sleep_until(nextBlock);
+    }
+  }
+
+  bool Offline = false;
+  std::vector<float> Block;
+  // Output frames game time has advanced by that weren't rendered yet
+  double PendingFrames = 0.0;
+
+  std::thread Thread;
+  std::atomic<bool> Running = false;
+};
+
+// Writes the mix to a 32-bit float WAV file
+class FileSink : public PacedSink {
+ protected:
+  bool OpenOutput() override {
+    using CF = Io::PhysicalFileStream::CreateFlagsMode;
+    IoError err = Io::PhysicalFileStream::Create(
+        Profile::AudioMixerSinkPath, &File,
+        CF::CREATE_IF_NOT_EXISTS | CF::TRUNCATE | CF::WRITE);
+    if (err != IoError_OK) {
+      ImpLog(LogLevel::Fatal, LogChannel::Audio,
+             "Could not open {:s} for writing\n", Profile::AudioMixerSinkPath);
+      return false;
+    }
+
+    DataSize = 0;
+    WriteHeader();
+    return true;
+  }
+
+  void CloseOutput() override {
+    // Now that the sizes are known
+    File->Seek(0, RW_SEEK_SET);
+    WriteHeader();
+    delete File;
+    File = nullptr;
+  }
+
+  void Output(const float* samples, int frames) override {
+    const uint32_t size =
+        frames * AudioMixer::OutputChannels * (uint32_t)sizeof(float);
+    File->Write((void*)samples, size);
+    DataSize += size;
+  }
+
+ private:
+  void WriteHeader() {
+    const uint16_t channels = AudioMixer::OutputChannels;
+    const uint32_t rate = MainMixer->GetOutputRate();
+    const uint16_t blockAlign = channels * sizeof(float);
+
+    Io::WriteBE<uint32_t>(File, 0x52494646);  // "RIFF"
+    Io::WriteLE<uint32_t>(File, 36 + DataSize);
+    Io::WriteBE<uint32_t>(File, 0x57415645);  // "WAVE"
+    Io::WriteBE<uint32_t>(File, 0x666D7420);  // "fmt "
+    Io::WriteLE<uint32_t>(File, 16);
+    Io::WriteLE<uint16_t>(File, 3);  // IEEE float
+    Io::WriteLE<uint16_t>(File, channels);
+    Io::WriteLE<uint32_t>(File, rate);
+    Io::WriteLE<uint32_t>(File, rate * blockAlign);
+    Io::WriteLE<uint16_t>(File, blockAlign);
+    Io::WriteLE<uint16_t>(File, 32);
+    Io::WriteBE<uint32_t>(File, 0x64617461);  // "data"
+    Io::WriteLE<uint32_t>(File, DataSize);
+  }
+
+  Io::Stream* File = nullptr;
+  uint32_t DataSize = 0;
+};
+#endif
+
+static AudioSink* CreateSink(AudioMixerSinkType type) {
+  switch (type) {
+#if IMPACTO_HAVE_THREADS
+    case AudioMixerSinkType::Null:
+      return new PacedSink();
+    case AudioMixerSinkType::File:
+      return new FileSink();
+#else
+    case AudioMixerSinkType::Null:
+    case AudioMixerSinkType::File:
+      ImpLog(LogLevel::Warning, LogChannel::Audio,
+             "Mixer sink {:s} needs threads, using the audio device\n",
+             type._to_string());
+      return new DeviceSink();
+#endif
+    case AudioMixerSinkType::Device:
+    default:
+      return new DeviceSink();
+  }
+}
+
+bool AudioBackend::Init() {
+  Sink = CreateSink(Profile::AudioMixerSink);
+  if (!Sink->Open()) {
+    delete Sink;
+    Sink = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void AudioBackend::Update(float dt) {
+  if (Sink) Sink->Update(dt);
+}
+
+void AudioBackend::Shutdown() {
+  if (Sink) {
+    Sink->Close();
+    delete Sink;
+    Sink = nullptr;
+  }
+  MainMixer = nullptr;
+}
+
+}  // namespace Mixer
+}  // namespace Audio
+}  // namespace Impacto
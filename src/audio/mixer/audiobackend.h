@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../audiobackend.h"
+
+namespace Impacto {
+namespace Audio {
+namespace Mixer {
+
+class AudioSink;
+
+// Mixes all channels in software and hands a single stream to an output sink
+class AudioBackend : public Audio::AudioBackend {
+ public:
+  bool Init() override;
+
+  void Update(float dt) override;
+
+  void Shutdown() override;
+
+ private:
+  AudioSink* Sink = nullptr;
+};
+
+}  // namespace Mixer
+}  // namespace Audio
+}  // namespace Impacto
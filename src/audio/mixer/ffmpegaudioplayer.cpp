@@ -0,0 +1,131 @@
+#include "ffmpegaudioplayer.h"
+#include "mixer.h"
+#include "../../video/ffmpegplayer.h"
+#include "../audiosystem.h"
+#include <timestamp.h>
+
+extern "C" {
+#include <libavutil/avutil.h>
+#include <libavcodec/avcodec.h>
+#include <libswresample/swresample.h>
+};
+
+#include <algorithm>
+#include <cstring>
+
+namespace Impacto {
+namespace Audio {
+namespace Mixer {
+
+FFmpegAudioPlayer::~FFmpegAudioPlayer() {
+  EndPlayback();
+  if (AudioBuffer) av_freep(&AudioBuffer[0]);
+  swr_free(&AudioConvertContext);
+}
+
+void FFmpegAudioPlayer::InitConvertContext(AVCodecContext* codecCtx) {
+  AVChannelLayout stereoFormat;
+  av_channel_layout_default(&stereoFormat, OutputChannels);
+  int res = swr_alloc_set_opts2(&AudioConvertContext, &stereoFormat,
+                                AV_SAMPLE_FMT_S16, codecCtx->sample_rate,
+                                &stereoFormat, codecCtx->sample_fmt,
+                                codecCtx->sample_rate, 0, NULL);
+  if (res) {
+    ImpLog(LogLevel::Error, LogChannel::Video,
+           "Could not create audio convert context!\n");
+    return;
+  }
+
+  swr_init(AudioConvertContext);
+  av_samples_alloc_array_and_samples(&AudioBuffer, &AudioLinesize,
+                                     codecCtx->ch_layout.nb_channels, 32000,
+                                     AV_SAMPLE_FMT_S16, 0);
+  SampleRate = codecCtx->sample_rate;
+}
+
+void FFmpegAudioPlayer::Stop() { StopRequested = true; }
+
+void FFmpegAudioPlayer::Unload() {
+  EndPlayback();
+  StopRequested = false;
+  if (AudioBuffer) av_freep(&AudioBuffer[0]);
+}
+
+// The mixer may still be reading the old ring, so every start gets a new one
+void FFmpegAudioPlayer::EndPlayback() {
+  if (Ring && MainMixer) MainMixer->StopMovie();
+  Ring = nullptr;
+  Pending.clear();
+  PendingOffset = 0;
+}
+
+void FFmpegAudioPlayer::FillAudioBuffers() {
+  while (!Player->AbortRequest) {
+    if (PendingOffset == Pending.size()) {
+      Video::AVFrameItem<AVMEDIA_TYPE_AUDIO> aFrame;
+      if (!Player->AudioStream->FrameQueue.try_dequeue(aFrame)) return;
+      if (aFrame.Serial == INT32_MIN) continue;
+
+      if (!Ring) {
+        StartPosition =
+            (int)(aFrame.Frame.pts().timestamp() * aFrame.Frame.sampleRate() *
+                  Player->AudioStream->stream.timeBase().getNumerator() /
+                  Player->AudioStream->stream.timeBase().getDenominator());
+        WrittenSamples = 0;
+        Ring = std::make_shared<PcmRing>(RingSizeInBytes / BytesPerSample,
+                                         BytesPerSample);
+        MainMixer->StartMovie(Ring, OutputChannels, SampleRate);
+      }
+
+      int64_t delay =
+          swr_get_delay(AudioConvertContext, aFrame.Frame.sampleRate());
+      int64_t samplesPerCh = av_rescale_rnd(
+          (int64_t)aFrame.Frame.samplesCount() + delay,
+          aFrame.Frame.sampleRate(), aFrame.Frame.sampleRate(), AV_ROUND_UP);
+      int outputSamples =
+          swr_convert(AudioConvertContext, AudioBuffer, (int)samplesPerCh,
+                      (const uint8_t**)aFrame.Frame.raw()->extended_data,
+                      aFrame.Frame.samplesCount());
+      if (outputSamples <= 0) continue;
+
+      Pending.assign(AudioBuffer[0],
+                     AudioBuffer[0] + outputSamples * BytesPerSample);
+      PendingOffset = 0;
+    }
+
+    while (PendingOffset < Pending.size()) {
+      std::span<uint8_t> region = Ring->WritableRegion();
+      if (region.empty()) return;
+
+      const size_t bytes =
+          std::min(region.size(), Pending.size() - PendingOffset);
+      memcpy(region.data(), Pending.data() + PendingOffset, bytes);
+      Ring->CommitWrite(bytes);
+      PendingOffset += bytes;
+      WrittenSamples += bytes / BytesPerSample;
+    }
+  }
+}
+
+void FFmpegAudioPlayer::Process() {
+  if (StopRequested.exchange(false)) EndPlayback();
+
+  FillAudioBuffers();
+  if (!Ring) return;
+
+  const float gain =
+      Audio::MasterVolume * Audio::GroupVolumes[Audio::ACG_Movie];
+  MainMixer->SetMovieVoice(gain, false);
+
+  // Whatever is still in the ring hasn't been mixed yet
+  const int64_t mixedSamples =
+      WrittenSamples - (int64_t)(Ring->BytesAvailable() / BytesPerSample);
+  int samplePosition = StartPosition + (int)mixedSamples;
+  samplePosition = std::min(samplePosition, Player->AudioStream->Duration);
+  auto audioTime = av::Timestamp(samplePosition, av::Rational(1, SampleRate));
+  AudioClock.Set(audioTime.seconds(), 0);
+}
+
+}  // namespace Mixer
+}  // namespace Audio
+}  // namespace Impacto
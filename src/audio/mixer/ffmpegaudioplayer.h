@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../ffmpegaudioplayer.h"
+#include "../pcmring.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Impacto {
+namespace Audio {
+namespace Mixer {
+
+// Converts movie audio to 16-bit stereo and feeds it to the mixer's movie
+// voice through a ring
+class FFmpegAudioPlayer : public Audio::FFmpegAudioPlayer {
+ public:
+  FFmpegAudioPlayer(Video::FFmpegPlayer* player)
+      : Audio::FFmpegAudioPlayer(player) {}
+  ~FFmpegAudioPlayer();
+
+  void InitConvertContext(AVCodecContext* codecCtx) override;
+  void FillAudioBuffers() override;
+  void Process() override;
+
+  // May be called from the audio decoder thread
+  void Stop() override;
+  void Unload() override;
+
+ private:
+  static int constexpr OutputChannels = 2;
+  static int constexpr BytesPerSample = OutputChannels * sizeof(int16_t);
+  static size_t constexpr RingSizeInBytes = 256 * 1024;
+
+  void EndPlayback();
+
+  std::shared_ptr<PcmRing> Ring;
+  // Converted frame that didn't fit into the ring yet
+  std::vector<uint8_t> Pending;
+  size_t PendingOffset = 0;
+
+  int SampleRate = 0;
+  int StartPosition = 0;
+  int64_t WrittenSamples = 0;
+
+  std::atomic<bool> StopRequested = false;
+};
+
+}  // namespace Mixer
+}  // namespace Audio
+}  // namespace Impacto
@@ -0,0 +1,261 @@
+#include "mixer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#if IMPACTO_HAVE_THREADS
+#include <thread>
+#endif
+
+namespace Impacto {
+namespace Audio {
+namespace Mixer {
+
+AudioMixer::AudioMixer(int outputRate, int maxFrames, bool offline)
+    : OutputRate(outputRate),
+      MaxFrames(maxFrames),
+      Offline(offline),
+      Commands(256),
+      Retired(256) {
+  for (auto& scratch : VoiceScratch) scratch.resize(MaxFrames);
+  MixBuffer.resize(MaxFrames * OutputChannels);
+}
+
+AudioMixer::~AudioMixer() {
+  for (Voice& voice : Voices) delete voice.Source;
+  Command command;
+  while (Commands.try_dequeue(command)) delete command.Source;
+  FreeRetired();
+}
+
+void AudioMixer::FreeRetired() {
+  VoiceSource* source;
+  while (Retired.try_dequeue(source)) delete source;
+}
+
+void AudioMixer::Push(Command const& command) {
+  FreeRetired();
+  Commands.enqueue(command);
+}
+
+void AudioMixer::StartSource(int voiceId, VoiceSource* source,
+                             int sampleRate) {
+  source->Resampling.Configure(source->ChannelCount, sampleRate, OutputRate);
+
+  // Enough input for a whole block, so Render never has to grow anything
+  const int maxInputFrames =
+      (int)((int64_t)MaxFrames * sampleRate / OutputRate) + Resampler::Taps +
+      1;
+  source->Resampling.Reserve(maxInputFrames + Resampler::Taps);
+  source->DecodeScratch.resize(maxInputFrames * source->BytesPerSample);
+
+  Push({CommandType::Start, voiceId, source, 0.0f, true});
+}
+
+void AudioMixer::Start(AudioChannelId id,
+                       std::shared_ptr<StreamDecoder> decoder,
+                       const AudioStream& stream) {
+  VoiceSource* source = new VoiceSource();
+  source->Decoder = std::move(decoder);
+  source->Serial = NextSerial++;
+  source->ChannelCount = stream.ChannelCount;
+  source->BitDepth = stream.BitDepth;
+  source->BytesPerSample = stream.BytesPerSample();
+
+  StartedSerials[id] = source->Serial;
+  StartSource(id, source, stream.SampleRate);
+}
+
+void AudioMixer::Stop(AudioChannelId id) {
+  StartedSerials[id] = 0;
+  Push({CommandType::Stop, id, nullptr, 0.0f, true});
+}
+
+void AudioMixer::SetVoice(AudioChannelId id, float gain, bool paused) {
+  Push({CommandType::Set, id, nullptr, gain, paused});
+}
+
+void AudioMixer::StartMovie(std::shared_ptr<PcmRing> ring, int channelCount,
+                            int sampleRate) {
+  VoiceSource* source = new VoiceSource();
+  source->Ring = std::move(ring);
+  source->ChannelCount = channelCount;
+  source->BitDepth = 16;
+  source->BytesPerSample = channelCount * 2;
+  StartSource(MovieVoice, source, sampleRate);
+}
+
+void AudioMixer::StopMovie() {
+  Push({CommandType::Stop, MovieVoice, nullptr, 0.0f, true});
+}
+
+void AudioMixer::SetMovieVoice(float gain, bool paused) {
+  Push({CommandType::Set, MovieVoice, nullptr, gain, paused});
+}
+
+void AudioMixer::ApplyCommands() {
+  Command command;
+  while (Commands.try_dequeue(command)) {
+    Voice& voice = Voices[command.VoiceId];
+    switch (command.Type) {
+      case CommandType::Start:
+      case CommandType::Stop: {
+        // Freeing is left to the main thread. Should it have fallen so far
+        // behind that the queue is full, freeing here beats leaking.
+        if (voice.Source && !Retired.try_enqueue(voice.Source)) {
+          delete voice.Source;
+        }
+        voice.Source = command.Source;
+
+        // Held until the channel first updates the voice, so nothing gets
+        // mixed before the channel's gain is known
+        voice.Paused = true;
+        voice.Gain = 0.0f;
+        voice.TargetGain = 0.0f;
+        voice.Starved = false;
+        voice.Finished = false;
+      } break;
+      case CommandType::Set: {
+        voice.TargetGain = command.Gain;
+        voice.Paused = command.Paused;
+      } break;
+    }
+  }
+}
+
+void AudioMixer::Render(float* output, int frames) {
+  const auto startTime = std::chrono::steady_clock::now();
+
+  ApplyCommands();
+  for (int rendered = 0; rendered < frames;) {
+    const int blockFrames = std::min(frames - rendered, MaxFrames);
+    RenderBlock(output + rendered * OutputChannels, blockFrames);
+    rendered += blockFrames;
+  }
+
+  const float elapsedUs = std::chrono::duration<float, std::micro>(
+                              std::chrono::steady_clock::now() - startTime)
+                              .count();
+  const float costUs = elapsedUs / (frames * 1000.0f / OutputRate);
+  MixCostUs = MixCostUs * 0.95f + costUs * 0.05f;
+  if (costUs > PeakMixCostUs) PeakMixCostUs = costUs;
+}
+
+void AudioMixer::RenderBlock(float* output, int frames) {
+  std::fill_n(MixBuffer.begin(), frames * OutputChannels, 0.0f);
+  for (int i = 0; i < VoiceCount; i++) {
+    Voice& voice = Voices[i];
+    if (!voice.Source || voice.Paused || voice.Finished) continue;
+    RenderVoice(i, voice, frames);
+  }
+
+  for (int i = 0; i < frames * OutputChannels; i++) {
+    output[i] = std::clamp(MixBuffer[i], -1.0f, 1.0f);
+  }
+}
+
+// Decodes enough of the voice's stream into its resampler to produce the
+// given amount of output frames, or whatever is available
+int AudioMixer::FillResampler(VoiceSource& source, int frames) {
+  const int neededFrames =
+      std::min(source.Resampling.InputFramesNeeded(frames),
+               (int)(source.DecodeScratch.size() / source.BytesPerSample));
+  if (neededFrames == 0) return 0;
+
+  uint8_t* scratch = source.DecodeScratch.data();
+  const size_t neededBytes = (size_t)neededFrames * source.BytesPerSample;
+  size_t readBytes = source.Decoder ? source.Decoder->Read(scratch, neededBytes)
+                                    : source.Ring->Read(scratch, neededBytes);
+
+  // Rendering offline there's no deadline, so let the decoder catch up
+  // rather than mixing in a gap
+  while (readBytes == 0 && Offline && source.Decoder &&
+         !source.Decoder->Drained() && !source.Decoder->IsCancelled()) {
+    AudioStreamer::Wake();
+    AudioStreamer::Update();
+#if IMPACTO_HAVE_THREADS
+    std::this_thread::yield();
+#endif
+    readBytes = source.Decoder->Read(scratch, neededBytes);
+  }
+
+  const int readFrames = (int)(readBytes / source.BytesPerSample);
+  if (readFrames == 0) return 0;
+
+  const int channels = source.Resampling.GetChannelCount();
+  for (int c = 0; c < channels; c++) {
+    float* dest = source.Resampling.PrepareInput(c, readFrames);
+    switch (source.BitDepth) {
+      case 8: {
+        const uint8_t* src = scratch + c;
+        for (int i = 0; i < readFrames; i++) {
+          dest[i] = ((int)src[i * source.ChannelCount] - 128) / 128.0f;
+        }
+      } break;
+      case 16: {
+        const int16_t* src = (const int16_t*)scratch + c;
+        for (int i = 0; i < readFrames; i++) {
+          dest[i] = src[i * source.ChannelCount] / 32768.0f;
+        }
+      } break;
+      case 32: {
+        const float* src = (const float*)scratch + c;
+        for (int i = 0; i < readFrames; i++) {
+          dest[i] = src[i * source.ChannelCount];
+        }
+      } break;
+      default:
+        std::fill_n(dest, readFrames, 0.0f);
+    }
+  }
+  source.Resampling.CommitInput(readFrames);
+
+  return readFrames;
+}
+
+void AudioMixer::RenderVoice(int id, Voice& voice, int frames) {
+  VoiceSource& source = *voice.Source;
+
+  int produced = 0;
+  while (true) {
+    produced += source.Resampling.Process(
+        {VoiceScratch[0].data() + produced, VoiceScratch[1].data() + produced},
+        frames - produced);
+    if (produced == frames) break;
+    if (FillResampler(source, frames - produced) == 0) break;
+  }
+
+  if (produced < frames) {
+    if (source.Decoder && source.Decoder->Drained()) {
+      voice.Finished = true;
+      FinishedSerials[id].store(source.Serial, std::memory_order_release);
+    } else if (!voice.Starved) {
+      // Count every time we run dry once, not every render it lasts. Movies
+      // running dry between frames are no underrun of a channel.
+      if (id != MovieVoice) ChannelStats[id].Underruns++;
+      voice.Starved = true;
+    }
+  } else {
+    voice.Starved = false;
+  }
+
+  // Ramp linearly towards the target gain over the whole render, which is
+  // plenty smooth for fades updated every frame
+  const float gainStep = (voice.TargetGain - voice.Gain) / frames;
+  float gain = voice.Gain;
+  const float* left = VoiceScratch[0].data();
+  const float* right = source.Resampling.GetChannelCount() == 2
+                           ? VoiceScratch[1].data()
+                           : VoiceScratch[0].data();
+  float* mix = MixBuffer.data();
+  for (int i = 0; i < produced; i++) {
+    mix[i * 2] += left[i] * gain;
+    mix[i * 2 + 1] += right[i] * gain;
+    gain += gainStep;
+  }
+  voice.Gain = voice.TargetGain;
+}
+
+}  // namespace Mixer
+}  // namespace Audio
+}  // namespace Impacto
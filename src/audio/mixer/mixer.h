@@ -0,0 +1,142 @@
+#pragma once
+
+#include "resampler.h"
+#include "../audiocommon.h"
+#include "../audiostreamer.h"
+#include "../pcmring.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#if __SWITCH__
+#define __unix__
+#endif
+#include <readerwriterqueue.h>
+#if __SWITCH__
+#undef __unix__
+#endif
+
+namespace Impacto {
+namespace Audio {
+namespace Mixer {
+
+// Mixes every channel's decoded stream into interleaved float stereo at the
+// output rate. Channels update their voice from the main thread, Render is
+// called from whatever drives the output (the device's audio callback or a
+// sink thread). The two sides only talk through lock-free queues, and Render
+// never allocates.
+class AudioMixer {
+ public:
+  static int constexpr OutputChannels = 2;
+
+  // Render may be asked for any amount of frames, but mixes in blocks of at
+  // most maxFrames. Offline mixers wait for decoders instead of running dry.
+  AudioMixer(int outputRate, int maxFrames, bool offline = false);
+  ~AudioMixer();
+
+  int GetOutputRate() const { return OutputRate; }
+
+  // Main thread side
+  void Start(AudioChannelId id, std::shared_ptr<StreamDecoder> decoder,
+             const AudioStream& stream);
+  void Stop(AudioChannelId id);
+  void SetVoice(AudioChannelId id, float gain, bool paused);
+  // The voice's stream has been drained and mixed completely
+  bool IsFinished(AudioChannelId id) const {
+    return StartedSerials[id] != 0 &&
+           FinishedSerials[id].load(std::memory_order_acquire) ==
+               StartedSerials[id];
+  }
+
+  // Movie audio, fed as 16-bit PCM by the movie player as it decodes it
+  void StartMovie(std::shared_ptr<PcmRing> ring, int channelCount,
+                  int sampleRate);
+  void StopMovie();
+  void SetMovieVoice(float gain, bool paused);
+
+  void Render(float* output, int frames);
+
+  // Average and peak time it took to mix a millisecond of output
+  float GetMixCostUs() const { return MixCostUs.load(); }
+  float GetPeakMixCostUs() const { return PeakMixCostUs.load(); }
+  void ResetPeakMixCost() { PeakMixCostUs = 0.0f; }
+
+ private:
+  static int constexpr MovieVoice = AC_Count;
+  static int constexpr VoiceCount = AC_Count + 1;
+
+  // Everything a voice needs to play one stream. Set up on the main thread,
+  // swapped into the voice by Render, and handed back to the main thread to
+  // be freed once replaced.
+  struct VoiceSource {
+    // One of the two
+    std::shared_ptr<StreamDecoder> Decoder;
+    std::shared_ptr<PcmRing> Ring;
+
+    uint32_t Serial = 0;
+    int ChannelCount = 0;
+    int BitDepth = 0;
+    int BytesPerSample = 0;
+    Resampler Resampling;
+    std::vector<uint8_t> DecodeScratch;
+  };
+
+  struct Voice {
+    VoiceSource* Source = nullptr;
+
+    float TargetGain = 0.0f;
+    // Gain the last rendered frame ended at, ramped towards TargetGain over
+    // the next render so gain changes don't click
+    float Gain = 0.0f;
+    bool Paused = false;
+    bool Starved = false;
+    bool Finished = false;
+  };
+
+  enum class CommandType { Start, Stop, Set };
+  struct Command {
+    CommandType Type;
+    int VoiceId;
+    VoiceSource* Source;
+    float Gain;
+    bool Paused;
+  };
+
+  void Push(Command const& command);
+  void StartSource(int voiceId, VoiceSource* source, int sampleRate);
+  void FreeRetired();
+
+  void ApplyCommands();
+  void RenderBlock(float* output, int frames);
+  void RenderVoice(int id, Voice& voice, int frames);
+  int FillResampler(VoiceSource& source, int frames);
+
+  const int OutputRate;
+  const int MaxFrames;
+  const bool Offline;
+
+  // Main thread to Render
+  moodycamel::ReaderWriterQueue<Command> Commands;
+  // Render back to the main thread, sources that were replaced
+  moodycamel::ReaderWriterQueue<VoiceSource*> Retired;
+
+  // Main thread side
+  uint32_t NextSerial = 1;
+  uint32_t StartedSerials[AC_Count] = {};
+  std::atomic<uint32_t> FinishedSerials[AC_Count] = {};
+
+  // Render side, all sized once up front
+  Voice Voices[VoiceCount];
+  std::array<std::vector<float>, Resampler::MaxChannels> VoiceScratch;
+  std::vector<float> MixBuffer;
+
+  std::atomic<float> MixCostUs = 0.0f;
+  std::atomic<float> PeakMixCostUs = 0.0f;
+};
+
+inline std::unique_ptr<AudioMixer> MainMixer;
+
+}  // namespace Mixer
+}  // namespace Audio
+}  // namespace Impacto
@@ -0,0 +1,106 @@
+#include "mixeraudiochannel.h"
+#include "mixer.h"
+#include "../audiosystem.h"
+
+namespace Impacto {
+namespace Audio {
+namespace Mixer {
+
+MixerAudioChannel::~MixerAudioChannel() { EndPlayback(); }
+
+void MixerAudioChannel::Play(std::unique_ptr<AudioStream> stream, bool loop,
+                             float fadeInDuration) {
+  EndPlayback();
+  if (!stream) return;
+
+  Stream = std::move(stream);
+  Decoder = std::make_shared<StreamDecoder>(Id, Stream, loop);
+  AudioStreamer::Start(Decoder);
+  MainMixer->Start(Id, Decoder, *Stream);
+
+  FadeDuration = fadeInDuration;
+  FadeProgress = FadeDuration == 0 ? 1.0f : 0.0f;
+  State = FadeDuration == 0 ? ACS_Playing : ACS_FadingIn;
+  Looping = loop;
+}
+
+void MixerAudioChannel::Stop(float fadeOutDuration) {
+  if (State == ACS_Stopped) return;
+
+  if (fadeOutDuration == 0 || State == ACS_Paused) {
+    EndPlayback();
+    return;
+  }
+
+  State = ACS_FadingOut;
+  FadeDuration = fadeOutDuration;
+  FadeProgress = 0;
+}
+
+void MixerAudioChannel::EndPlayback() {
+  if (Decoder) {
+    Decoder->Cancel();
+    if (MainMixer) MainMixer->Stop(Id);
+  }
+
+  Decoder = nullptr;
+  Stream = nullptr;
+  State = ACS_Stopped;
+  FadeProgress = 0;
+}
+
+void MixerAudioChannel::Pause() {
+  if (State != ACS_Playing && State != ACS_FadingIn && State != ACS_FadingOut) {
+    return;
+  }
+
+  State = ACS_Paused;
+}
+
+void MixerAudioChannel::Resume() {
+  if (State != ACS_Paused) return;
+
+  State = ACS_Playing;
+}
+
+float MixerAudioChannel::PositionInSeconds() const {
+  if (!Decoder) return 0.0f;
+  return (float)Decoder->ConsumedPosition() / Stream->SampleRate;
+}
+
+// Same curves as the OpenAL channels, the mixer ramps between the gains we
+// hand it every update so there is no need to evaluate them per sample
+float MixerAudioChannel::GetGain() const {
+  float gain = MasterVolume * GroupVolumes[Group] * Volume;
+  const float progress3 = FadeProgress * FadeProgress * FadeProgress;
+  if (State == ACS_FadingIn) gain *= progress3;
+  if (State == ACS_FadingOut) gain *= 1.0f - progress3;
+  return gain;
+}
+
+void MixerAudioChannel::Update(float dt) {
+  if (State == ACS_FadingIn || State == ACS_FadingOut) {
+    FadeProgress = std::min(1.0f, FadeProgress + dt / FadeDuration);
+    if (FadeProgress >= 1.0f) {
+      if (State == ACS_FadingOut) {
+        EndPlayback();
+        return;
+      }
+      State = ACS_Playing;
+    }
+  }
+
+  if (!Decoder) return;
+
+  if (MainMixer->IsFinished(Id)) {
+    EndPlayback();
+    return;
+  }
+
+  Decoder->SetLooping(Looping);
+  MainMixer->SetVoice(Id, GetGain(), State == ACS_Paused);
+}
+
+}  // namespace Mixer
+}  // namespace Audio
+}  // namespace Impacto
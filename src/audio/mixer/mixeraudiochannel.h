@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../audiochannel.h"
+#include "../audiostreamer.h"
+
+namespace Impacto {
+namespace Audio {
+namespace Mixer {
+
+class MixerAudioChannel : public Audio::AudioChannel {
+ public:
+  MixerAudioChannel(AudioChannelId id, AudioChannelGroup group)
+      : AudioChannel(id, group) {}
+  ~MixerAudioChannel();
+
+  void Play(std::unique_ptr<AudioStream> stream, bool loop,
+            float fadeInDuration) override;
+  void Stop(float fadeOutDuration) override;
+  void Pause() override;
+  void Resume() override;
+
+  void Update(float dt) override;
+
+  float PositionInSeconds() const override;
+
+ private:
+  std::shared_ptr<StreamDecoder> Decoder;
+
+  float FadeDuration = 0;
+  float FadeProgress = 0;
+
+  void EndPlayback();
+  float GetGain() const;
+};
+
+}  // namespace Mixer
+}  // namespace Audio
+}  // namespace Impacto
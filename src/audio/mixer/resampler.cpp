@@ -0,0 +1,160 @@
+#include "resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+#if defined(__SSE__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define IMPACTO_RESAMPLER_SSE 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define IMPACTO_RESAMPLER_NEON 1
+#endif
+
+namespace Impacto {
+namespace Audio {
+namespace Mixer {
+
+static_assert(Resampler::Taps % 4 == 0);
+
+static inline float Dot(const float* input, const float* coefficients) {
+#if IMPACTO_RESAMPLER_SSE
+  __m128 sum = _mm_setzero_ps();
+  for (int i = 0; i < Resampler::Taps; i += 4) {
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(input + i),
+                                     _mm_loadu_ps(coefficients + i)));
+  }
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  return _mm_cvtss_f32(sum);
+#elif IMPACTO_RESAMPLER_NEON
+  float32x4_t sum = vdupq_n_f32(0.0f);
+  for (int i = 0; i < Resampler::Taps; i += 4) {
+    sum = vmlaq_f32(sum, vld1q_f32(input + i), vld1q_f32(coefficients + i));
+  }
+  float32x2_t half = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+  return vget_lane_f32(vpadd_f32(half, half), 0);
+#else
+  float sum = 0.0f;
+  for (int i = 0; i < Resampler::Taps; i++) sum += input[i] * coefficients[i];
+  return sum;
+#endif
+}
+
+void Resampler::Configure(int channelCount, int inputRate, int outputRate) {
+  const bool filterChanged =
+      InputRate != inputRate || OutputRate != outputRate || Filter.empty();
+  ChannelCount = std::min(channelCount, MaxChannels);
+  InputRate = inputRate;
+  OutputRate = outputRate;
+  Step = ((uint64_t)inputRate << 32) / outputRate;
+
+  if (filterChanged && !IsPassthrough()) {
+    // Band limit to the lower of both Nyquist frequencies, with a little
+    // headroom for the transition band
+    const double cutoff =
+        std::min(1.0, (double)outputRate / (double)inputRate) * 0.95;
+    const double center = Taps / 2 - 1;
+
+    Filter.resize(Phases * Taps);
+    for (int phase = 0; phase < Phases; phase++) {
+      float* coefficients = &Filter[phase * Taps];
+      double sum = 0.0;
+      for (int tap = 0; tap < Taps; tap++) {
+        const double x = tap - center - (double)phase / Phases;
+        const double sinc =
+            x == 0.0 ? 1.0
+                     : std::sin(std::numbers::pi * cutoff * x) /
+                           (std::numbers::pi * cutoff * x);
+        const double window =
+            0.42 + 0.5 * std::cos(2.0 * std::numbers::pi * x / Taps) +
+            0.08 * std::cos(4.0 * std::numbers::pi * x / Taps);
+        coefficients[tap] = (float)(sinc * window);
+        sum += coefficients[tap];
+      }
+      // Unity gain at DC for every phase
+      for (int tap = 0; tap < Taps; tap++) coefficients[tap] /= (float)sum;
+    }
+  }
+
+  Reset();
+}
+
+void Resampler::Reset() {
+  Position = 0;
+  // Start out with silence as the history before the first frame
+  InputFrames = IsPassthrough() ? 0 : Taps - 1;
+  for (auto& input : Input) {
+    input.assign(std::max<size_t>(input.size(), InputFrames), 0.0f);
+  }
+}
+
+int Resampler::InputFramesNeeded(int outputFrames) const {
+  if (outputFrames <= 0) return 0;
+
+  const uint64_t last = (Position + (uint64_t)(outputFrames - 1) * Step) >> 32;
+  const int window = IsPassthrough() ? 1 : Taps;
+  return std::max(0, (int)last + window - InputFrames);
+}
+
+void Resampler::Reserve(int inputFrames) {
+  for (auto& input : Input) input.reserve(inputFrames);
+}
+
+float* Resampler::PrepareInput(int channel, int frames) {
+  std::vector<float>& input = Input[channel];
+  if (input.size() < (size_t)(InputFrames + frames)) {
+    input.resize(InputFrames + frames);
+  }
+  return input.data() + InputFrames;
+}
+
+void Resampler::CommitInput(int frames) { InputFrames += frames; }
+
+int Resampler::Process(std::array<float*, MaxChannels> output,
+                       int maxFrames) {
+  int written = 0;
+
+  if (IsPassthrough()) {
+    const int start = (int)(Position >> 32);
+    written = std::min(maxFrames, InputFrames - start);
+    for (int c = 0; c < ChannelCount; c++) {
+      memcpy(output[c], Input[c].data() + start, written * sizeof(float));
+    }
+    Position += (uint64_t)written << 32;
+  } else {
+    while (written < maxFrames) {
+      const int index = (int)(Position >> 32);
+      if (index + Taps > InputFrames) break;
+
+      const int phase = (int)((Position & 0xFFFFFFFFu) * Phases >> 32);
+      const float* coefficients = &Filter[phase * Taps];
+      for (int c = 0; c < ChannelCount; c++) {
+        output[c][written] = Dot(Input[c].data() + index, coefficients);
+      }
+
+      Position += Step;
+      written++;
+    }
+  }
+
+  // Drop consumed input, keeping what the next output frame still needs
+  const int consumed = std::min((int)(Position >> 32), InputFrames);
+  if (consumed > 0) {
+    for (int c = 0; c < ChannelCount; c++) {
+      std::copy(Input[c].begin() + consumed, Input[c].begin() + InputFrames,
+                Input[c].begin());
+    }
+    InputFrames -= consumed;
+    Position -= (uint64_t)consumed << 32;
+  }
+
+  return written;
+}
+
+}  // namespace Mixer
+}  // namespace Audio
+}  // namespace Impacto
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Impacto {
+namespace Audio {
+namespace Mixer {
+
+// Windowed sinc polyphase resampler for planar float audio. Keeps the last
+// Taps - 1 input frames of every channel around, so a stream can be fed to it
+// in arbitrary chunks.
+class Resampler {
+ public:
+  static int constexpr Taps = 16;
+  static int constexpr Phases = 256;
+  static int constexpr MaxChannels = 2;
+
+  void Configure(int channelCount, int inputRate, int outputRate);
+  void Reset();
+
+  bool IsPassthrough() const { return InputRate == OutputRate; }
+  int GetChannelCount() const { return ChannelCount; }
+
+  // Input frames needed before Process() can produce outputFrames more
+  int InputFramesNeeded(int outputFrames) const;
+
+  // Makes room for this many input frames of history, so feeding that much
+  // never allocates
+  void Reserve(int inputFrames);
+
+  // Appends input frames to each channel's history
+  float* PrepareInput(int channel, int frames);
+  void CommitInput(int frames);
+
+  // Resamples as many frames as there is input for, up to maxFrames, into one
+  // planar output buffer per channel. Returns the amount of frames written.
+  int Process(std::array<float*, MaxChannels> output, int maxFrames);
+
+ private:
+  int ChannelCount = 0;
+  int InputRate = 0;
+  int OutputRate = 0;
+
+  // Input position in 32.32 fixed point, relative to the start of Input
+  uint64_t Position = 0;
+  uint64_t Step = 0;
+
+  // Coefficients for each phase, with Taps entries each
+  std::vector<float> Filter;
+
+  std::array<std::vector<float>, MaxChannels> Input;
+  int InputFrames = 0;
+};
+
+}  // namespace Mixer
+}  // namespace Audio
+}  // namespace Impacto
@@ -45,6 +45,8 @@ void OpenALAudioChannel::Play(std::unique_ptr<AudioStream> stream, bool loop,
   EndPlayback();
 
   Stream = std::move(stream);
+  Decoder = std::make_shared<StreamDecoder>(Id, Stream, loop);
+  AudioStreamer::Start(Decoder);
   FadeDuration = fadeInDuration;
   FadeProgress = FadeDuration == 0 ? 1.0f : 0.0f;
   State = FadeDuration == 0 ? ACS_Playing : ACS_FadingIn;
@@ -71,6 +73,8 @@ void OpenALAudioChannel::EndPlayback() {
   alGetSourcei(Source, AL_BUFFERS_QUEUED, &queuedBuffers);
   UnqueueBuffers(queuedBuffers);
 
+  if (Decoder) Decoder->Cancel();
+  Decoder = nullptr;
   Stream = nullptr;
   PlaybackStarted = false;
   State = ACS_Stopped;
@@ -109,27 +113,21 @@ void OpenALAudioChannel::Update(float dt) {
     // Continuously update the gain
     // because the global state might have changed
     UpdateGain();
+    Decoder->SetLooping(Looping);
 
     ALint processedBuffers;
     alGetSourcei(Source, AL_BUFFERS_PROCESSED, &processedBuffers);
     UnqueueBuffers(processedBuffers);
 
-    // TODO do this on background thread
+    // Decoding happens on the streaming thread, we only hand over what it
+    // has already put into the ring
     while (CanQueueBuffer()) {
       int queuedBuffers;
       alGetSourcei(Source, AL_BUFFERS_QUEUED, &queuedBuffers);
 
       size_t firstFreeIndex =
           (FirstQueuedBufferIndex + queuedBuffers) % AudioBuffers.size();
-      QueueBuffer(firstFreeIndex);
-
-      if (queuedBuffers == 0 && PlaybackStarted) {
-        ImpLog(LogLevel::Error, LogChannel::Audio,
-               "Buffer underrun on channel {:d}\n", Id);
-
-        // Restart playback in case of buffer underrun
-        alSourcePlay(Source);
-      }
+      if (!QueueBuffer(firstFreeIndex)) break;
     }
   }
 
@@ -149,18 +147,32 @@ void OpenALAudioChannel::UpdatePlayback() {
   ALenum alState;
   alGetSourcei(Source, AL_SOURCE_STATE, &alState);
 
+  ALint queuedBuffers;
+  alGetSourcei(Source, AL_BUFFERS_QUEUED, &queuedBuffers);
+
   // Stop playback when OpenAL finished processing the whole stream
-  if (alState == AL_STOPPED && PlaybackStarted) {
+  if (Decoder && Decoder->Drained() &&
+      (queuedBuffers == 0 || (alState == AL_STOPPED && PlaybackStarted))) {
     EndPlayback();
     return;
   }
 
+  if (alState == AL_STOPPED && PlaybackStarted) {
+    // It ran dry before the decoder could keep up, restart playback below
+    // once there is something queued again
+    ChannelStats[Id].Underruns++;
+    ImpLog(LogLevel::Error, LogChannel::Audio,
+           "Buffer underrun on channel {:d}\n", Id);
+    PlaybackStarted = false;
+  }
+
   // Only propogate the latest state to OpenAL
   // when the audio channel is updated to avoid "blips"
   // when multiple state changes occur in one frame
   if (alState != AL_PAUSED && State == ACS_Paused) {
     alSourcePause(Source);
-  } else if (alState != AL_PLAYING &&
+  } else if ((alState != AL_PLAYING || !PlaybackStarted) &&
+             queuedBuffers > 0 &&
              (State == ACS_Playing || State == ACS_FadingIn ||
               State == ACS_FadingOut)) {
     alSourcePlay(Source);
@@ -204,37 +216,23 @@ bool OpenALAudioChannel::CanQueueBuffer() {
 
   if (queuedBuffers >= AudioBuffers.size()) return false;
 
-  return Looping || Stream->ReadPosition < Stream->Duration;
+  return !Decoder->Drained();
 }
 
-void OpenALAudioChannel::QueueBuffer(size_t bufferIndex) {
-  BufferStartPositions[bufferIndex] = Stream->ReadPosition;
-
-  int maxSamples = AudioBufferSize / Stream->BytesPerSample();
-  int samplesRead = 0;
-
-  while (samplesRead < maxSamples && Stream->ReadPosition < Stream->Duration) {
-    int end = Looping ? Stream->LoopEnd : Stream->Duration;
-    int samplesToRead =
-        std::min(maxSamples - samplesRead, end - Stream->ReadPosition);
-
-    uint8_t* dest = &HostBuffer[samplesRead * Stream->BytesPerSample()];
-    int samplesReadThisIteration = Stream->Read(dest, samplesToRead);
-    samplesRead += samplesReadThisIteration;
+// Returns false if the decoder has nothing ready yet
+bool OpenALAudioChannel::QueueBuffer(size_t bufferIndex) {
+  BufferStartPositions[bufferIndex] = Decoder->ConsumedPosition();
 
-    if (Looping && Stream->ReadPosition >= Stream->LoopEnd) {
-      Stream->Seek(Stream->LoopStart);
-    }
-
-    if (samplesReadThisIteration == 0) break;
-  }
+  size_t bytesRead = Decoder->Read(HostBuffer.data(), HostBuffer.size());
+  if (bytesRead == 0) return false;
 
   ALuint buffer = AudioBuffers[bufferIndex];
   ALenum format = ToALFormat(Stream->ChannelCount, Stream->BitDepth);
 
-  alBufferData(buffer, format, HostBuffer.data(),
-               samplesRead * Stream->BytesPerSample(), Stream->SampleRate);
+  alBufferData(buffer, format, HostBuffer.data(), (ALsizei)bytesRead,
+               Stream->SampleRate);
   alSourceQueueBuffers(Source, 1, &buffer);
+  return true;
 }
 
 }  // namespace OpenAL
@@ -2,6 +2,7 @@
 
 #include "audiocommon.h"
 #include "../audiochannel.h"
+#include "../audiostreamer.h"
 
 namespace Impacto {
 namespace Audio {
@@ -31,6 +32,8 @@ class OpenALAudioChannel : public Audio::AudioChannel {
   std::array<size_t, AudioBufferCount> BufferStartPositions;
   std::vector<uint8_t> HostBuffer;
 
+  std::shared_ptr<StreamDecoder> Decoder;
+
   size_t FirstQueuedBufferIndex = 0;
   bool PlaybackStarted = false;
 
@@ -42,7 +45,7 @@ class OpenALAudioChannel : public Audio::AudioChannel {
   void UpdateFade(float dt);
   void UnqueueBuffers(size_t amount);
   bool CanQueueBuffer();
-  void QueueBuffer(size_t bufferIndex);
+  bool QueueBuffer(size_t bufferIndex);
   void UpdatePlayback();
 };
 
@@ -0,0 +1,94 @@
+#include "pcmaudiostream.h"
+#include "../log.h"
+
+#include <algorithm>
+
+using namespace Impacto::Io;
+
+namespace Impacto {
+namespace Audio {
+
+AudioStream* PcmAudioStream::Create(Stream* stream) {
+  PcmAudioStream* result = 0;
+  PcmClipHeader header;
+
+  if (ReadBE<uint32_t>(stream) != PcmClipHeader::Magic) goto fail;
+  if (ReadU8(stream) != PcmClipHeader::Version) {
+    ImpLog(LogLevel::Error, LogChannel::Audio,
+           "Unsupported PCM clip version\n");
+    goto fail;
+  }
+
+  header.ChannelCount = ReadU8(stream);
+  header.BitDepth = ReadU8(stream);
+  ReadU8(stream);
+  header.SampleRate = ReadLE<uint32_t>(stream);
+  header.Start = ReadLE<uint32_t>(stream);
+  header.Duration = ReadLE<uint32_t>(stream);
+  header.LoopStart = ReadLE<uint32_t>(stream);
+  header.LoopEnd = ReadLE<uint32_t>(stream);
+
+  if ((header.ChannelCount != 1 && header.ChannelCount != 2) ||
+      (header.BitDepth != 16 && header.BitDepth != 32) ||
+      header.Start > header.Duration) {
+    ImpLog(LogLevel::Error, LogChannel::Audio,
+           "Unsupported PCM clip with {:d} channels, {:d} bits\n",
+           header.ChannelCount, header.BitDepth);
+    goto fail;
+  }
+
+  result = new PcmAudioStream;
+  result->BaseStream = stream;
+  result->ChannelCount = header.ChannelCount;
+  result->BitDepth = header.BitDepth;
+  result->SampleRate = header.SampleRate;
+  result->Duration = header.Duration;
+  result->LoopStart = header.LoopStart;
+  result->LoopEnd = header.LoopEnd;
+  result->Start = header.Start;
+  result->ReadPosition = header.Start;
+  result->StreamDataOffset = PcmClipHeader::Size;
+
+  return result;
+
+fail:
+  stream->Seek(0, RW_SEEK_SET);
+  return 0;
+}
+
+int PcmAudioStream::Read(void* buffer, int samples) {
+  samples = std::min(samples, Duration - ReadPosition);
+  if (samples <= 0) return 0;
+
+  const int read =
+      (int)(BaseStream->Read(buffer, (int64_t)samples * BytesPerSample()) /
+            BytesPerSample());
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+  if (BitDepth == 16) {
+    int16_t* out = (int16_t*)buffer;
+    for (int i = 0; i < read * ChannelCount; i++) out[i] = SDL_SwapLE16(out[i]);
+  } else {
+    float* out = (float*)buffer;
+    for (int i = 0; i < read * ChannelCount; i++) {
+      out[i] = SDL_SwapFloatLE(out[i]);
+    }
+  }
+#endif
+
+  ReadPosition += read;
+  return read;
+}
+
+void PcmAudioStream::Seek(int samples) {
+  ReadPosition = std::clamp(samples, Start, Duration);
+  BaseStream->Seek(
+      StreamDataOffset + (int64_t)(ReadPosition - Start) * BytesPerSample(),
+      RW_SEEK_SET);
+}
+
+bool PcmAudioStream::_registered =
+    AudioStream::AddAudioStreamCreator(&PcmAudioStream::Create);
+
+}  // namespace Audio
+}  // namespace Impacto
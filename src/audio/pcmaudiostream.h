@@ -0,0 +1,45 @@
+#pragma once
+
+#include "audiostream.h"
+#include "../impacto.h"
+
+namespace Impacto {
+namespace Audio {
+
+// Header of the raw PCM clips written by the audiotranscode tool. All fields
+// are little endian, interleaved samples follow right after.
+struct PcmClipHeader {
+  static uint32_t constexpr Magic = 0x4950434Du;  // "IPCM"
+  static uint8_t constexpr Version = 1;
+  static int constexpr Size = 28;
+
+  uint8_t ChannelCount;
+  uint8_t BitDepth;
+  uint32_t SampleRate;
+  // Samples before Start are not stored, streams begin at Start (usually the
+  // source codec's encoder delay)
+  uint32_t Start;
+  uint32_t Duration;
+  uint32_t LoopStart;
+  uint32_t LoopEnd;
+};
+
+// Plays pre-decoded clips straight off the base stream, so any position is a
+// seek away and decoding is a copy
+class PcmAudioStream : public AudioStream {
+ public:
+  int Read(void* buffer, int samples) override;
+  void Seek(int samples) override;
+
+ private:
+  static AudioStream* Create(Io::Stream* stream);
+  PcmAudioStream() {}
+
+  int Start;
+  int StreamDataOffset;
+
+  static bool _registered;
+};
+
+}  // namespace Audio
+}  // namespace Impacto
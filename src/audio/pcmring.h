@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace Impacto {
+namespace Audio {
+
+// Single producer, single consumer ring of decoded PCM. One thread may write
+// while another reads without locking. Both the capacity and every read and
+// write are whole samples, so a writable or readable region never ends in the
+// middle of one.
+class PcmRing {
+ public:
+  PcmRing(size_t capacitySamples, size_t bytesPerSample)
+      : Data(capacitySamples * bytesPerSample),
+        BytesPerSample(bytesPerSample) {}
+
+  size_t Capacity() const { return Data.size(); }
+
+  // Consumer side
+  size_t BytesAvailable() const {
+    return WriteHead.load(std::memory_order_acquire) -
+           ReadHead.load(std::memory_order_relaxed);
+  }
+
+  size_t Read(void* dest, size_t bytes) {
+    const size_t readHead = ReadHead.load(std::memory_order_relaxed);
+    const size_t available =
+        WriteHead.load(std::memory_order_acquire) - readHead;
+    bytes = std::min(bytes, available);
+    bytes -= bytes % BytesPerSample;
+
+    const size_t offset = readHead % Data.size();
+    const size_t firstPart = std::min(bytes, Data.size() - offset);
+    memcpy(dest, Data.data() + offset, firstPart);
+    memcpy((uint8_t*)dest + firstPart, Data.data(), bytes - firstPart);
+
+    ReadHead.store(readHead + bytes, std::memory_order_release);
+    return bytes;
+  }
+
+  // Producer side. Returns the contiguous free region at the write head,
+  // which may be smaller than the total free space when it wraps around.
+  std::span<uint8_t> WritableRegion() {
+    const size_t writeHead = WriteHead.load(std::memory_order_relaxed);
+    const size_t used = writeHead - ReadHead.load(std::memory_order_acquire);
+    const size_t offset = writeHead % Data.size();
+    const size_t size = std::min(Data.size() - used, Data.size() - offset);
+    return std::span(Data.data() + offset, size);
+  }
+
+  void CommitWrite(size_t bytes) {
+    WriteHead.store(WriteHead.load(std::memory_order_relaxed) + bytes,
+                    std::memory_order_release);
+  }
+
+ private:
+  std::vector<uint8_t> Data;
+  size_t BytesPerSample;
+
+  // Total bytes ever written/read, only ever advanced by their own side
+  std::atomic<size_t> WriteHead = 0;
+  std::atomic<size_t> ReadHead = 0;
+};
+
+}  // namespace Audio
+}  // namespace Impacto
@@ -0,0 +1,216 @@
+#include "voiceprefetch.h"
+
+#include "../io/vfs.h"
+#include "../log.h"
+#include "../workqueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace Impacto {
+namespace Audio {
+namespace VoicePrefetch {
+
+using Clock = std::chrono::steady_clock;
+
+static int Depth = 0;
+static float PrerollDuration = 0.0f;
+// Bumped on shutdown so jobs still in flight get thrown away
+static uint32_t Generation = 0;
+
+static uint64_t Hits = 0;
+static uint64_t Misses = 0;
+static float LastOpenMs = 0.0f;
+// Written from the streaming thread
+static std::atomic<float> LastFirstSampleMs = 0.0f;
+static std::atomic<float> AverageFirstSampleMs = 0.0f;
+
+static void RecordFirstSample(Clock::time_point openTime) {
+  const float latencyMs = std::chrono::duration<float, std::milli>(
+                              Clock::now() - openTime)
+                              .count();
+  LastFirstSampleMs = latencyMs;
+  AverageFirstSampleMs = AverageFirstSampleMs * 0.9f + latencyMs * 0.1f;
+}
+
+// Serves the samples decoded while prefetching before continuing with the
+// stream they were decoded from
+class PrerolledAudioStream : public AudioStream {
+ public:
+  PrerolledAudioStream(std::unique_ptr<AudioStream> inner, int samples)
+      : Inner(std::move(inner)) {
+    ChannelCount = Inner->ChannelCount;
+    SampleRate = Inner->SampleRate;
+    BitDepth = Inner->BitDepth;
+    LoopStart = Inner->LoopStart;
+    LoopEnd = Inner->LoopEnd;
+    Duration = Inner->Duration;
+    ReadPosition = Inner->ReadPosition;
+
+    HeadStart = Inner->ReadPosition;
+    Head.resize((size_t)samples * BytesPerSample());
+    HeadEnd = HeadStart + Inner->Read(Head.data(), samples);
+  }
+
+  int Read(void* buffer, int samples) override {
+    if (!FirstSampleRecorded) {
+      RecordFirstSample(OpenTime);
+      FirstSampleRecorded = true;
+    }
+
+    uint8_t* out = (uint8_t*)buffer;
+    int read = 0;
+    if (ReadPosition >= HeadStart && ReadPosition < HeadEnd) {
+      read = std::min(samples, HeadEnd - ReadPosition);
+      memcpy(out, Head.data() + (size_t)(ReadPosition - HeadStart) *
+                                    BytesPerSample(),
+             (size_t)read * BytesPerSample());
+      ReadPosition += read;
+    }
+    if (read < samples) {
+      if (Inner->ReadPosition != ReadPosition) Inner->Seek(ReadPosition);
+      const int innerRead = Inner->Read(out + (size_t)read * BytesPerSample(),
+                                        samples - read);
+      ReadPosition += innerRead;
+      read += innerRead;
+    }
+    return read;
+  }
+
+  void Seek(int samples) override { ReadPosition = samples; }
+
+  const Io::Stream* GetBaseStream() const override {
+    return Inner->GetBaseStream();
+  }
+
+  Clock::time_point OpenTime;
+
+ private:
+  std::unique_ptr<AudioStream> Inner;
+  std::vector<uint8_t> Head;
+  int HeadStart;
+  int HeadEnd;
+  bool FirstSampleRecorded = false;
+};
+
+struct PrefetchJob {
+  uint32_t VoiceId;
+  uint32_t Generation;
+  std::unique_ptr<PrerolledAudioStream> Result;
+};
+
+// Keyed by voice ID, a null stream means it's still being prefetched
+static std::map<uint32_t, std::unique_ptr<PrerolledAudioStream>> Prefetched;
+
+static std::unique_ptr<AudioStream> OpenStream(uint32_t voiceId) {
+  Io::Stream* stream;
+  IoError err = Io::VfsOpen("voice", voiceId, &stream);
+  if (err != IoError_OK) return nullptr;
+
+  std::unique_ptr<AudioStream> audioStream(AudioStream::Create(stream));
+  if (!audioStream) delete stream;
+  return audioStream;
+}
+
+static void PrefetchWorker(void* ptr) {
+  PrefetchJob* job = (PrefetchJob*)ptr;
+  std::unique_ptr<AudioStream> stream = OpenStream(job->VoiceId);
+  if (!stream) return;
+
+  const int prerollSamples = (int)(PrerollDuration * stream->SampleRate);
+  job->Result = std::make_unique<PrerolledAudioStream>(std::move(stream),
+                                                       prerollSamples);
+}
+
+static void OnPrefetched(void* ptr) {
+  PrefetchJob* job = (PrefetchJob*)ptr;
+  if (job->Generation == Generation) {
+    auto it = Prefetched.find(job->VoiceId);
+    // Otherwise it was played or fell out of the window before it was ready
+    if (it != Prefetched.end() && !it->second) {
+      if (job->Result) {
+        it->second = std::move(job->Result);
+      } else {
+        Prefetched.erase(it);
+      }
+    }
+  }
+  delete job;
+}
+
+static void PrefetchFollowing(uint32_t voiceId) {
+  // Voice files are numbered in script order, so the next lines' voices
+  // are most likely the next few IDs
+  const uint32_t first = voiceId + 1;
+  const uint32_t last = voiceId + (uint32_t)Depth;
+  for (auto it = Prefetched.begin(); it != Prefetched.end();) {
+    if (it->first < first || it->first > last) {
+      it = Prefetched.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  for (uint32_t id = first; id <= last; id++) {
+    if (Prefetched.contains(id)) continue;
+    Prefetched[id] = nullptr;
+    WorkQueue::Push(new PrefetchJob{id, Generation, nullptr},
+                    &PrefetchWorker, &OnPrefetched);
+  }
+}
+
+void Init(int depth, float prerollDuration) {
+  Depth = depth;
+  PrerollDuration = prerollDuration;
+}
+
+void Shutdown() {
+  Prefetched.clear();
+  Depth = 0;
+  Generation++;
+}
+
+std::unique_ptr<AudioStream> Open(uint32_t voiceId) {
+  const auto startTime = Clock::now();
+
+  std::unique_ptr<PrerolledAudioStream> result;
+  auto it = Prefetched.find(voiceId);
+  if (it != Prefetched.end() && it->second) {
+    result = std::move(it->second);
+    Prefetched.erase(it);
+    Hits++;
+  } else {
+    // Wrapped all the same so cold starts show up in the latency stats
+    std::unique_ptr<AudioStream> stream = OpenStream(voiceId);
+    if (stream) {
+      result = std::make_unique<PrerolledAudioStream>(std::move(stream), 0);
+    }
+    Misses++;
+  }
+  if (result) result->OpenTime = startTime;
+
+  if (Depth > 0) PrefetchFollowing(voiceId);
+
+  LastOpenMs = std::chrono::duration<float, std::milli>(Clock::now() -
+                                                        startTime)
+                   .count();
+  return result;
+}
+
+PrefetchStats GetStats() {
+  return PrefetchStats{
+      .Hits = Hits,
+      .Misses = Misses,
+      .LastOpenMs = LastOpenMs,
+      .LastFirstSampleMs = LastFirstSampleMs,
+      .AverageFirstSampleMs = AverageFirstSampleMs,
+  };
+}
+
+}  // namespace VoicePrefetch
+}  // namespace Audio
+}  // namespace Impacto
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "audiostream.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace Impacto {
+namespace Audio {
+namespace VoicePrefetch {
+
+// Opens the voice files following the one last played in the background and
+// decodes their first few hundred milliseconds, so the next lines' voices are
+// ready to play the moment they appear
+void Init(int depth, float prerollDuration);
+void Shutdown();
+
+// Returns the voice's stream, warmed up if it was prefetched, and starts
+// prefetching the voices after it
+std::unique_ptr<AudioStream> Open(uint32_t voiceId);
+
+struct PrefetchStats {
+  uint64_t Hits = 0;
+  uint64_t Misses = 0;
+  // Main thread time spent in the last Open
+  float LastOpenMs = 0.0f;
+  // From Open until the stream's first samples were read for playback
+  float LastFirstSampleMs = 0.0f;
+  float AverageFirstSampleMs = 0.0f;
+};
+PrefetchStats GetStats();
+
+}  // namespace VoicePrefetch
+}  // namespace Audio
+}  // namespace Impacto
@@ -11,8 +11,20 @@
 #include "io/vfs.h"
 #include "background2d.h"
 #include "character2d.h"
+#include "text.h"
+#include "textlayoutcache.h"
 #include "profile/sprites.h"
 #include "profile/vm.h"
+#include "ui/ui.h"
+#include "ui/widgets/group.h"
+#include "audio/audiosystem.h"
+#include "audio/audiostreamer.h"
+#include "audio/audiocache.h"
+#include "audio/voiceprefetch.h"
+#include "audio/mixer/mixer.h"
+#include "renderer/yuvframe.h"
+#include "video/videoplayer.h"
+#include "video/videosystem.h"
 
 namespace Impacto {
 namespace DebugMenu {
@@ -30,6 +42,7 @@ static std::map<uint32_t, std::vector<std::string>> ScriptDebugSource;
 static bool ScriptVariablesEditorShown = false;
 static bool ObjectViewerShown = false;
 static bool UiViewerShown = false;
+static bool AudioViewerShown = false;
 static bool ScriptDebuggerShown = false;
 
 static void HelpMarker(const char* desc) {
@@ -118,12 +131,67 @@ static void ParseScriptDebugData(uint32_t scriptId) {
   delete stream;
 }
 
+static void ShowSimulationSpeed() {
+  ImGui::SliderFloat("Simulation speed", &Game::SimulationSpeed, 1.0f, 16.0f,
+                     "%.1fx", ImGuiSliderFlags_Logarithmic);
+  ImGui::SameLine();
+  HelpMarker("Fast-forwards the scripts, only the last tick of every frame "
+             "gets rendered");
+}
+
+static void ShowVideoStats() {
+  const YUVFrameUploadStats& stats = VideoUploadStats;
+  if (stats.Uploads == 0) return;
+
+  ImGui::Text("Video upload: %.3f ms (average %.3f ms, peak %.3f ms)",
+              stats.LastUploadMs, stats.AverageUploadMs, stats.PeakUploadMs);
+  ImGui::SameLine();
+  if (ImGui::SmallButton("Reset##VideoUploadStats")) VideoUploadStats.Reset();
+
+  // Sampled over one second windows
+  static double lastSampleTime = 0.0;
+  static uint64_t lastBytesRead = 0;
+  static float bytesPerSecond = 0.0f;
+  const double time = ImGui::GetTime();
+  if (time - lastSampleTime >= 1.0) {
+    const uint64_t bytesRead = Video::DemuxerIoStats.BytesRead;
+    bytesPerSecond = (float)((bytesRead - lastBytesRead) /
+                             (time - lastSampleTime));
+    lastSampleTime = time;
+    lastBytesRead = bytesRead;
+  }
+  const Video::VideoFrameStats& frameStats = Video::FrameStats;
+  ImGui::Text("Frames: %llu shown, %llu late, %llu dropped, skip level %d",
+              (unsigned long long)frameStats.Shown,
+              (unsigned long long)frameStats.Late,
+              (unsigned long long)frameStats.Dropped, frameStats.SkipLevel);
+  ImGui::SameLine();
+  if (ImGui::SmallButton("Reset##VideoFrameStats")) Video::FrameStats.Reset();
+  ImGui::Text("Time to first frame: %.2f ms (%s)",
+              Video::LastVideoStart.TimeToFirstFrameMs,
+              Video::LastVideoStart.Prepared ? "prepared" : "cold start");
+  ImGui::Text("Video IO: %.2f MiB/s copied %s",
+              bytesPerSecond / (1024.0f * 1024.0f),
+              Video::DemuxerIoStats.DirectFromMemory ? "straight from memory"
+                                                     : "through streams");
+  for (int i = 0; i < Video::VP_Count; i++) {
+    if (!Video::Players[i]) continue;
+    const Video::VideoMemoryStats memory = Video::Players[i]->GetMemoryStats();
+    ImGui::Text("Player %d queues: %.2f MiB (peak %.2f MiB, budget %.2f MiB)",
+                i, memory.QueuedBytes / (1024.0f * 1024.0f),
+                memory.PeakQueuedBytes / (1024.0f * 1024.0f),
+                memory.BudgetBytes / (1024.0f * 1024.0f));
+  }
+}
+
 void ShowSingleWindow() {
   if (ImGui::Begin("Debug Menu", &DebugMenuShown)) {
     ImGui::Text("%.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate,
                 ImGui::GetIO().Framerate);
     ImGui::Text("Cursor Pos: (%.1f,%.1f)", ImGui::GetIO().MousePos.x,
                 ImGui::GetIO().MousePos.y);
+    ShowSimulationSpeed();
+    ShowVideoStats();
 
     if (ImGui::BeginTabBar("DebugTabBar", ImGuiTabBarFlags_None)) {
       if (ImGui::BeginTabItem("\"Debug Editer\"")) {
@@ -135,6 +203,11 @@ void ShowSingleWindow() {
         ImGui::EndTabItem();
       }
       if (ImGui::BeginTabItem("UI")) {
+        ShowUI();
+        ImGui::EndTabItem();
+      }
+      if (ImGui::BeginTabItem("Audio")) {
+        ShowAudio();
         ImGui::EndTabItem();
       }
       if (ImGui::BeginTabItem("Script Debugger")) {
@@ -156,6 +229,7 @@ void ShowDockableArea() {
         ImGui::MenuItem("\"Debug Editer\"", NULL, &ScriptVariablesEditorShown);
         ImGui::MenuItem("Objects", NULL, &ObjectViewerShown);
         ImGui::MenuItem("UI", NULL, &UiViewerShown);
+        ImGui::MenuItem("Audio", NULL, &AudioViewerShown);
         ImGui::MenuItem("Script Debugger", NULL, &ScriptDebuggerShown);
         ImGui::EndMenu();
       }
@@ -164,6 +238,8 @@ void ShowDockableArea() {
 
     ImGui::Text("%.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate,
                 ImGui::GetIO().Framerate);
+    ShowSimulationSpeed();
+    ShowVideoStats();
   }
   ImGui::End();
 
@@ -184,7 +260,14 @@ void ShowDockableArea() {
 
   if (UiViewerShown) {
     if (ImGui::Begin("UI##UIViewerWindow"), &UiViewerShown) {
-      ImGui::Text("Not available");
+      ShowUI();
+    }
+    ImGui::End();
+  }
+
+  if (AudioViewerShown) {
+    if (ImGui::Begin("Audio##AudioViewerWindow"), &AudioViewerShown) {
+      ShowAudio();
     }
     ImGui::End();
   }
@@ -201,6 +284,7 @@ void ShowDockableArea() {
     ScriptVariablesEditorShown = false;
     ObjectViewerShown = false;
     UiViewerShown = false;
+    AudioViewerShown = false;
     ScriptDebuggerShown = false;
   }
 }
@@ -929,5 +1013,174 @@ void ShowObjects() {
   ImGui::PopItemWidth();
 }
 
+void ShowUI() {
+  const std::pair<const char*, UI::Menu*> menus[] = {
+      {"System menu", UI::SystemMenuPtr},
+      {"Title menu", UI::TitleMenuPtr},
+      {"Trophy menu", UI::TrophyMenuPtr},
+      {"Help menu", UI::HelpMenuPtr},
+      {"Save menu", UI::SaveMenuPtr},
+      {"Selection menu", UI::SelectionMenuPtr},
+      {"SysMesBox", UI::SysMesBoxPtr},
+      {"Backlog menu", UI::BacklogMenuPtr},
+      {"Tips menu", UI::TipsMenuPtr},
+      {"Options menu", UI::OptionsMenuPtr},
+      {"Library menu", UI::LibraryMenuPtr},
+      {"Clear list menu", UI::ClearListMenuPtr},
+      {"Album menu", UI::AlbumMenuPtr},
+      {"Music menu", UI::MusicMenuPtr},
+      {"Movie menu", UI::MovieMenuPtr},
+      {"Actors voice menu", UI::ActorsVoiceMenuPtr},
+  };
+
+  ImGui::SeparatorText("Menu render times (CPU):");
+  if (ImGui::Button("Reset peaks")) {
+    for (const auto& [name, menu] : menus) {
+      if (menu) menu->PeakRenderTime = 0.0f;
+    }
+  }
+
+  if (ImGui::BeginTable("tableMenuRenderTimes", 3,
+                        ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+    ImGui::TableSetupColumn("Menu");
+    ImGui::TableSetupColumn("Average (ms)");
+    ImGui::TableSetupColumn("Peak (ms)");
+    ImGui::TableHeadersRow();
+
+    for (const auto& [name, menu] : menus) {
+      if (!menu) continue;
+
+      ImGui::BeginDisabled(menu->State == UI::Hidden);
+      ImGui::TableNextColumn();
+      ImGui::Text("%s", name);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", menu->RenderTime);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", menu->PeakRenderTime);
+      ImGui::EndDisabled();
+    }
+
+    ImGui::EndTable();
+  }
+
+  const TextLayoutCache::CacheStats layoutStats = TextLayoutCache::GetStats();
+  const uint64_t layoutLookups = layoutStats.Hits + layoutStats.Misses;
+  ImGui::SeparatorText("Text layout cache:");
+  ImGui::Text("%zu lines, %zu glyphs, flushed %llu times", layoutStats.Entries,
+              layoutStats.Glyphs, (unsigned long long)layoutStats.Flushes);
+  ImGui::Text("%llu hits, %llu misses (%.1f%% hit rate)",
+              (unsigned long long)layoutStats.Hits,
+              (unsigned long long)layoutStats.Misses,
+              layoutLookups ? 100.0 * layoutStats.Hits / layoutLookups : 0.0);
+
+  ImGui::SeparatorText("Text layout benchmark:");
+  HelpMarker("Lays out every string of the loaded scripts");
+  static TextLayoutBenchmarkResult advResult, nvlResult;
+  if (ImGui::Button("Run")) {
+    advResult = TextBenchmarkLayout(DPM_ADV);
+    nvlResult = TextBenchmarkLayout(DPM_NVL);
+  }
+  for (const auto& [name, result] :
+       {std::pair{"ADV", advResult}, std::pair{"NVL", nvlResult}}) {
+    if (result.Lines == 0) continue;
+    ImGui::Text("%s: %d lines, %lld glyphs in %.2f ms (%.0f lines/s)", name,
+                result.Lines, (long long)result.Glyphs, result.Seconds * 1000.0,
+                result.Lines / result.Seconds);
+  }
+
+  ImGui::SeparatorText("Widget group benchmark:");
+  HelpMarker(
+      "Updates, hit-tests and culls a scrolling group of 10000 idle buttons");
+  static UI::Widgets::GroupBenchmarkResult linearResult, indexedResult;
+  if (ImGui::Button("Run##groupBenchmark")) {
+    linearResult = UI::Widgets::BenchmarkGroup(10000, false);
+    indexedResult = UI::Widgets::BenchmarkGroup(10000, true);
+  }
+  for (const auto& [name, result] :
+       {std::pair{"Linear", linearResult},
+        std::pair{"Spatial index", indexedResult}}) {
+    if (result.Frames == 0) continue;
+    ImGui::Text("%s: %.3f ms per frame, %d children visible", name,
+                result.Seconds * 1000.0 / result.Frames,
+                result.VisibleChildren);
+  }
+}
+
+void ShowAudio() {
+  static const char* const channelNames[Audio::AC_Count] = {
+      "SE0", "SE1",  "SE2",  "VOICE0", "VOICE1", "VOICE2",
+      "REV", "BGM0", "BGM1", "BGM2",   "SSE"};
+
+  ImGui::SeparatorText("Channel streaming:");
+  if (ImGui::Button("Reset counters")) {
+    for (auto& stats : Audio::ChannelStats) stats.Reset();
+  }
+
+  if (ImGui::BeginTable("tableAudioChannels", 6,
+                        ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+    ImGui::TableSetupColumn("Channel");
+    ImGui::TableSetupColumn("State");
+    ImGui::TableSetupColumn("Underruns");
+    ImGui::TableSetupColumn("Decode time (ms)");
+    ImGui::TableSetupColumn("Peak read (ms)");
+    ImGui::TableSetupColumn("us/1k samples");
+    ImGui::TableHeadersRow();
+
+    for (int i = 0; i < Audio::AC_Count; i++) {
+      const Audio::AudioChannelStats& stats = Audio::ChannelStats[i];
+      const uint64_t decodedSamples = stats.DecodedSamples;
+      const uint64_t decodeTimeUs = stats.DecodeTimeUs;
+
+      ImGui::TableNextColumn();
+      ImGui::Text("%s", channelNames[i]);
+      ImGui::TableNextColumn();
+      if (Audio::Channels[i]) {
+        ImGui::Text("%s",
+                    fmt::format("{}", Audio::Channels[i]->GetState()).c_str());
+      }
+      ImGui::TableNextColumn();
+      ImGui::Text("%u", stats.Underruns.load());
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", decodeTimeUs / 1000.0f);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", stats.PeakDecodeTimeUs / 1000.0f);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f", decodedSamples == 0 ? 0.0f
+                                              : decodeTimeUs * 1000.0f /
+                                                    decodedSamples);
+    }
+
+    ImGui::EndTable();
+  }
+
+  const Audio::AudioCache::CacheStats cacheStats =
+      Audio::AudioCache::GetStats();
+  ImGui::SeparatorText("Decoded sound effect cache:");
+  ImGui::Text("%zu clips, %.2f of %.2f MiB", cacheStats.Entries,
+              cacheStats.Bytes / (1024.0f * 1024.0f),
+              cacheStats.BudgetBytes / (1024.0f * 1024.0f));
+  ImGui::Text("%llu hits, %llu misses", (unsigned long long)cacheStats.Hits,
+              (unsigned long long)cacheStats.Misses);
+
+  const Audio::VoicePrefetch::PrefetchStats prefetchStats =
+      Audio::VoicePrefetch::GetStats();
+  ImGui::SeparatorText("Voice prefetching:");
+  ImGui::Text("%llu hits, %llu misses", (unsigned long long)prefetchStats.Hits,
+              (unsigned long long)prefetchStats.Misses);
+  ImGui::Text("Last open: %.3f ms", prefetchStats.LastOpenMs);
+  ImGui::Text("Time to first sample: %.3f ms (average %.3f ms)",
+              prefetchStats.LastFirstSampleMs,
+              prefetchStats.AverageFirstSampleMs);
+
+  if (Audio::Mixer::MainMixer) {
+    Audio::Mixer::AudioMixer& mixer = *Audio::Mixer::MainMixer;
+    ImGui::SeparatorText("Software mixer:");
+    ImGui::Text("Output rate: %d Hz", mixer.GetOutputRate());
+    ImGui::Text("Mix cost: %.2f us/ms (peak %.2f us/ms)", mixer.GetMixCostUs(),
+                mixer.GetPeakMixCostUs());
+    if (ImGui::Button("Reset peak")) mixer.ResetPeakMixCost();
+  }
+}
+
 }  // namespace DebugMenu
 }  // namespace Impacto
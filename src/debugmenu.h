@@ -20,6 +20,8 @@ void ShowSingleWindow();
 void ShowScriptVariablesEditor();
 void ShowScriptDebugger();
 void ShowObjects();
+void ShowUI();
+void ShowAudio();
 
 }  // namespace DebugMenu
 }  // namespace Impacto
@@ -5,7 +5,7 @@
 
 namespace Impacto {
 
-BETTER_ENUM(FontType, int, Basic, LB)
+BETTER_ENUM(FontType, int, Basic, LB, SDF)
 
 class Font {
  public:
@@ -92,4 +92,46 @@ class LBFont : public Font {
   }
 };
 
+// Single channel signed distance field generated from a basic font's sheet by
+// the sdfgen tool. Every cell is padded by Spread on all sides and stores the
+// distance to the glyph's edge in alpha, 0.5 on the edge and 0 (outside) or 1
+// (inside) Spread bitmap pixels away from it. The field scales to any size
+// and the outline is just another threshold, so fill and outline come from a
+// single quad per glyph.
+class SDFFont : public Font {
+ public:
+  SDFFont() : Font(FontType::SDF) {}
+
+  SpriteSheet Sheet;
+
+  // In bitmap pixels, like the metrics of the font the field was made from
+  float Spread;
+  float OutlineWidth;
+  glm::vec2 ShadowOffset;
+
+  float PaddedCellHeight;
+  float PaddedCellWidth;
+
+  void CalculateDefaultSizes() override {
+    PaddedCellHeight = Sheet.DesignHeight / (float)Rows;
+    PaddedCellWidth = Sheet.DesignWidth / (float)Columns;
+    CellHeight = PaddedCellHeight - 2.0f * Spread;
+    CellWidth = PaddedCellWidth - 2.0f * Spread;
+  }
+
+  // Distance value of the outline's outer edge
+  float OutlineEdge() const { return 0.5f - OutlineWidth / (2.0f * Spread); }
+
+  Sprite Glyph(uint8_t row, uint8_t col) { return Glyph(row * Columns + col); }
+
+  // Includes the padding, i.e. the glyph's origin is Spread pixels inside
+  Sprite Glyph(uint16_t id) {
+    uint8_t row = (uint8_t)(id / Columns);
+    uint8_t col = id % Columns;
+    return Sprite(Sheet, col * PaddedCellWidth, row * PaddedCellHeight,
+                  AdvanceWidths[id] + 2.0f * Spread,
+                  BitmapEmHeight + 2.0f * Spread);
+  }
+};
+
 }  // namespace Impacto
\ No newline at end of file
@@ -55,6 +55,10 @@
 #include "profile/ui/helpmenu.h"
 #include "profile/data/bgeff.h"
 
+#include <bit>
+#include <cmath>
+#include <vector>
+
 namespace Impacto {
 
 using namespace Profile::ScriptVars;
@@ -198,18 +202,12 @@ void UpdateGameState(float dt) {
   Vm::ChkMesSkip();
 }
 
-void UpdateSystem(float dt) {
-  static float UpdateSecondCounter = 0.0f;
-  UpdateSecondCounter += dt;
-  if (UpdateSecondCounter <= 1 / 60.0f) {
-    return;
-  }
+// Events polled since the last tick, for the next one to handle
+static std::vector<SDL_Event> PendingEvents;
 
+// Polled once per update, whether or not a tick runs in it
+static void PollEvents() {
   SDL_Event e;
-  if (Profile::GameFeatures & GameFeature::Input) {
-    Input::BeginFrame();
-  }
-
   while (SDL_PollEvent(&e)) {
     if (e.type == SDL_QUIT) {
       ShouldQuit = true;
@@ -222,40 +220,130 @@ void UpdateSystem(float dt) {
       continue;
 #endif
 
+    if (WorkQueue::HandleEvent(&e)) continue;
+
     if (Profile::GameFeatures & GameFeature::Input) {
-      if (Input::HandleEvent(&e)) continue;
+      PendingEvents.push_back(e);
     }
-
-    WorkQueue::HandleEvent(&e);
   }
+}
+
+static void RunTick() {
   if (Profile::GameFeatures & GameFeature::Input) {
+    Input::BeginFrame();
+    for (SDL_Event const& e : PendingEvents) Input::HandleEvent(&e);
     Input::EndFrame();
   }
+  PendingEvents.clear();
   if (Profile::GameFeatures & GameFeature::Sc3VirtualMachine) {
     Vm::Interface::UpdatePADInput();
-    UpdateGameState(UpdateSecondCounter);
+    UpdateGameState(TickDuration);
 
     for (DrawComponentType value : DrawComponentType::_values()) {
       for (auto const& menu : UI::Menus[value]) {
-        menu->Update(UpdateSecondCounter);
+        menu->Update(TickDuration);
       }
     }
 
-    SaveIconDisplay::Update(UpdateSecondCounter);
-    LoadingDisplay::Update(UpdateSecondCounter);
-    DateDisplay::Update(UpdateSecondCounter);
+    SaveIconDisplay::Update(TickDuration);
+    LoadingDisplay::Update(TickDuration);
+    DateDisplay::Update(TickDuration);
     if (ScrWork[SW_GAMESTATE] & 5 && !GetFlag(SF_GAMEPAUSE) &&
         !GetFlag(SF_SYSMENUDISABLE)) {
-      TipsNotification::Update(UpdateSecondCounter);
-      DelusionTrigger::Update(UpdateSecondCounter);
-      UI::MapSystem::Update(UpdateSecondCounter);
+      TipsNotification::Update(TickDuration);
+      DelusionTrigger::Update(TickDuration);
+      UI::MapSystem::Update(TickDuration);
       if (CCLCC::YesNoTrigger::YesNoTriggerPtr)
-        CCLCC::YesNoTrigger::YesNoTriggerPtr->Update(UpdateSecondCounter);
+        CCLCC::YesNoTrigger::YesNoTriggerPtr->Update(TickDuration);
     }
 
-    Vm::Update(dt);
+    Vm::Update(TickDuration);
+  }
+}
+
+static bool IsSkipping() {
+  return (Profile::GameFeatures & GameFeature::Sc3VirtualMachine) &&
+         (ScrWork[SW_GAMESTATE] & 0b101) == 0b001 && GetFlag(SF_MESALLSKIP);
+}
+
+// Set when the dialogue pages were already updated by skipped ticks
+static bool DialoguePagesTicked = false;
+
+static void RunSkipTick() {
+  RunTick();
+
+  // The VM only moves on to the next line once this one has typed out, which
+  // would otherwise only happen once per drawn frame
+  if (Profile::GameFeatures & GameFeature::Renderer2D) {
+    for (int i = 0; i < Profile::Dialogue::PageCount; i++)
+      DialoguePages[i].Update(TickDuration);
+    DialoguePagesTicked = true;
+  }
+}
+
+// Changes whenever a skipped tick got the VM or the dialogue pages anywhere
+static uint64_t SkipProgressState() {
+  uint64_t hash = 14695981039346656037ull;
+  auto mix = [&hash](uint64_t value) {
+    hash = (hash ^ value) * 1099511628211ull;
+  };
+
+  for (Vm::Sc3VmThread const& thread : Vm::ThreadPool) {
+    mix(thread.Flags);
+    mix(thread.ScriptBufferId);
+    mix(thread.IpOffset);
+    mix(thread.CallStackDepth);
+    mix(thread.WaitCounter);
+  }
+
+  if (Profile::GameFeatures & GameFeature::Renderer2D) {
+    for (int i = 0; i < Profile::Dialogue::PageCount; i++) {
+      DialoguePage const& page = DialoguePages[i];
+      mix(page.Length);
+      mix(page.Mode);
+      mix(std::bit_cast<uint32_t>(page.Typewriter.Progress));
+      mix(std::bit_cast<uint32_t>(page.FadeAnimation.Progress));
+    }
+  }
+
+  return hash;
+}
+
+void UpdateSystem(float dt) {
+  static float TickAccumulator = 0.0f;
+  DialoguePagesTicked = false;
+
+  PollEvents();
+
+  if (IsSkipping()) {
+    // Skipping goes as fast as the VM does, frames in between are never drawn
+    const uint64_t start = SDL_GetPerformanceCounter();
+    const uint64_t budget =
+        (uint64_t)(SkipRenderInterval * SDL_GetPerformanceFrequency());
+    do {
+      const uint64_t before = SkipProgressState();
+      RunSkipTick();
+      // Waiting on something only drawn frames move along (fades, movies,
+      // loads), more ticks would just spin until the budget runs out
+      if (SkipProgressState() == before) break;
+    } while (IsSkipping() && !ShouldQuit &&
+             SDL_GetPerformanceCounter() - start < budget);
+    TickAccumulator = 0.0f;
+    return;
+  }
+
+  TickAccumulator += dt * SimulationSpeed;
+
+  const int maxTicks = (int)std::ceil(MaxTicksPerUpdate * SimulationSpeed);
+  for (int ticks = 0; TickAccumulator >= TickDuration; ticks++) {
+    if (ticks == maxTicks) {
+      // Too far behind to catch up without stalling the next frames as well
+      TickAccumulator = std::fmod(TickAccumulator, TickDuration);
+      break;
+    }
+    TickAccumulator -= TickDuration;
+    RunTick();
   }
-  UpdateSecondCounter = 0.0f;
 }
 
 void Update(float dt) {
@@ -285,7 +373,8 @@ void Update(float dt) {
     Renderer->Scene->Update(dt);
   }
 
-  if (Profile::GameFeatures & GameFeature::Renderer2D) {
+  if ((Profile::GameFeatures & GameFeature::Renderer2D) &&
+      !DialoguePagesTicked) {
     for (int i = 0; i < Profile::Dialogue::PageCount; i++)
       DialoguePages[i].Update(dt);
   }
@@ -528,7 +617,14 @@ void Render() {
       }
 
       for (auto const& menu : UI::Menus[DrawComponents[i]]) {
+        if (menu->State == UI::Hidden) {
+          menu->Render();
+          continue;
+        }
+
+        const uint64_t renderStart = SDL_GetPerformanceCounter();
         menu->Render();
+        menu->RecordRenderTime(SDL_GetPerformanceCounter() - renderStart);
       }
     }
   }
@@ -21,7 +21,9 @@ BETTER_ENUM(GameFeature, int, DebugMenu = (1 << 0), Scene3D = (1 << 1),
 
 BETTER_ENUM(VideoPlayerType, int, None, FFmpeg);
 
-BETTER_ENUM(AudioBackendType, int, None, OpenAL);
+BETTER_ENUM(AudioBackendType, int, None, OpenAL, Mixer);
+
+BETTER_ENUM(AudioMixerSinkType, int, Device, Null, File);
 
 namespace Game {
 
@@ -38,6 +40,24 @@ void InitFromProfile(std::string const& name);
 
 void Shutdown();
 
+// Input, the scripts with their timers, and the menus run in fixed ticks at
+// the rate the games were made for, however often frames are rendered.
+// Everything else (audio, video, text fades, 3D) follows the frame's dt.
+// Events are polled every frame and handed to the next tick. Sprites are
+// drawn where the last tick left them, not interpolated between ticks.
+float constexpr TickDuration = 1.0f / 60.0f;
+// Past this many ticks in one update the simulation drops the time it is
+// behind by instead of catching up
+int constexpr MaxTicksPerUpdate = 8;
+// While skipping through the script, ticks run back to back and a frame is
+// only rendered this often (in seconds)
+float constexpr SkipRenderInterval = 1.0f / 30.0f;
+
+// Ticks run per tick's worth of real time. Only the state after the last tick
+// of an update is rendered, so raising this fast-forwards without drawing the
+// ticks in between.
+inline float SimulationSpeed = 1.0f;
+
 void Update(float dt);
 void Render();
 
@@ -25,6 +25,7 @@ class MusicTrackButton : public Widgets::Button {
 
   void Show() override;
   void Update(float dt) override;
+  bool NeedsUpdate() const override { return true; }
   void Render() override;
   void Move(glm::vec2 relativePosition) override;
 
@@ -43,6 +44,7 @@ class MusicModeButton : public Widgets::Button {
   MusicModeButton(Profile::CCLCC::LibraryMenu::MusicMenuPlayingMode& mode);
 
   void Update(float dt) override;
+  bool NeedsUpdate() const override { return true; }
 
  private:
   Profile::CCLCC::LibraryMenu::MusicMenuPlayingMode& PlayMode;
@@ -330,9 +330,10 @@ void TipsMenu::Render() {
       TipViewItems.Render();
 
       Renderer->DrawProcessedText(
-          TextPage.Glyphs, Profile::Dialogue::DialogueFont,
-          FadeAnimation.Progress, FadeAnimation.Progress,
-          RendererOutlineMode::None, true, &TipsMaskSheet);
+          TextPage.GlyphQuads, TextPage.LayoutGeneration, TextPage.Glyphs,
+          Profile::Dialogue::DialogueFont, FadeAnimation.Progress,
+          FadeAnimation.Progress, RendererOutlineMode::None, true,
+          &TipsMaskSheet);
 
       TipsScrollbar->Render();
     }
@@ -37,6 +37,7 @@ ClearListMenu::ClearListMenu() {
 void ClearListMenu::Show() {
   if (State != Shown) {
     if (State != Showing) MenuTransition.StartIn();
+    ProgressLayer.Invalidate();
     State = Showing;
     if (UI::FocusedMenu != 0) {
       LastFocusedMenu = UI::FocusedMenu;
@@ -100,14 +101,14 @@ void ClearListMenu::Render() {
             1.00397f * std::sin(3.97161f - 3.26438f * MenuTransition.Progress) -
                 0.00295643f);
       }
-      Renderer->DrawSprite(
-          ClearListLabel,
-          glm::vec2(LabelPosition.x, LabelPosition.y + yOffset));
+      // Once slid in, the progress display stays put until the menu is shown
+      // again, so only the play time needs to be drawn every frame
+      if (yOffset == 0.0f) {
+        ProgressLayer.Render([this]() { DrawProgress(0.0f); });
+      } else {
+        DrawProgress(yOffset);
+      }
       DrawPlayTime(yOffset);
-      DrawEndingCount(yOffset);
-      DrawTIPSCount(yOffset);
-      DrawAlbumCompletion(yOffset);
-      DrawEndingTree(yOffset);
       DrawButtonPrompt();
     }
   }
@@ -204,6 +205,15 @@ inline void ClearListMenu::DrawRedBar() {
   }
 }
 
+void ClearListMenu::DrawProgress(float yOffset) {
+  Renderer->DrawSprite(ClearListLabel,
+                       glm::vec2(LabelPosition.x, LabelPosition.y + yOffset));
+  DrawEndingCount(yOffset);
+  DrawTIPSCount(yOffset);
+  DrawAlbumCompletion(yOffset);
+  DrawEndingTree(yOffset);
+}
+
 inline void ClearListMenu::DrawPlayTime(float yOffset) {
   int totalSeconds = ScrWork[SW_PLAYTIME];
   int hours = totalSeconds / 3600;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../ui/menu.h"
+#include "../../ui/cachedlayer.h"
 #include "../../ui/widgets/group.h"
 #include "../../ui/widgets/label.h"
 #include "../../profile/games/chlcc/clearlistmenu.h"
@@ -28,6 +29,7 @@ class ClearListMenu : public Menu {
   void DrawTIPSCount(float yOffset);
   void DrawAlbumCompletion(float yOffset);
   void DrawEndingTree(float yOffset);
+  void DrawProgress(float yOffset);
 
   void DrawButtonPrompt();
 
@@ -39,6 +41,9 @@ class ClearListMenu : public Menu {
   glm::vec2 RedTitleLabelPos;
   glm::vec2 RightTitlePos;
   glm::vec2 LeftTitlePos;
+
+  // Completion counts and the ending tree, which don't change while shown
+  CachedLayer ProgressLayer;
 };
 
 }  // namespace CHLCC
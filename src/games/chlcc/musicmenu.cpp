@@ -65,6 +65,7 @@ void MusicMenu::Show() {
     if (State != Showing) MenuTransition.StartIn();
     State = Showing;
     UpdateEntries();
+    TrackListLayer.Invalidate();
     MainItems->Show();
     CurrentlyPlayingTrackName.Show();
     CurrentlyPlayingTrackArtist.Show();
@@ -146,8 +147,11 @@ void MusicMenu::Render() {
         for (auto button : MainItems->Children)
           static_cast<Widgets::CHLCC::TrackSelectButton*>(button)->MoveTracks(
               currentScroll + offset);
+        MainItems->Render();
+      } else {
+        // The track list only needs to be redrawn when scrolled or refocused
+        TrackListLayer.Render(*MainItems);
       }
-      MainItems->Render();
 
       if (MenuTransition.Progress > 0.34f) {
         Renderer->DrawSprite(SoundLibraryTitle, LeftTitlePos);
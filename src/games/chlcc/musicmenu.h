@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../ui/menu.h"
+#include "../../ui/cachedlayer.h"
 #include "../../ui/widgets/group.h"
 #include "../../ui/widgets/button.h"
 #include "../../ui/widgets/label.h"
@@ -30,6 +31,7 @@ class MusicMenu : public Menu {
 
  private:
   Widgets::Group* MainItems;
+  CachedLayer TrackListLayer;
 
   void DrawCircles();
   void DrawErin();
@@ -67,6 +67,7 @@ AlbumMenu::AlbumMenu() {
   ImageGrid->RenderingBounds = ThumbnailGridBounds;
   ImageGrid->HoverBounds = ThumbnailGridBounds;
   ImageGrid->WrapFocus = false;
+  ImageGrid->UseSpatialIndex = true;
   auto pos = InitialButtonPosition;
   int idx = 0;
 
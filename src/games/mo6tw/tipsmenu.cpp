@@ -131,7 +131,8 @@ void TipsMenu::Render() {
 
     if (CurrentlyDisplayedTipId != -1) {
       TipViewItems.Render();
-      Renderer->DrawProcessedText(TextPage.Glyphs,
+      Renderer->DrawProcessedText(TextPage.GlyphQuads,
+                                  TextPage.LayoutGeneration, TextPage.Glyphs,
                                   Profile::Dialogue::DialogueFont, col.a,
                                   RendererOutlineMode::Full, true);
       if (ThumbnailSprite) {
@@ -0,0 +1,96 @@
+#include "audiopackarchive.h"
+
+#include "../log.h"
+#include "uncompressedstream.h"
+#include "vfs.h"
+
+#include <string>
+
+namespace Impacto {
+namespace Io {
+
+struct AudioPackMetaEntry : FileMeta {
+  int64_t Offset;
+};
+
+AudioPackArchive::~AudioPackArchive() {
+  if (TOC) delete[] TOC;
+}
+
+IoError AudioPackArchive::Open(FileMeta* file, Stream** outStream) {
+  AudioPackMetaEntry* entry = (AudioPackMetaEntry*)file;
+  IoError err = UncompressedStream::Create(BaseStream, entry->Offset,
+                                           entry->Size, outStream);
+  if (err != IoError_OK) {
+    ImpLog(LogLevel::Error, LogChannel::IO,
+           "Audio pack file open failed for file \"{:s}\" in archive "
+           "\"{:s}\"\n",
+           entry->FileName, BaseStream->Meta.FileName);
+  }
+  return err;
+}
+
+IoError AudioPackArchive::Create(Stream* stream, VfsArchive** outArchive) {
+  ImpLog(LogLevel::Trace, LogChannel::IO,
+         "Trying to mount \"{:s}\" as audio pack\n", stream->Meta.FileName);
+
+  AudioPackArchive* result = 0;
+  uint32_t fileCount;
+
+  if (ReadBE<uint32_t>(stream) != Magic) {
+    ImpLog(LogLevel::Trace, LogChannel::IO, "Not an audio pack\n");
+    goto fail;
+  }
+  if (ReadLE<uint32_t>(stream) != Version) {
+    ImpLog(LogLevel::Error, LogChannel::IO,
+           "Unsupported audio pack version in \"{:s}\"\n",
+           stream->Meta.FileName);
+    goto fail;
+  }
+
+  fileCount = ReadLE<uint32_t>(stream);
+
+  result = new AudioPackArchive;
+  result->BaseStream = stream;
+  result->NamesToIds.reserve(fileCount);
+  result->IdsToFiles.reserve(fileCount);
+  result->TOC = new AudioPackMetaEntry[fileCount];
+
+  for (uint32_t i = 0; i < fileCount; i++) {
+    AudioPackMetaEntry& entry = result->TOC[i];
+    entry.Id = ReadLE<uint32_t>(stream);
+    entry.Offset = ReadLE<int64_t>(stream);
+    entry.Size = ReadLE<int64_t>(stream);
+
+    const uint16_t nameLength = ReadLE<uint16_t>(stream);
+    entry.FileName.resize(nameLength);
+    if (stream->Read(entry.FileName.data(), nameLength) != nameLength) {
+      goto fail;
+    }
+
+    if (entry.Offset < 0 || entry.Size < 0 ||
+        entry.Offset + entry.Size > stream->Meta.Size) {
+      ImpLog(LogLevel::Error, LogChannel::IO,
+             "Audio pack entry {:d} out of bounds\n", entry.Id);
+      goto fail;
+    }
+
+    result->IdsToFiles[entry.Id] = &entry;
+    result->NamesToIds[entry.FileName] = entry.Id;
+  }
+
+  result->IsInit = true;
+  *outArchive = result;
+  return IoError_OK;
+
+fail:
+  stream->Seek(0, RW_SEEK_SET);
+  if (result) {
+    result->BaseStream = 0;
+    delete result;
+  }
+  return IoError_Fail;
+}
+
+}  // namespace Io
+}  // namespace Impacto
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "vfsarchive.h"
+
+namespace Impacto {
+namespace Io {
+
+struct AudioPackMetaEntry;
+
+// Archive written by the audiotranscode tool, holding a mountpoint's files
+// under their original IDs and names with the audio transcoded to PCM clips.
+//
+// Layout (little endian):
+//   u32 magic "IPAK" (big endian), u32 version, u32 file count
+//   per file: u32 id, u64 offset, u64 size, u16 name length, name
+//   file data, each file aligned to DataAlignment
+class AudioPackArchive : public VfsArchive {
+ public:
+  static uint32_t constexpr Magic = 0x4950414Bu;  // "IPAK"
+  static uint32_t constexpr Version = 1;
+  static int constexpr DataAlignment = 16;
+
+  ~AudioPackArchive();
+  IoError Open(FileMeta* file, Stream** outStream) override;
+
+  static IoError Create(Stream* stream, VfsArchive** outArchive);
+
+ private:
+  AudioPackMetaEntry* TOC = 0;
+};
+
+}  // namespace Io
+}  // namespace Impacto
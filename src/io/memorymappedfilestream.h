@@ -22,6 +22,9 @@ class MemoryMappedFileStream : public Stream {
   int64_t Seek(int64_t offset, int origin) override;
   IoError Duplicate(Stream** outStream) override;
   int64_t Write(void* buffer, int64_t sz, size_t cnt = 1) override;
+  const uint8_t* GetContiguousData() override {
+    return (const uint8_t*)mmapFile.data();
+  }
 
  protected:
   MemoryMappedFileStream(std::string filePath)
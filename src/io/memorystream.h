@@ -14,6 +14,9 @@ class MemoryStream : public Stream {
   int64_t Seek(int64_t offset, int origin) override;
   int64_t Write(void* buffer, int64_t sz, size_t cnt = 1) override;
   IoError Duplicate(Stream** outStream) override;
+  const uint8_t* GetContiguousData() override {
+    return (const uint8_t*)Memory;
+  }
 
  protected:
   MemoryStream() {}
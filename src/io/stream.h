@@ -27,6 +27,11 @@ class Stream {
     return IoError_Fail;
   }
   virtual IoError Duplicate(Stream** outStream) = 0;
+
+  // The stream's data if it lies in one contiguous region of memory that
+  // stays valid as long as the stream exists (e.g. a memory mapped archive
+  // entry), so it can be read without going through Read. Null otherwise.
+  virtual const uint8_t* GetContiguousData() { return nullptr; }
 };
 
 inline uint8_t ReadU8(Stream* stream) {
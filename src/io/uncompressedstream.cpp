@@ -53,6 +53,11 @@ int64_t UncompressedStream::Seek(int64_t offset, int origin) {
   return Position;
 }
 
+const uint8_t* UncompressedStream::GetContiguousData() {
+  const uint8_t* baseData = BaseStream->GetContiguousData();
+  return baseData ? baseData + BaseStreamOffset : nullptr;
+}
+
 IoError UncompressedStream::Duplicate(Stream** outStream) {
   Stream* baseDup;
   IoError err = BaseStream->Duplicate(&baseDup);
@@ -14,6 +14,7 @@ class UncompressedStream : public Stream {
   int64_t Read(void* buffer, int64_t sz) override;
   int64_t Seek(int64_t offset, int origin) override;
   IoError Duplicate(Stream** outStream) override;
+  const uint8_t* GetContiguousData() override;
 
  protected:
   UncompressedStream() {}
@@ -14,6 +14,7 @@
 #endif
 
 #include "afsarchive.h"
+#include "audiopackarchive.h"
 #include "cpkarchive.h"
 #include "lnk4archive.h"
 #include "mpkarchive.h"
@@ -65,6 +66,7 @@ static VfsArchive* FindArchive(std::string const& mountpoint,
 
 void VfsInit() {
   Archivers.push_back(AfsArchive::Create);
+  Archivers.push_back(AudioPackArchive::Create);
   Archivers.push_back(CpkArchive::Create);
   Archivers.push_back(Lnk4Archive::Create);
   Archivers.push_back(MpkArchive::Create);
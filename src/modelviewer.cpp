@@ -9,6 +9,7 @@
 #include "audio/audiochannel.h"
 #include "renderer/3d/scene.h"
 #include "renderer/3d/model.h"
+#include "renderer/3d/skeletonposer.h"
 
 #include "profile/scene3d.h"
 
@@ -37,6 +38,9 @@ static float BgmFadeOut;
 static float BgmFadeIn;
 static int BgmLoop;
 
+static PoseBenchmarkResult CharacterPoseBenchmark;
+static PoseBenchmarkResult BackgroundPoseBenchmark;
+
 void Init() {
   Model::EnumerateModels();
   EnumerateBgm();
@@ -401,6 +405,33 @@ void Update(float dt) {
     }
 
     ImGui::Spacing();
+
+    if (ImGui::CollapsingHeader("Skeleton benchmark")) {
+      ImGui::Spacing();
+      ImGui::TextWrapped(
+          "Loads every model and poses it recursively, then with dirty "
+          "tracking. Takes a while.");
+      if (ImGui::Button("Run##poseBenchmark",
+                        ImVec2(ImGui::GetContentRegionAvail().x, 0.0f))) {
+        CharacterPoseBenchmark = BenchmarkPosing(g_ModelIds);
+        BackgroundPoseBenchmark = BenchmarkPosing(g_BackgroundModelIds);
+      }
+      for (const auto& [name, result] :
+           {std::pair{"Characters", CharacterPoseBenchmark},
+            std::pair{"Backgrounds", BackgroundPoseBenchmark}}) {
+        if (result.Models == 0) continue;
+        const int frames = result.Models * result.Frames;
+        ImGui::Spacing();
+        ImGui::Text("%s: %d models, %d bones", name, result.Models,
+                    result.Bones);
+        ImGui::Text("Recursive: %.1f us per model",
+                    result.RecursiveSeconds * 1e6 / frames);
+        ImGui::Text("Poser: %.1f us per model, %d bones posed",
+                    result.PoserSeconds * 1e6 / frames, result.PosedBones);
+      }
+    }
+
+    ImGui::Spacing();
   }
 
   ImGui::End();
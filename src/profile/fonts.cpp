@@ -2,11 +2,14 @@
 #include "profile_internal.h"
 #include "../log.h"
 #include "../renderer/renderer.h"
+#include "../textlayoutcache.h"
 
 namespace Impacto {
 namespace Profile {
 
 void LoadFonts() {
+  TextLayoutCache::Clear();
+
   EnsurePushMemberOfType("Fonts", LUA_TTABLE);
 
   PushInitialIndex();
@@ -42,6 +45,48 @@ void LoadFonts() {
         }
         font->OutlineOffset = EnsureGetMember<glm::vec2>("OutlineOffset");
 
+        break;
+      }
+      case FontType::SDF: {
+        // The sheet the field was generated from, for renderers that can't
+        // draw the field
+        if (!Renderer->SupportsSDFText()) {
+          BasicFont* font = new BasicFont();
+          if (TryGetMember<SpriteSheet>("FallbackSheet", font->Sheet)) {
+            ImpLog(LogLevel::Warning, LogChannel::Profile,
+                   "Renderer can't draw SDF text, using the fallback sheet "
+                   "of font {:s}\n",
+                   name);
+            Fonts[name] = font;
+            baseFont = font;
+            break;
+          }
+          delete font;
+          ImpLog(LogLevel::Error, LogChannel::Profile,
+                 "Renderer can't draw SDF text and font {:s} has no "
+                 "FallbackSheet, it will be drawn as a raw field\n",
+                 name);
+        }
+
+        SDFFont* font = new SDFFont();
+        Fonts[name] = font;
+        baseFont = font;
+
+        font->Sheet = EnsureGetMember<SpriteSheet>("Sheet");
+        font->Spread = EnsureGetMember<float>("Spread");
+
+        if (!TryGetMember<float>("OutlineWidth", font->OutlineWidth)) {
+          font->OutlineWidth = 1.0f;
+        }
+        if (font->OutlineWidth >= font->Spread) {
+          ImpLog(LogLevel::Warning, LogChannel::Profile,
+                 "Outline of SDF font {:s} is wider than its spread\n", name);
+          font->OutlineWidth = font->Spread - 0.5f;
+        }
+        if (!TryGetMember<glm::vec2>("ShadowOffset", font->ShadowOffset)) {
+          font->ShadowOffset = glm::vec2(1.0f);
+        }
+
         break;
       }
     }
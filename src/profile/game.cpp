@@ -51,6 +51,20 @@ void LoadGameFromLua() {
   } else
     ActiveAudioBackend =
         AudioBackendType::_from_integral_unchecked(audioBackendType);
+  TryGetMember<int>("AudioCacheBudget", AudioCacheBudget);
+  TryGetMember<float>("AudioCacheMaxClipDuration", AudioCacheMaxClipDuration);
+  TryGetMember<int>("VoicePrefetchDepth", VoicePrefetchDepth);
+  TryGetMember<float>("VoicePrefetchDuration", VoicePrefetchDuration);
+
+  int audioMixerSink = -1;
+  if (TryGetMember<int>("AudioMixerSink", audioMixerSink)) {
+    AudioMixerSink =
+        AudioMixerSinkType::_from_integral_unchecked(audioMixerSink);
+  }
+  TryGetMember<char const*>("AudioMixerSinkPath", AudioMixerSinkPath);
+  TryGetMember<int>("AudioMixerSampleRate", AudioMixerSampleRate);
+  TryGetMember<bool>("AudioMixerOffline", AudioMixerOffline);
+
   int videoPlayerType = -1;
   res = TryGetMember<int>("VideoPlayerType", videoPlayerType);
   if (!res) {
@@ -11,6 +11,24 @@ inline RendererType ActiveRenderer = RendererType::OpenGL;
 inline VideoPlayerType VideoPlayer = VideoPlayerType::FFmpeg;
 inline AudioBackendType ActiveAudioBackend = AudioBackendType::OpenAL;
 
+// Byte budget for keeping short sound effects decoded, 0 to disable
+inline int AudioCacheBudget = 16 * 1024 * 1024;
+// Longest clip in seconds that gets kept decoded
+inline float AudioCacheMaxClipDuration = 5.0f;
+
+// Voice files after the one playing that get opened ahead of time, 0 to
+// disable
+inline int VoicePrefetchDepth = 3;
+// Seconds of each prefetched voice decoded ahead of time
+inline float VoicePrefetchDuration = 0.25f;
+
+// Output of the software mixer backend
+inline AudioMixerSinkType AudioMixerSink = AudioMixerSinkType::Device;
+inline char const* AudioMixerSinkPath = "mixer.wav";
+inline int AudioMixerSampleRate = 48000;
+// Null and file sinks mix in lockstep with game time instead of in real time
+inline bool AudioMixerOffline = false;
+
 inline uint32_t LayerCount;
 inline int GameFeatures;
 
@@ -183,6 +183,7 @@ void MakeLuaProfile(std::string const& name) {
   DefineEnumInt<RendererType>(LuaState);
   DefineEnumInt<VideoPlayerType>(LuaState);
   DefineEnumInt<AudioBackendType>(LuaState);
+  DefineEnumInt<AudioMixerSinkType>(LuaState);
   DefineEnumInt<TextAlignment>(LuaState);
   DefineEnumInt<GameFeature>(LuaState);
   DefineEnumInt<CharacterTypeFlags>(LuaState);
@@ -1,6 +1,9 @@
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include "animation.h"
+#include "renderable3d.h"
 
 #include "../../log.h"
 #include "../../util.h"
@@ -74,6 +77,167 @@ Target GetTarget(Stream* stream, Model* model) {
   return result;
 }
 
+struct RawBoneTrack {
+  int KeyOffsets[BKT_Count];
+  uint16_t KeyCounts[BKT_Count];
+};
+
+// Index of the last key at or before t, moving forward from key
+template <typename Keyframe>
+static int AdvanceKey(Keyframe const* keys, int count, int key, float t) {
+  while (key + 1 < count && keys[key + 1].Time <= t) key++;
+  return key;
+}
+
+template <typename Keyframe>
+static float KeyFactor(Keyframe const* keys, int count, int key, float t) {
+  if (key + 1 >= count) return 0.0f;
+  return glm::clamp(
+      (t - keys[key].Time) / (keys[key + 1].Time - keys[key].Time), 0.0f,
+      1.0f);
+}
+
+static uint16_t Quantize(float value, float min, float step) {
+  if (step == 0.0f) return 0;
+  return (uint16_t)glm::clamp(std::lround((value - min) / step), 0l, 65535l);
+}
+
+// Resamples every channel of a track at the times any of them has a key, so
+// they can share one stream of keys. Channels are piecewise linear (or slerped
+// along one arc) between their own keys, so this is lossless apart from the
+// quantization.
+static void PackBoneTrack(ModelAnimation* animation, BoneTrack& track,
+                          RawBoneTrack const& raw,
+                          std::vector<QuatKeyframe> const& quatKeyframes) {
+  QuatKeyframe const* rotationKeys =
+      quatKeyframes.data() + raw.KeyOffsets[BKT_Rotate];
+
+  std::vector<float> times;
+  for (int c = 0; c < BKT_Count; c++) {
+    if (raw.KeyCounts[c] == 0) continue;
+    track.Channels |= 1 << c;
+    for (int k = 0; k < raw.KeyCounts[c]; k++) {
+      times.push_back(
+          c == BKT_Rotate
+              ? rotationKeys[k].Time
+              : animation->CoordKeyframes[raw.KeyOffsets[c] + k].Time);
+    }
+  }
+  std::sort(times.begin(), times.end());
+  times.erase(std::unique(times.begin(), times.end()), times.end());
+
+  const size_t keyCount = times.size();
+  std::vector<glm::vec3> positions(keyCount, glm::vec3(0.0f));
+  std::vector<glm::vec3> scales(keyCount, glm::vec3(1.0f));
+  std::vector<glm::quat> rotations(keyCount);
+  std::vector<uint8_t> keyedChannels(keyCount, 0);
+
+  int cursors[BKT_Count] = {};
+  for (size_t k = 0; k < keyCount; k++) {
+    const float t = times[k];
+    for (int c = 0; c < BKT_Count; c++) {
+      if (!(track.Channels & (1 << c))) continue;
+      const int count = raw.KeyCounts[c];
+      int& key = cursors[c];
+
+      if (c == BKT_Rotate) {
+        key = AdvanceKey(rotationKeys, count, key, t);
+        if (rotationKeys[key].Time == t) keyedChannels[k] |= 1 << c;
+        rotations[k] =
+            glm::slerp(rotationKeys[key].Value,
+                       rotationKeys[std::min(key + 1, count - 1)].Value,
+                       KeyFactor(rotationKeys, count, key, t));
+        continue;
+      }
+
+      CoordKeyframe const* keys =
+          animation->CoordKeyframes + raw.KeyOffsets[c];
+      key = AdvanceKey(keys, count, key, t);
+      if (keys[key].Time == t) keyedChannels[k] |= 1 << c;
+      const float value =
+          glm::mix(keys[key].Value, keys[std::min(key + 1, count - 1)].Value,
+                   KeyFactor(keys, count, key, t));
+      if (c < BKT_Rotate) {
+        positions[k][c - BKT_TranslateX] = value;
+      } else {
+        scales[k][c - BKT_ScaleX] = value;
+      }
+    }
+  }
+
+  if (keyCount > 0) {
+    glm::vec3 minPosition = positions[0], maxPosition = positions[0];
+    glm::vec3 minScale = scales[0], maxScale = scales[0];
+    for (size_t k = 1; k < keyCount; k++) {
+      minPosition = glm::min(minPosition, positions[k]);
+      maxPosition = glm::max(maxPosition, positions[k]);
+      minScale = glm::min(minScale, scales[k]);
+      maxScale = glm::max(maxScale, scales[k]);
+    }
+    track.PositionMin = minPosition;
+    track.PositionStep = (maxPosition - minPosition) / 65535.0f;
+    track.ScaleMin = minScale;
+    track.ScaleStep = (maxScale - minScale) / 65535.0f;
+  }
+
+  track.KeyOffset = (uint32_t)animation->BoneKeys.size();
+  track.KeyCount = (uint32_t)keyCount;
+  animation->BoneKeyTimes.insert(animation->BoneKeyTimes.end(), times.begin(),
+                                 times.end());
+  for (size_t k = 0; k < keyCount; k++) {
+    BoneKey key;
+    const glm::quat rotation = glm::normalize(rotations[k]);
+    key.Rotation[0] = (int16_t)std::lround(rotation.w * 32767.0f);
+    key.Rotation[1] = (int16_t)std::lround(rotation.x * 32767.0f);
+    key.Rotation[2] = (int16_t)std::lround(rotation.y * 32767.0f);
+    key.Rotation[3] = (int16_t)std::lround(rotation.z * 32767.0f);
+    for (int c = 0; c < 3; c++) {
+      key.Position[c] = Quantize(positions[k][c], track.PositionMin[c],
+                                 track.PositionStep[c]);
+      key.Scale[c] =
+          Quantize(scales[k][c], track.ScaleMin[c], track.ScaleStep[c]);
+    }
+    animation->BoneKeys.push_back(key);
+  }
+
+  // Resolved here so stepped sampling doesn't have to search back for each
+  // channel's last key every frame
+  const size_t firstKey = track.KeyOffset;
+  uint32_t lastKeyed[BKT_Count] = {};
+  for (size_t k = 0; k < keyCount; k++) {
+    for (int c = 0; c < BKT_Count; c++) {
+      if (keyedChannels[k] & (1 << c)) lastKeyed[c] = (uint32_t)k;
+    }
+
+    BoneKey held;
+    std::copy_n(animation->BoneKeys[firstKey + lastKeyed[BKT_Rotate]].Rotation,
+                4, held.Rotation);
+    for (int c = 0; c < 3; c++) {
+      held.Position[c] =
+          animation->BoneKeys[firstKey + lastKeyed[BKT_TranslateX + c]]
+              .Position[c];
+      held.Scale[c] =
+          animation->BoneKeys[firstKey + lastKeyed[BKT_ScaleX + c]].Scale[c];
+    }
+    animation->BoneHeldKeys.push_back(held);
+  }
+}
+
+static Transform DecodeBoneKey(BoneTrack const& track, BoneKey const& key) {
+  Transform result;
+  result.Position =
+      track.PositionMin +
+      glm::vec3(key.Position[0], key.Position[1], key.Position[2]) *
+          track.PositionStep;
+  result.Rotation = glm::normalize(
+      glm::quat(key.Rotation[0] / 32767.0f, key.Rotation[1] / 32767.0f,
+                key.Rotation[2] / 32767.0f, key.Rotation[3] / 32767.0f));
+  result.Scale =
+      track.ScaleMin +
+      glm::vec3(key.Scale[0], key.Scale[1], key.Scale[2]) * track.ScaleStep;
+  return result;
+}
+
 ModelAnimation* ModelAnimation::Load(Stream* stream, Model* model,
                                      int16_t animId) {
   int trackSize, trackCountsOffset, trackOffsetsOffset;
@@ -118,6 +282,9 @@ ModelAnimation* ModelAnimation::Load(Stream* stream, Model* model,
   int32_t TrackForBone[ModelMaxBonesPerModel];
   memset(TrackForBone, 0xFF, sizeof(TrackForBone));
 
+  // Keys as they are in the file, until they are packed
+  std::vector<RawBoneTrack> rawBoneTracks;
+
   // Only get coord track counts/offsets and other simple data
   for (uint32_t i = 0; i < trackCount; i++) {
     ImpLogSlow(LogLevel::Trace, LogChannel::ModelLoad,
@@ -135,7 +302,8 @@ ModelAnimation* ModelAnimation::Load(Stream* stream, Model* model,
       ImpLogSlow(LogLevel::Trace, LogChannel::ModelLoad,
                  "Track {:d} is bone {:d}\n", i, target.Id);
 
-      BoneTrack* track = &result->BoneTracks[result->BoneTrackCount];
+      BoneTrack* track = &result->BoneTracks.emplace_back();
+      RawBoneTrack* raw = &rawBoneTracks.emplace_back();
       memcpy(track->Name, target.Name, sizeof(target.Name));
 
       track->Bone = target.Id;
@@ -151,26 +319,26 @@ ModelAnimation* ModelAnimation::Load(Stream* stream, Model* model,
       // Read coord offsets/counts, so far, so normal...
 
       ReadArrayLE<(BKT_Rotate - BKT_TranslateX)>(
-          track->KeyCounts + BKT_TranslateX, stream);
+          raw->KeyCounts + BKT_TranslateX, stream);
       for (int j = BKT_TranslateX; j < BKT_Rotate; j++) {
-        track->KeyOffsets[j] = currentCoordOffset;
-        currentCoordOffset += track->KeyCounts[j];
+        raw->KeyOffsets[j] = currentCoordOffset;
+        currentCoordOffset += raw->KeyCounts[j];
         ImpLogSlow(LogLevel::Trace, LogChannel::ModelLoad,
                    "Subtrack {:d}: count {:d} offset 0x{:08x}\n", j,
-                   track->KeyCounts[j], track->KeyOffsets[j]);
+                   raw->KeyCounts[j], raw->KeyOffsets[j]);
       }
 
       // Skip rotates
       stream->Seek(3 * sizeof(uint16_t), RW_SEEK_CUR);
 
-      ReadArrayLE<(BKT_Count - BKT_ScaleX)>(track->KeyCounts + BKT_ScaleX,
+      ReadArrayLE<(BKT_Count - BKT_ScaleX)>(raw->KeyCounts + BKT_ScaleX,
                                             stream);
       for (int j = BKT_ScaleX; j < BKT_Count; j++) {
-        track->KeyOffsets[j] = currentCoordOffset;
-        currentCoordOffset += track->KeyCounts[j];
+        raw->KeyOffsets[j] = currentCoordOffset;
+        currentCoordOffset += raw->KeyCounts[j];
         ImpLogSlow(LogLevel::Trace, LogChannel::ModelLoad,
                    "Subtrack {:d}: count {:d} offset 0x{:08x}\n", j,
-                   track->KeyCounts[j], track->KeyOffsets[j]);
+                   raw->KeyCounts[j], raw->KeyOffsets[j]);
       }
 
       result->BoneTrackCount++;
@@ -268,7 +436,7 @@ ModelAnimation* ModelAnimation::Load(Stream* stream, Model* model,
   std::vector<std::vector<QuatKeyframe>> rotationTracks;
   rotationTracks.reserve(result->BoneTrackCount);
 
-  result->QuatKeyframeCount = 0;
+  int quatKeyframeCount = 0;
 
   int currentBoneTrack = 0;
   for (uint32_t i = 0; i < trackCount; i++) {
@@ -280,7 +448,7 @@ ModelAnimation* ModelAnimation::Load(Stream* stream, Model* model,
 
       ImpLogSlow(LogLevel::Trace, LogChannel::ModelLoad,
                  "Interleaving rotations track {:d} bone {:d}\n", i, target.Id);
-      BoneTrack* track = &result->BoneTracks[currentBoneTrack];
+      RawBoneTrack* raw = &rawBoneTracks[currentBoneTrack];
 
       std::vector<QuatKeyframe> rotationTrack;
 
@@ -395,24 +563,22 @@ ModelAnimation* ModelAnimation::Load(Stream* stream, Model* model,
 
       rotationTrack.shrink_to_fit();
       rotationTracks.push_back(rotationTrack);
-      track->KeyCounts[BKT_Rotate] = (uint16_t)rotationTrack.size();
-      track->KeyOffsets[BKT_Rotate] = result->QuatKeyframeCount;
-      result->QuatKeyframeCount += track->KeyCounts[BKT_Rotate];
+      raw->KeyCounts[BKT_Rotate] = (uint16_t)rotationTrack.size();
+      raw->KeyOffsets[BKT_Rotate] = quatKeyframeCount;
+      quatKeyframeCount += raw->KeyCounts[BKT_Rotate];
 
       ImpLogSlow(LogLevel::Trace, LogChannel::ModelLoad,
                  "QuatKeyframe count {:d} offset 0x{:08x}\n",
-                 track->KeyCounts[BKT_Rotate], track->KeyOffsets[BKT_Rotate]);
+                 raw->KeyCounts[BKT_Rotate], raw->KeyOffsets[BKT_Rotate]);
 
       currentBoneTrack++;
     }
   }
 
-  result->QuatKeyframes =
-      (QuatKeyframe*)malloc(sizeof(QuatKeyframe) * result->QuatKeyframeCount);
+  std::vector<QuatKeyframe> quatKeyframes(quatKeyframeCount);
 
   ImpLogSlow(LogLevel::Trace, LogChannel::ModelLoad,
-             "---\nTotal quat keyframe count: {:d}\n---\n",
-             result->QuatKeyframeCount);
+             "---\nTotal quat keyframe count: {:d}\n---\n", quatKeyframeCount);
 
   // Now that we have the buffers, fill with data
 
@@ -425,7 +591,7 @@ ModelAnimation* ModelAnimation::Load(Stream* stream, Model* model,
     if (target.Type == TargetType_Bone) {
       if (static_cast<int32_t>(i) != TrackForBone[target.Id]) continue;
 
-      BoneTrack* track = &result->BoneTracks[currentBoneTrack];
+      RawBoneTrack* raw = &rawBoneTracks[currentBoneTrack];
 
       // Coords
       for (int j = STT_Visibility; j <= STT_ScaleZ; j++) {
@@ -458,21 +624,21 @@ ModelAnimation* ModelAnimation::Load(Stream* stream, Model* model,
 
       // Already have rotate keyframe data
       QuatKeyframe* quatSrc = rotationTracks[currentBoneTrack].data();
-      memcpy(result->QuatKeyframes + track->KeyOffsets[BKT_Rotate], quatSrc,
-             track->KeyCounts[BKT_Rotate] * sizeof(QuatKeyframe));
+      memcpy(quatKeyframes.data() + raw->KeyOffsets[BKT_Rotate], quatSrc,
+             raw->KeyCounts[BKT_Rotate] * sizeof(QuatKeyframe));
 
       // Animator currently needs this
       for (int j = BKT_TranslateX; j < BKT_Count; j++) {
-        if (track->KeyCounts[j]) {
+        if (raw->KeyCounts[j]) {
           if (j == BKT_Rotate) {
-            // assert(result->QuatKeyframes[track->KeyOffsets[j]].Time == 0.0f);
+            // assert(quatKeyframes[raw->KeyOffsets[j]].Time == 0.0f);
             // This is quite far off for some stuff (e.g. a CoordKeyframe in
             // c001_000@10_out_pokecom.lka) - may need to fix this properly
-            result->QuatKeyframes[track->KeyOffsets[j]].Time = 0.0f;
+            quatKeyframes[raw->KeyOffsets[j]].Time = 0.0f;
           } else {
-            // assert(result->CoordKeyframes[track->KeyOffsets[j]].Time ==
+            // assert(result->CoordKeyframes[raw->KeyOffsets[j]].Time ==
             // 0.0f);
-            result->CoordKeyframes[track->KeyOffsets[j]].Time = 0.0f;
+            result->CoordKeyframes[raw->KeyOffsets[j]].Time = 0.0f;
           }
         }
       }
@@ -541,6 +707,47 @@ ModelAnimation* ModelAnimation::Load(Stream* stream, Model* model,
     }
   }
 
+  // Pack bone tracks into one interleaved stream of keys each. Channels are
+  // usually keyed together, so there are about as many keys as rotations.
+  result->BoneKeyTimes.reserve(quatKeyframeCount);
+  result->BoneKeys.reserve(quatKeyframeCount);
+  result->BoneHeldKeys.reserve(quatKeyframeCount);
+  for (int i = 0; i < result->BoneTrackCount; i++) {
+    PackBoneTrack(result, result->BoneTracks[i], rawBoneTracks[i],
+                  quatKeyframes);
+  }
+  result->BoneKeyTimes.shrink_to_fit();
+  result->BoneKeys.shrink_to_fit();
+
+  // Only mesh tracks still need coord keyframes. Tracks of meshes in the same
+  // group share theirs.
+  std::vector<int> meshKeyOffsets(result->CoordKeyframeCount, -1);
+  std::vector<CoordKeyframe> meshKeys;
+  for (int i = 0; i < result->MeshTrackCount; i++) {
+    MeshTrack* track = &result->MeshTracks[i];
+    for (int j = 0; j < MKT_MorphInfluenceStart + track->MorphTargetCount;
+         j++) {
+      if (track->KeyCounts[j] == 0) {
+        track->KeyOffsets[j] = 0;
+        continue;
+      }
+      int& offset = meshKeyOffsets[track->KeyOffsets[j]];
+      if (offset < 0) {
+        offset = (int)meshKeys.size();
+        CoordKeyframe const* keys =
+            result->CoordKeyframes + track->KeyOffsets[j];
+        meshKeys.insert(meshKeys.end(), keys, keys + track->KeyCounts[j]);
+      }
+      track->KeyOffsets[j] = offset;
+    }
+  }
+  free(result->CoordKeyframes);
+  result->CoordKeyframeCount = (int)meshKeys.size();
+  result->CoordKeyframes = (CoordKeyframe*)malloc(sizeof(CoordKeyframe) *
+                                                  result->CoordKeyframeCount);
+  memcpy(result->CoordKeyframes, meshKeys.data(),
+         sizeof(CoordKeyframe) * result->CoordKeyframeCount);
+
   // Ahhh, now fetch metadata
 
   result->LoopEnd = result->Duration;
@@ -571,7 +778,48 @@ ModelAnimation* ModelAnimation::Load(Stream* stream, Model* model,
 
 ModelAnimation::~ModelAnimation() {
   if (CoordKeyframes) free(CoordKeyframes);
-  if (QuatKeyframes) free(QuatKeyframes);
+}
+
+void ModelAnimation::SampleBones(float t, bool interpolate, uint32_t* cursors,
+                                 PosedBone* pose) const {
+  for (int i = 0; i < BoneTrackCount; i++) {
+    BoneTrack const& track = BoneTracks[i];
+    if (track.KeyCount == 0) continue;
+    float const* times = BoneKeyTimes.data() + track.KeyOffset;
+    BoneKey const* keys =
+        (interpolate ? BoneKeys.data() : BoneHeldKeys.data()) +
+        track.KeyOffset;
+
+    uint32_t& key = cursors[i];
+    if (key >= track.KeyCount || times[key] > t) {
+      // Went back in time, e.g. looped
+      key = (uint32_t)std::max(
+          std::upper_bound(times, times + track.KeyCount, t) - times - 1,
+          (ptrdiff_t)0);
+    }
+    while (key + 1 < track.KeyCount && times[key + 1] <= t) key++;
+
+    Transform value = DecodeBoneKey(track, keys[key]);
+    if (interpolate && key + 1 < track.KeyCount) {
+      const float factor = glm::clamp(
+          (t - times[key]) / (times[key + 1] - times[key]), 0.0f, 1.0f);
+      value = value.Interpolate(DecodeBoneKey(track, keys[key + 1]), factor);
+    }
+
+    Transform& transform = pose[track.Bone].LocalTransform;
+    for (int c = 0; c < BKT_Count; c++) {
+      if (!(track.Channels & (1 << c))) continue;
+
+      if (c < BKT_Rotate) {
+        transform.Position[c - BKT_TranslateX] =
+            value.Position[c - BKT_TranslateX];
+      } else if (c == BKT_Rotate) {
+        transform.Rotation = value.Rotation;
+      } else {
+        transform.Scale[c - BKT_ScaleX] = value.Scale[c - BKT_ScaleX];
+      }
+    }
+  }
 }
 
 }  // namespace Impacto
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "../../io/stream.h"
 
 #include "model.h"
@@ -35,14 +37,33 @@ enum MeshKeyType {
   MKT_Count = MKT_MorphInfluenceStart + AnimMaxMorphTargetsPerTrack
 };
 
+// One key of a bone track, for all of its channels at once
+struct BoneKey {
+  // Normalized quaternion, components scaled to +-32767
+  int16_t Rotation[4];
+  // Quantized from the track's PositionMin in steps of PositionStep
+  uint16_t Position[3];
+  // Quantized from the track's ScaleMin in steps of ScaleStep
+  uint16_t Scale[3];
+};
+
 struct BoneTrack {
   // DaSH addition
   uint8_t Name[32];
 
   uint16_t Bone;
 
-  int KeyOffsets[BKT_Count];
-  uint16_t KeyCounts[BKT_Count];
+  // Bit per BoneKeyType the track animates, the others are left alone
+  uint8_t Channels = 0;
+
+  // Into ModelAnimation::BoneKeyTimes, BoneKeys and BoneHeldKeys
+  uint32_t KeyOffset = 0;
+  uint32_t KeyCount = 0;
+
+  glm::vec3 PositionMin = glm::vec3(0.0f);
+  glm::vec3 PositionStep = glm::vec3(0.0f);
+  glm::vec3 ScaleMin = glm::vec3(0.0f);
+  glm::vec3 ScaleStep = glm::vec3(0.0f);
 };
 
 // Note: Unlike R;NE animation files, we keep a track per mesh, not a track per
@@ -60,11 +81,19 @@ struct MeshTrack {
   uint16_t MorphTargetIds[AnimMaxMorphTargetsPerTrack];
 };
 
+struct PosedBone;
+
 class ModelAnimation {
  public:
   static ModelAnimation* Load(Io::Stream* stream, Model* model, int16_t animId);
   ~ModelAnimation();
 
+  // Sets the animated channels of every bone's local transform to their value
+  // at time t. cursors holds a key index per bone track, kept between calls so
+  // that playing forward never has to search for keys.
+  void SampleBones(float t, bool interpolate, uint32_t* cursors,
+                   PosedBone* pose) const;
+
   // Per-model ID
   // or global in DaSH
   int16_t Id = 0;
@@ -78,14 +107,19 @@ class ModelAnimation {
   float LoopStart = 0.0f;
   float LoopEnd = 0.0f;
 
+  // Keys of the mesh tracks
   int CoordKeyframeCount = 0;
   CoordKeyframe* CoordKeyframes = 0;
 
-  int QuatKeyframeCount = 0;
-  QuatKeyframe* QuatKeyframes = 0;
+  // Keys of the bone tracks, every channel of a track shares its key times
+  std::vector<float> BoneKeyTimes;
+  std::vector<BoneKey> BoneKeys;
+  // Same keys with every channel still at the value of its own last key in the
+  // file, for sampling without tweening
+  std::vector<BoneKey> BoneHeldKeys;
 
   int BoneTrackCount = 0;
-  BoneTrack BoneTracks[ModelMaxBonesPerModel];
+  std::vector<BoneTrack> BoneTracks;
 
   int MeshTrackCount = 0;
   MeshTrack MeshTracks[ModelMaxMeshesPerModel];
@@ -505,6 +505,7 @@ Model* Model::Load(uint32_t modelId) {
 
     ReadMat4LE(&bone->BindInverse, stream);
   }
+  result->SortBones();
 
   result->MorphVertexCount = 0;
   // Accumulate per-morph target vertex buffer counts
@@ -622,6 +623,31 @@ Model* Model::Load(uint32_t modelId) {
   return result;
 }
 
+void Model::SortBones() {
+  // Breadth-first from the roots, parents are always visited first
+  bool visited[ModelMaxBonesPerModel] = {};
+  BoneOrderCount = 0;
+  for (int i = 0; i < RootBoneCount; i++) {
+    visited[RootBones[i]] = true;
+    BoneOrder[BoneOrderCount++] = RootBones[i];
+  }
+  for (int i = 0; i < BoneOrderCount; i++) {
+    StaticBone const& bone = Bones[BoneOrder[i]];
+    for (int j = 0; j < bone.ChildrenCount; j++) {
+      const int16_t child = bone.Children[j];
+      if (child < 0 || (uint32_t)child >= BoneCount || visited[child] ||
+          Bones[child].Parent != BoneOrder[i]) {
+        ImpLog(LogLevel::Warning, LogChannel::ModelLoad,
+               "Model {:d} bone {:d} has invalid child {:d}\n", Id,
+               BoneOrder[i], child);
+        continue;
+      }
+      visited[child] = true;
+      BoneOrder[BoneOrderCount++] = child;
+    }
+  }
+}
+
 // WARNING: Breaks with DaSH
 Model* Model::MakePlane() {
   Model* result = new Model;
@@ -673,6 +699,7 @@ Model* Model::MakePlane() {
   result->Bones[0].BaseTransform = Transform();
 
   result->RootBones[0] = 0;
+  result->SortBones();
 
   result->Textures[0].LoadPoliticalCompass();
 
@@ -222,6 +222,11 @@ class Model {
   int32_t RootBoneCount = 0;
   int16_t RootBones[ModelMaxRootBones];
 
+  // Bones reachable from the roots, ordered so that every bone comes after its
+  // parent, so a skeleton can be posed in one pass
+  int32_t BoneOrderCount = 0;
+  int16_t BoneOrder[ModelMaxBonesPerModel];
+
   ankerl::unordered_dense::map<int16_t, ModelAnimation*> Animations;
 
   // These are only filled for DaSH
@@ -237,6 +242,9 @@ class Model {
   std::vector<int32_t> AnimationIds;
   std::vector<std::string_view> AnimationNames;
   uint32_t AnimationCount = 0;
+
+ private:
+  void SortBones();
 };
 
 }  // namespace Impacto
\ No newline at end of file
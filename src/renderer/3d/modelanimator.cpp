@@ -32,10 +32,7 @@ void ModelAnimator::Reset() {
 
   if (CurrentAnimation != 0) {
     for (int i = 0; i < CurrentAnimation->BoneTrackCount; i++) {
-      for (int j = 0; j < BKT_Count; j++) {
-        BoneKeys[i].CurrentKeys[j] = 0;
-        BoneKeys[i].NextKeys[j] = 1;
-      }
+      BoneCursors[i] = 0;
     }
 
     for (int i = 0; i < CurrentAnimation->MeshTrackCount; i++) {
@@ -126,50 +123,8 @@ void ModelAnimator::Update(float dt) {
     CurrentTime += remainder;
   }
 
-  for (int i = 0; i < CurrentAnimation->BoneTrackCount; i++) {
-    BoneTrack* track = &CurrentAnimation->BoneTracks[i];
-    Transform* transform = &Character->CurrentPose[track->Bone].LocalTransform;
-
-    TrackIncrementLoop(BoneKeys, CoordKeyframes, BKT_TranslateX);
-    TrackIncrementLoop(BoneKeys, CoordKeyframes, BKT_TranslateY);
-    TrackIncrementLoop(BoneKeys, CoordKeyframes, BKT_TranslateZ);
-    TrackIncrementLoop(BoneKeys, CoordKeyframes, BKT_ScaleX);
-    TrackIncrementLoop(BoneKeys, CoordKeyframes, BKT_ScaleY);
-    TrackIncrementLoop(BoneKeys, CoordKeyframes, BKT_ScaleZ);
-    TrackIncrementLoop(BoneKeys, QuatKeyframes, BKT_Rotate);
-
-    if (Tweening) {
-      TrackInterpolate(BoneKeys, CoordKeyframes, BKT_TranslateX,
-                       transform->Position.x, mix);
-      TrackInterpolate(BoneKeys, CoordKeyframes, BKT_TranslateY,
-                       transform->Position.y, mix);
-      TrackInterpolate(BoneKeys, CoordKeyframes, BKT_TranslateZ,
-                       transform->Position.z, mix);
-      TrackInterpolate(BoneKeys, CoordKeyframes, BKT_ScaleX, transform->Scale.x,
-                       mix);
-      TrackInterpolate(BoneKeys, CoordKeyframes, BKT_ScaleY, transform->Scale.y,
-                       mix);
-      TrackInterpolate(BoneKeys, CoordKeyframes, BKT_ScaleZ, transform->Scale.z,
-                       mix);
-      TrackInterpolate(BoneKeys, QuatKeyframes, BKT_Rotate, transform->Rotation,
-                       slerp);
-    } else {
-      TrackNoInterpolate(BoneKeys, CoordKeyframes, BKT_TranslateX,
-                         transform->Position.x);
-      TrackNoInterpolate(BoneKeys, CoordKeyframes, BKT_TranslateY,
-                         transform->Position.y);
-      TrackNoInterpolate(BoneKeys, CoordKeyframes, BKT_TranslateZ,
-                         transform->Position.z);
-      TrackNoInterpolate(BoneKeys, CoordKeyframes, BKT_ScaleX,
-                         transform->Scale.x);
-      TrackNoInterpolate(BoneKeys, CoordKeyframes, BKT_ScaleY,
-                         transform->Scale.y);
-      TrackNoInterpolate(BoneKeys, CoordKeyframes, BKT_ScaleZ,
-                         transform->Scale.z);
-      TrackNoInterpolate(BoneKeys, QuatKeyframes, BKT_Rotate,
-                         transform->Rotation);
-    }
-  }
+  CurrentAnimation->SampleBones(CurrentTime, Tweening, BoneCursors,
+                                Character->CurrentPose);
 
   for (int i = 0; i < CurrentAnimation->MeshTrackCount; i++) {
     MeshTrack* track = &CurrentAnimation->MeshTracks[i];
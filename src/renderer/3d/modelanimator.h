@@ -6,11 +6,6 @@ namespace Impacto {
 
 class IRenderable3D;
 
-struct BoneTrackStatus {
-  uint16_t CurrentKeys[BKT_Count];
-  uint16_t NextKeys[BKT_Count];
-};
-
 struct MeshTrackStatus {
   uint16_t CurrentKeys[MKT_Count];
   uint16_t NextKeys[MKT_Count];
@@ -25,7 +20,8 @@ class ModelAnimator {
 
   // Time in seconds
   float CurrentTime = 0;
-  BoneTrackStatus BoneKeys[ModelMaxBonesPerModel];
+  // Per bone track, see ModelAnimation::SampleBones
+  uint32_t BoneCursors[ModelMaxBonesPerModel];
   MeshTrackStatus MeshKeys[ModelMaxMeshesPerModel];
 
   float LoopStart = 0.0f;
@@ -0,0 +1,289 @@
+#include "morphengine.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#include "../../impacto.h"
+#include "../../profile/scene3d.h"
+
+#if IMPACTO_HAVE_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace Impacto {
+
+static_assert(offsetof(VertexBuffer, Position) == 0 &&
+                  offsetof(VertexBuffer, Normal) ==
+                      offsetof(MorphVertexBuffer, Normal) &&
+                  offsetof(VertexBufferDaSH, Position) == 0 &&
+                  offsetof(VertexBufferDaSH, Normal) ==
+                      offsetof(MorphVertexBuffer, Normal),
+              "Vertices must start with their position and normal");
+
+// Below this many vertices to blend in a frame, waking the blend threads costs
+// more than it saves
+static size_t constexpr ParallelMinVertices = 64 * 1024;
+// Blended in blocks of this many floats, so that every target is added to a
+// block while it is still in cache
+static size_t constexpr BlendBlockSize = 1024;
+
+#if IMPACTO_HAVE_THREADS
+// Threads started the first time a frame has enough to blend, which then sleep
+// until the next such frame
+class BlendThreadPool {
+ public:
+  using JobProc = auto (*)(void* context, size_t index) -> void;
+
+  ~BlendThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(Mutex);
+      Stopping = true;
+    }
+    WorkReady.notify_all();
+    for (std::thread& thread : Threads) thread.join();
+  }
+
+  // Runs job for every index below count on the pool and the calling thread,
+  // returns once all of them are done. One batch runs at a time.
+  void Run(size_t count, JobProc job, void* context) {
+    std::lock_guard<std::mutex> runLock(RunMutex);
+    if (Threads.empty()) {
+      const unsigned threadCount =
+          std::max(std::thread::hardware_concurrency(), 2u) - 1;
+      for (unsigned i = 0; i < threadCount; i++) {
+        Threads.emplace_back(&BlendThreadPool::WorkerThread, this);
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(Mutex);
+      Job = job;
+      Context = context;
+      Count = count;
+      NextIndex = 0;
+      BusyThreads = Threads.size();
+      Generation++;
+    }
+    WorkReady.notify_all();
+    Work();
+
+    std::unique_lock<std::mutex> lock(Mutex);
+    Done.wait(lock, [this] { return BusyThreads == 0; });
+  }
+
+ private:
+  void Work() {
+    for (size_t i = NextIndex++; i < Count; i = NextIndex++) Job(Context, i);
+  }
+
+  void WorkerThread() {
+    uint64_t lastGeneration = 0;
+    std::unique_lock<std::mutex> lock(Mutex);
+    while (true) {
+      WorkReady.wait(lock, [&] {
+        return Stopping || Generation != lastGeneration;
+      });
+      if (Stopping) return;
+      lastGeneration = Generation;
+
+      lock.unlock();
+      Work();
+      lock.lock();
+      if (--BusyThreads == 0) Done.notify_one();
+    }
+  }
+
+  std::vector<std::thread> Threads;
+  std::mutex RunMutex;
+
+  std::mutex Mutex;
+  std::condition_variable WorkReady;
+  std::condition_variable Done;
+  bool Stopping = false;
+  uint64_t Generation = 0;
+  size_t BusyThreads = 0;
+
+  JobProc Job = nullptr;
+  void* Context = nullptr;
+  size_t Count = 0;
+  std::atomic<size_t> NextIndex = 0;
+};
+
+static BlendThreadPool BlendThreads;
+#endif
+
+void MorphEngine::Init(Model const* model) {
+  Clear();
+  Meshes.resize(model->MeshCount);
+
+  const size_t vertexStride = Profile::Scene3D::Version == +LKMVersion::DaSH
+                                  ? sizeof(VertexBufferDaSH)
+                                  : sizeof(VertexBuffer);
+
+  size_t outputSize = 0;
+  for (uint32_t i = 0; i < model->MeshCount; i++) {
+    Mesh const& mesh = model->Meshes[i];
+    if (mesh.MorphTargetCount == 0) continue;
+
+    MorphedMesh& morphed = Meshes[i];
+    const size_t n = mesh.VertexCount;
+    morphed.VertexCount = mesh.VertexCount;
+    morphed.TargetCount = mesh.MorphTargetCount;
+    morphed.OutputOffset = outputSize;
+    outputSize += n;
+
+    uint8_t const* baseVertices = (uint8_t const*)model->VertexBuffers +
+                                  mesh.VertexOffset * vertexStride;
+    morphed.Base.resize(StreamCount * n);
+    for (size_t v = 0; v < n; v++) {
+      MorphVertexBuffer const* vertex =
+          (MorphVertexBuffer const*)(baseVertices + v * vertexStride);
+      for (int c = 0; c < 3; c++) {
+        morphed.Base[c * n + v] = vertex->Position[c];
+        morphed.Base[(3 + c) * n + v] = vertex->Normal[c];
+      }
+    }
+
+    morphed.Deltas.resize(morphed.TargetCount * StreamCount * n);
+    for (int k = 0; k < morphed.TargetCount; k++) {
+      MorphVertexBuffer const* target =
+          model->MorphVertexBuffers +
+          model->MorphTargets[mesh.MorphTargetIds[k]].VertexOffset;
+      float* deltas = morphed.Deltas.data() + k * StreamCount * n;
+      for (size_t v = 0; v < n; v++) {
+        for (int c = 0; c < 3; c++) {
+          deltas[c * n + v] = target[v].Position[c] - morphed.Base[c * n + v];
+          deltas[(3 + c) * n + v] =
+              target[v].Normal[c] - morphed.Base[(3 + c) * n + v];
+        }
+      }
+    }
+  }
+
+  // No influences yet, so every mesh starts out as its base
+  Output.resize(outputSize);
+  for (MorphedMesh& mesh : Meshes) {
+    if (mesh.TargetCount == 0) continue;
+    Blend(mesh);
+  }
+}
+
+void MorphEngine::Clear() {
+  Meshes.clear();
+  Output.clear();
+}
+
+void MorphEngine::SetInfluences(int meshId, float const* influences,
+                                float const* prevInfluences, float prevWeight) {
+  MorphedMesh& mesh = Meshes[meshId];
+  const float mix = glm::smoothstep(0.0f, 1.0f, 1.0f - prevWeight);
+  for (int k = 0; k < mesh.TargetCount; k++) {
+    const float influence =
+        prevWeight > 0.0f ? glm::mix(prevInfluences[k], influences[k], mix)
+                          : influences[k];
+    if (influence != mesh.Influences[k]) {
+      mesh.Influences[k] = influence;
+      mesh.Dirty = true;
+    }
+  }
+}
+
+void MorphEngine::Blend(MorphedMesh& mesh) {
+  const size_t n = mesh.VertexCount;
+  const size_t streamsSize = StreamCount * n;
+
+  float weights[ModelMaxMorphTargetsPerMesh];
+  float const* deltas[ModelMaxMorphTargetsPerMesh];
+  int activeTargets = 0;
+  for (int k = 0; k < mesh.TargetCount; k++) {
+    if (mesh.Influences[k] == 0.0f) continue;
+    weights[activeTargets] = mesh.Influences[k];
+    deltas[activeTargets] = mesh.Deltas.data() + k * streamsSize;
+    activeTargets++;
+  }
+
+  thread_local std::vector<float> blended;
+  blended.resize(streamsSize);
+  float* out = blended.data();
+  float const* base = mesh.Base.data();
+
+  for (size_t start = 0; start < streamsSize; start += BlendBlockSize) {
+    const size_t end = std::min(start + BlendBlockSize, streamsSize);
+    std::copy(base + start, base + end, out + start);
+    for (int k = 0; k < activeTargets; k++) {
+      float const* delta = deltas[k];
+      const float weight = weights[k];
+      for (size_t i = start; i < end; i++) out[i] += delta[i] * weight;
+    }
+  }
+
+  MorphVertexBuffer* dest = Output.data() + mesh.OutputOffset;
+  for (size_t v = 0; v < n; v++) {
+    dest[v].Position = glm::vec3(out[v], out[n + v], out[2 * n + v]);
+    dest[v].Normal =
+        glm::vec3(out[3 * n + v], out[4 * n + v], out[5 * n + v]);
+  }
+
+  mesh.Dirty = false;
+  mesh.Version++;
+}
+
+void MorphEngine::BlendDirty(std::span<MorphEngine* const> engines) {
+  struct BlendJob {
+    MorphEngine* Engine;
+    MorphedMesh* Mesh;
+  };
+  std::vector<BlendJob> jobs;
+
+  size_t vertices = 0;
+  for (MorphEngine* engine : engines) {
+    for (MorphedMesh& mesh : engine->Meshes) {
+      if (!mesh.Dirty) continue;
+      jobs.push_back({engine, &mesh});
+      vertices += mesh.VertexCount;
+    }
+  }
+
+#if IMPACTO_HAVE_THREADS
+  const bool parallel = vertices >= ParallelMinVertices && jobs.size() > 1 &&
+                        std::thread::hardware_concurrency() > 1;
+#else
+  const bool parallel = false;
+#endif
+  if (!parallel) {
+    for (BlendJob const& job : jobs) job.Engine->Blend(*job.Mesh);
+    return;
+  }
+
+#if IMPACTO_HAVE_THREADS
+
+  // Largest meshes first, so no thread is left with a big one at the end
+  std::sort(jobs.begin(), jobs.end(),
+            [](BlendJob const& a, BlendJob const& b) {
+              return a.Mesh->VertexCount > b.Mesh->VertexCount;
+            });
+
+  BlendThreads.Run(
+      jobs.size(),
+      [](void* context, size_t index) {
+        BlendJob const& job = static_cast<BlendJob const*>(context)[index];
+        job.Engine->Blend(*job.Mesh);
+      },
+      jobs.data());
+#endif
+}
+
+void MorphEngine::CopyVertices(int meshId, void* dest, size_t stride) const {
+  MorphVertexBuffer const* vertices = Vertices(meshId);
+  uint8_t* out = (uint8_t*)dest;
+  for (uint32_t v = 0; v < Meshes[meshId].VertexCount; v++) {
+    memcpy(out, &vertices[v], sizeof(MorphVertexBuffer));
+    out += stride;
+  }
+}
+
+}  // namespace Impacto
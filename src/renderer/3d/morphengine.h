@@ -0,0 +1,65 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "model.h"
+
+namespace Impacto {
+
+// Blends the morph targets of one model's meshes on the CPU, for every
+// renderer. Each mesh keeps its base vertices once and every morph target as
+// deltas from them, split into one stream per component (position x, y, z,
+// normal x, y, z), so blending accumulates all active targets in a single pass
+// of multiply-adds over plain float arrays.
+class MorphEngine {
+ public:
+  static int constexpr StreamCount = 6;
+
+  void Init(Model const* model);
+  void Clear();
+
+  // Influences of the mesh's morph targets, mixed towards those of the
+  // previous animation while prevWeight is above 0. Meshes are only blended
+  // again when these change.
+  void SetInfluences(int meshId, float const* influences,
+                     float const* prevInfluences, float prevWeight);
+
+  // Blends every mesh whose influences changed. Meshes of several models are
+  // spread over a persistent pool of blend threads when there is enough work.
+  static void BlendDirty(std::span<MorphEngine* const> engines);
+
+  // Blended positions and normals of a mesh with morph targets
+  MorphVertexBuffer const* Vertices(int meshId) const {
+    return Output.data() + Meshes[meshId].OutputOffset;
+  }
+  // Changes every time the blended vertices of the mesh do
+  uint32_t Version(int meshId) const { return Meshes[meshId].Version; }
+
+  // Writes the blended positions and normals over the start of vertices
+  // stride bytes apart, as laid out by VertexBuffer and VertexBufferDaSH
+  void CopyVertices(int meshId, void* dest, size_t stride) const;
+
+ private:
+  struct MorphedMesh {
+    uint32_t VertexCount = 0;
+    uint8_t TargetCount = 0;
+    size_t OutputOffset = 0;
+
+    // StreamCount streams of VertexCount floats
+    std::vector<float> Base;
+    // StreamCount streams of VertexCount floats per target
+    std::vector<float> Deltas;
+
+    float Influences[ModelMaxMorphTargetsPerMesh] = {};
+    bool Dirty = false;
+    uint32_t Version = 0;
+  };
+
+  void Blend(MorphedMesh& mesh);
+
+  std::vector<MorphedMesh> Meshes;
+  std::vector<MorphVertexBuffer> Output;
+};
+
+}  // namespace Impacto
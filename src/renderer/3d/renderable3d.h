@@ -2,6 +2,8 @@
 
 #include "model.h"
 #include "modelanimator.h"
+#include "morphengine.h"
+#include "skeletonposer.h"
 #include "../../loadable.h"
 #include "../3d/scene.h"
 
@@ -65,9 +67,10 @@ class IRenderable3D {
   Model* StaticModel = 0;
 
   // Per-frame results of vertex animation
-  MorphVertexBuffer* CurrentMorphedVertices = 0;
+  MorphEngine Morphs;
   AnimatedMesh MeshAnimStatus[ModelMaxMeshesPerModel];
   PosedBone CurrentPose[ModelMaxBonesPerModel];
+  SkeletonPoser Poser;
   Transform ModelTransform;
   ModelAnimator Animator;
 
@@ -0,0 +1,133 @@
+#include "skeletonposer.h"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "animation.h"
+#include "renderable3d.h"
+
+namespace Impacto {
+
+void SkeletonPoser::Init(Model const* model) {
+  StaticModel = model;
+  PoseAll = true;
+  PosedBones = 0;
+}
+
+void SkeletonPoser::Pose(PosedBone* pose, Transform const* prevTransforms,
+                         float prevWeight) {
+  const float mix = glm::smoothstep(0.0f, 1.0f, 1.0f - prevWeight);
+
+  PosedBones = 0;
+  for (int i = 0; i < StaticModel->BoneOrderCount; i++) {
+    const int16_t id = StaticModel->BoneOrder[i];
+    StaticBone const& bone = StaticModel->Bones[id];
+    PosedBone& posed = pose[id];
+
+    const Transform local =
+        prevWeight > 0.0f
+            ? prevTransforms[id].Interpolate(posed.LocalTransform, mix)
+            : posed.LocalTransform;
+
+    // Parents come first in BoneOrder, so theirs is already up to date
+    Dirty[id] = PoseAll || !(local == Locals[id]) ||
+                (bone.Parent >= 0 && Dirty[bone.Parent]);
+    if (!Dirty[id]) continue;
+
+    Locals[id] = local;
+    posed.World = bone.Parent < 0 ? local.Matrix()
+                                  : pose[bone.Parent].World * local.Matrix();
+    posed.Offset = posed.World * bone.BindInverse;
+    PosedBones++;
+  }
+  PoseAll = false;
+}
+
+// What posing was before SkeletonPoser, as a baseline
+static void PoseRecursive(Model const* model, PosedBone* pose, int16_t id) {
+  StaticBone const& bone = model->Bones[id];
+  PosedBone& posed = pose[id];
+
+  const glm::mat4 parentWorld =
+      bone.Parent < 0 ? glm::mat4(1.0f) : pose[bone.Parent].World;
+  posed.World = parentWorld * posed.LocalTransform.Matrix();
+
+  for (int i = 0; i < bone.ChildrenCount; i++) {
+    PoseRecursive(model, pose, bone.Children[i]);
+  }
+
+  posed.Offset = posed.World * bone.BindInverse;
+}
+
+PoseBenchmarkResult BenchmarkPosing(std::span<uint32_t const> modelIds) {
+  int constexpr frames = 300;
+
+  PoseBenchmarkResult result;
+  result.Frames = frames;
+  std::vector<PosedBone> pose(ModelMaxBonesPerModel);
+  SkeletonPoser poser;
+  int64_t posedBones = 0;
+
+  for (uint32_t modelId : modelIds) {
+    Model* model = Model::Load(modelId);
+    if (!model) continue;
+    result.Models++;
+    result.Bones += model->BoneCount;
+
+    // Stand-in motion for the bones the idle animation would move
+    std::vector<uint16_t> animatedBones;
+    auto idle = model->Animations.find(model->IdleAnimation);
+    if (idle != model->Animations.end()) {
+      for (int i = 0; i < idle->second->BoneTrackCount; i++) {
+        animatedBones.push_back(idle->second->BoneTracks[i].Bone);
+      }
+    }
+    const auto animate = [&](int frame) {
+      const glm::quat wobble = glm::angleAxis(
+          0.1f * std::sin(frame * 0.1f), glm::vec3(0.0f, 1.0f, 0.0f));
+      for (uint16_t bone : animatedBones) {
+        pose[bone].LocalTransform.Rotation =
+            model->Bones[bone].BaseTransform.Rotation * wobble;
+      }
+    };
+
+    for (uint32_t i = 0; i < model->BoneCount; i++) {
+      pose[i].LocalTransform = model->Bones[i].BaseTransform;
+    }
+    for (int frame = 0; frame < frames; frame++) {
+      animate(frame);
+      const auto startTime = std::chrono::steady_clock::now();
+      for (int i = 0; i < model->RootBoneCount; i++) {
+        PoseRecursive(model, pose.data(), model->RootBones[i]);
+      }
+      result.RecursiveSeconds +=
+          std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                        startTime)
+              .count();
+    }
+
+    for (uint32_t i = 0; i < model->BoneCount; i++) {
+      pose[i].LocalTransform = model->Bones[i].BaseTransform;
+    }
+    poser.Init(model);
+    for (int frame = 0; frame < frames; frame++) {
+      animate(frame);
+      const auto startTime = std::chrono::steady_clock::now();
+      poser.Pose(pose.data(), nullptr, 0.0f);
+      result.PoserSeconds += std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - startTime)
+                                 .count();
+      posedBones += poser.PosedBones;
+    }
+
+    delete model;
+  }
+
+  if (result.Models > 0) {
+    result.PosedBones = (int)(posedBones / ((int64_t)result.Models * frames));
+  }
+  return result;
+}
+
+}  // namespace Impacto
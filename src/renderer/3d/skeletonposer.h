@@ -0,0 +1,49 @@
+#pragma once
+
+#include <span>
+
+#include "model.h"
+
+namespace Impacto {
+
+struct PosedBone;
+
+// Computes the world and bindpose offset matrices of a model's bones in one
+// pass over Model::BoneOrder. Bones whose local transform and ancestors are
+// unchanged since the last pose keep their matrices, so a static skeleton (or
+// the static parts of one) only costs a comparison per bone.
+class SkeletonPoser {
+ public:
+  void Init(Model const* model);
+
+  // Local transforms are mixed from prevTransforms while prevWeight is above 0
+  void Pose(PosedBone* pose, Transform const* prevTransforms,
+            float prevWeight);
+
+  // Number of bones whose matrices the last Pose recomputed
+  int PosedBones = 0;
+
+ private:
+  Model const* StaticModel = 0;
+  bool PoseAll = true;
+
+  // Local transform each bone's matrices were last computed from
+  Transform Locals[ModelMaxBonesPerModel];
+  bool Dirty[ModelMaxBonesPerModel];
+};
+
+struct PoseBenchmarkResult {
+  int Models = 0;
+  int Bones = 0;
+  int Frames = 0;
+  double RecursiveSeconds = 0.0;
+  double PoserSeconds = 0.0;
+  // Per model and frame, out of Bones / Models
+  int PosedBones = 0;
+};
+
+// Poses every model's skeleton with its idle animation's bones moving, once
+// walking the hierarchy recursively and once with SkeletonPoser
+PoseBenchmarkResult BenchmarkPosing(std::span<uint32_t const> modelIds);
+
+}  // namespace Impacto
@@ -18,9 +18,11 @@ struct Transform {
   Transform(glm::mat4 const& transformMatrix);
 
   void SetRotationFromEuler(glm::vec3 eulerZYX);
-  glm::mat4 Matrix();
+  glm::mat4 Matrix() const;
 
-  Transform Interpolate(Transform next, float factor);
+  Transform Interpolate(Transform next, float factor) const;
+
+  bool operator==(Transform const& other) const = default;
 
   glm::vec3 Position;
   glm::quat Rotation;
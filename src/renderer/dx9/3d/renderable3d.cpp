@@ -170,6 +170,7 @@ bool Renderable3D::LoadSync(uint32_t modelId) {
 
   InitMeshAnimStatus();
   ReloadDefaultBoneTransforms();
+  Poser.Init(StaticModel);
 
   Animator.Character = this;
   SwitchAnimation(StaticModel->IdleAnimation, 0.0f);
@@ -190,6 +191,7 @@ void Renderable3D::MakePlane() {
 
   InitMeshAnimStatus();
   ReloadDefaultBoneTransforms();
+  Poser.Init(StaticModel);
 
   IsUsed = true;
 }
@@ -212,7 +214,25 @@ void Renderable3D::InitMeshAnimStatus() {
                                  0, D3DPOOL_MANAGED, &MorphedVerticesDevice,
                                  NULL);
     }
+
+    // Only positions and normals get morphed, the rest is copied once
+    const size_t stride = Profile::Scene3D::Version == +LKMVersion::DaSH
+                              ? sizeof(VertexBufferDaSH)
+                              : sizeof(VertexBuffer);
+    void* morphedVertices;
+    MorphedVerticesDevice->Lock(0, 0, &morphedVertices, 0);
+    for (uint32_t i = 0; i < StaticModel->MeshCount; i++) {
+      const Mesh& mesh = StaticModel->Meshes[i];
+      if (mesh.MorphTargetCount == 0) continue;
+      memcpy((uint8_t*)morphedVertices +
+                 MeshAnimStatus[i].MorphedVerticesOffset * stride,
+             (uint8_t*)StaticModel->VertexBuffers + mesh.VertexOffset * stride,
+             mesh.VertexCount * stride);
+    }
+    MorphedVerticesDevice->Unlock();
   }
+  Morphs.Init(StaticModel);
+  memset(UploadedMorphVersions, 0, sizeof(UploadedMorphVersions));
   ReloadDefaultMeshAnimStatus();
 }
 
@@ -247,151 +267,6 @@ void Renderable3D::ReloadDefaultBoneTransforms() {
   }
 }
 
-void Renderable3D::CalculateMorphedVertices(int id) {
-  Mesh* mesh = &StaticModel->Meshes[id];
-  AnimatedMesh* animStatus = &MeshAnimStatus[id];
-  AnimatedMesh* prevAnimStatus = &PrevMeshAnimStatus[id];
-  if (mesh->MorphTargetCount == 0) return;
-
-  void* currentMorphedVertex;
-  auto res = MorphedVerticesDevice->Lock(0, 0, &CurrentMorphedVerticesDx, 0);
-  if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-    currentMorphedVertex = ((VertexBufferDaSH*)CurrentMorphedVerticesDx) +
-                           animStatus->MorphedVerticesOffset;
-  } else {
-    currentMorphedVertex = ((VertexBuffer*)CurrentMorphedVerticesDx) +
-                           animStatus->MorphedVerticesOffset;
-  }
-  VertexBuffer* currentMorphedVertexRNE = (VertexBuffer*)currentMorphedVertex;
-  VertexBufferDaSH* currentMorphedVertexDaSH =
-      (VertexBufferDaSH*)currentMorphedVertex;
-
-  void* currentVertex;
-  if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-    currentVertex =
-        ((VertexBufferDaSH*)StaticModel->VertexBuffers) + mesh->VertexOffset;
-  } else {
-    currentVertex =
-        ((VertexBuffer*)StaticModel->VertexBuffers) + mesh->VertexOffset;
-  }
-
-  VertexBuffer* currentVertexRNE = (VertexBuffer*)currentVertex;
-  VertexBufferDaSH* currentVertexDaSH = (VertexBufferDaSH*)currentVertex;
-
-  for (uint32_t j = 0; j < mesh->VertexCount; j++) {
-    if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-      memcpy(currentMorphedVertexDaSH, currentVertexDaSH,
-             sizeof(VertexBufferDaSH));
-      currentMorphedVertexDaSH++;
-      currentVertexDaSH++;
-    } else {
-      memcpy(currentMorphedVertexRNE, currentVertexRNE, sizeof(VertexBuffer));
-      currentMorphedVertexRNE++;
-      currentVertexRNE++;
-    }
-  }
-
-  for (uint8_t k = 0; k < mesh->MorphTargetCount; k++) {
-    float influence;
-    if (PrevPoseWeight > 0.0f) {
-      influence = glm::mix(prevAnimStatus->MorphInfluences[k],
-                           animStatus->MorphInfluences[k],
-                           glm::smoothstep(0.0f, 1.0f, 1.0f - PrevPoseWeight));
-    } else {
-      influence = animStatus->MorphInfluences[k];
-    }
-
-    if (influence == 0.0f) continue;
-
-    if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-      currentMorphedVertex = ((VertexBufferDaSH*)CurrentMorphedVerticesDx) +
-                             animStatus->MorphedVerticesOffset;
-    } else {
-      currentMorphedVertex = ((VertexBuffer*)CurrentMorphedVerticesDx) +
-                             animStatus->MorphedVerticesOffset;
-    }
-    currentMorphedVertexRNE = (VertexBuffer*)currentMorphedVertex;
-    currentMorphedVertexDaSH = (VertexBufferDaSH*)currentMorphedVertex;
-
-    if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-      currentVertex =
-          ((VertexBufferDaSH*)StaticModel->VertexBuffers) + mesh->VertexOffset;
-    } else {
-      currentVertex =
-          ((VertexBuffer*)StaticModel->VertexBuffers) + mesh->VertexOffset;
-    }
-
-    currentVertexRNE = (VertexBuffer*)currentVertex;
-    currentVertexDaSH = (VertexBufferDaSH*)currentVertex;
-
-    MorphVertexBuffer* currentMorphTargetVbo =
-        StaticModel->MorphVertexBuffers +
-        StaticModel->MorphTargets[mesh->MorphTargetIds[k]].VertexOffset;
-
-    for (uint32_t j = 0; j < mesh->VertexCount; j++) {
-      if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-        currentMorphedVertexDaSH->Position +=
-            (currentMorphTargetVbo->Position - currentVertexDaSH->Position) *
-            influence;
-        currentMorphedVertexDaSH->Normal +=
-            (currentMorphTargetVbo->Normal - currentVertexDaSH->Normal) *
-            influence;
-        currentVertexDaSH++;
-        currentMorphedVertexDaSH++;
-      } else {
-        currentMorphedVertexRNE->Position +=
-            (currentMorphTargetVbo->Position - currentVertexRNE->Position) *
-            influence;
-        currentMorphedVertexRNE->Normal +=
-            (currentMorphTargetVbo->Normal - currentVertexRNE->Normal) *
-            influence;
-        currentVertexRNE++;
-        currentMorphedVertexRNE++;
-      }
-      currentMorphTargetVbo++;
-    }
-  }
-
-  res = MorphedVerticesDevice->Unlock();
-}
-
-void Renderable3D::Pose() {
-  for (int i = 0; i < StaticModel->RootBoneCount; i++) {
-    PoseBone(StaticModel->RootBones[i]);
-  }
-}
-
-void Renderable3D::PoseBone(int16_t id) {
-  StaticBone* bone = &StaticModel->Bones[id];
-  PosedBone* transformed = &CurrentPose[id];
-
-  glm::mat4 parentWorld;
-  if (bone->Parent < 0) {
-    parentWorld = glm::mat4(1.0);
-  } else {
-    parentWorld = CurrentPose[bone->Parent].World;
-  }
-
-  Transform transform;
-  if (PrevPoseWeight > 0.0f) {
-    transform = PrevBoneTransforms[id].Interpolate(
-        transformed->LocalTransform,
-        glm::smoothstep(0.0f, 1.0f, 1.0f - PrevPoseWeight));
-  } else {
-    transform = transformed->LocalTransform;
-  }
-
-  glm::mat4 local = transform.Matrix();
-
-  transformed->World = parentWorld * local;
-
-  for (int i = 0; i < bone->ChildrenCount; i++) {
-    PoseBone(bone->Children[i]);
-  }
-
-  transformed->Offset = transformed->World * bone->BindInverse;
-}
-
 void Renderable3D::Update(float dt) {
   if (!IsUsed) return;
   if (Animator.CurrentAnimation) {
@@ -402,14 +277,15 @@ void Renderable3D::Update(float dt) {
       Animator.Update(dt);
     }
   }
-  Pose();
+  Poser.Pose(CurrentPose, PrevBoneTransforms, PrevPoseWeight);
   if (PrevPoseWeight > 0.0f) {
     PrevPoseWeight -= dt / AnimationTransitionTime;
     if (PrevPoseWeight < 0.0f) PrevPoseWeight = 0.0f;
   }
 
   for (uint32_t i = 0; i < StaticModel->MeshCount; i++) {
-    CalculateMorphedVertices(i);
+    Morphs.SetInfluences(i, MeshAnimStatus[i].MorphInfluences,
+                         PrevMeshAnimStatus[i].MorphInfluences, PrevPoseWeight);
   }
 }
 
@@ -496,6 +372,16 @@ void Renderable3D::DrawMesh(int id, RenderPass pass) {
     stride = sizeof(BgVertexBuffer);
 
   if (StaticModel->Meshes[id].MorphTargetCount > 0) {
+    if (UploadedMorphVersions[id] != Morphs.Version(id)) {
+      const UINT offset =
+          (UINT)(MeshAnimStatus[id].MorphedVerticesOffset * stride);
+      void* morphedVertices;
+      MorphedVerticesDevice->Lock(offset, (UINT)(mesh.VertexCount * stride),
+                                  &morphedVertices, 0);
+      Morphs.CopyVertices(id, morphedVertices, stride);
+      MorphedVerticesDevice->Unlock();
+      UploadedMorphVersions[id] = Morphs.Version(id);
+    }
     Device->SetStreamSource(
         0, MorphedVerticesDevice,
         (UINT)(MeshAnimStatus[id].MorphedVerticesOffset * stride),
@@ -654,10 +540,7 @@ void Renderable3D::UnloadSync() {
   if (MorphedVerticesDevice) {
     MorphedVerticesDevice->Release();
   }
-  if (CurrentMorphedVertices) {
-    free(CurrentMorphedVertices);
-    CurrentMorphedVertices = 0;
-  }
+  Morphs.Clear();
   ModelTransform = Transform();
   IsSubmitted = false;
   IsUsed = false;
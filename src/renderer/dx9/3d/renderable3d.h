@@ -60,11 +60,6 @@ class Renderable3D : public IRenderable3D {
  private:
   void SetSceneUniformValues();
 
-  void Pose();
-  void PoseBone(int16_t id);
-
-  void CalculateMorphedVertices(int id);
-
   void UseMaterial(MaterialType type);
   void UseMesh(int id);
   void LoadModelUniforms();
@@ -75,8 +70,8 @@ class Renderable3D : public IRenderable3D {
   IDirect3DVertexBuffer9* MeshVertexBuffersDevice[ModelMaxMeshesPerModel];
   IDirect3DIndexBuffer9* MeshIndexBuffersDevice[ModelMaxMeshesPerModel];
 
-  void* CurrentMorphedVerticesDx;
   IDirect3DVertexBuffer9* MorphedVerticesDevice;
+  uint32_t UploadedMorphVersions[ModelMaxMeshesPerModel];
 
   uint32_t TexBuffers[ModelMaxTexturesPerModel];
 
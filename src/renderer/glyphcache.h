@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Impacto {
+
+class Font;
+struct SpriteSheet;
+
+enum class RendererOutlineMode { None, BottomRight, Full };
+
+struct VertexBufferSprites {
+  glm::vec2 Position = {0.0f, 0.0f};
+  glm::vec2 UV = {0.0f, 0.0f};
+  glm::vec4 Tint = glm::vec4(1.0f);
+  glm::vec2 MaskUV = {0.0f, 0.0f};
+};
+
+// Per draw parameters of the signed distance field text shaders, see SDFFont
+struct SDFTextParams {
+  bool operator==(const SDFTextParams& other) const = default;
+
+  glm::vec4 OutlineColor = glm::vec4(0.0f);
+  // Where the outline is sampled relative to the glyph, in UV space
+  glm::vec2 OutlineOffset = {0.0f, 0.0f};
+  // Distance value of the outline's outer edge, 0.5 follows the glyph's edge
+  float OutlineEdge = 0.5f;
+  // Applied on top of the vertex tints, which for SDF fonts only carry each
+  // glyph's own opacity
+  float Opacity = 1.0f;
+};
+
+// Quads of a run of processed text, baked once per layout so that redrawing
+// static text doesn't have to go through the font again. Per frame only the
+// alpha of glyphs whose opacity changed since the last draw is rewritten, so a
+// fully opaque page is submitted as is.
+struct GlyphQuadCache {
+  // Layout generation the quads were baked for, 0 if they are stale
+  uint32_t Generation = 0;
+
+  const Font* BakedFont = nullptr;
+  const SpriteSheet* MaskedSheet = nullptr;
+  RendererOutlineMode OutlineMode = RendererOutlineMode::None;
+  bool SmoothstepGlyphOpacity = true;
+  glm::vec2 WindowDimensions = {0.0f, 0.0f};
+
+  size_t GlyphCount = 0;
+  // One block of GlyphCount quads per outline pass, followed by the foreground
+  size_t OutlinePasses = 0;
+  std::vector<VertexBufferSprites> Vertices;
+  std::vector<uint16_t> Indices;
+
+  // SDF fonts draw their outline in the same quad as the glyph with the
+  // outline color as a shader parameter, so each run of glyphs sharing an
+  // outline color is its own draw
+  struct OutlineRun {
+    size_t FirstGlyph;
+    glm::vec4 Color;
+  };
+  std::vector<OutlineRun> OutlineRuns;
+
+  // Opacities the baked tints currently reflect
+  std::vector<float> GlyphOpacities;
+  float Opacity = -1.0f;
+  float OutlineOpacity = -1.0f;
+
+  void Invalidate() { Generation = 0; }
+  void Translate(glm::vec2 offset);
+};
+
+}  // namespace Impacto
@@ -234,6 +234,7 @@ bool Renderable3D::LoadSync(uint32_t modelId) {
 
   InitMeshAnimStatus();
   ReloadDefaultBoneTransforms();
+  Poser.Init(StaticModel);
 
   Animator.Character = this;
   SwitchAnimation(StaticModel->IdleAnimation, 0.0f);
@@ -254,6 +255,7 @@ void Renderable3D::MakePlane() {
 
   InitMeshAnimStatus();
   ReloadDefaultBoneTransforms();
+  Poser.Init(StaticModel);
 
   IsUsed = true;
 }
@@ -266,8 +268,8 @@ void Renderable3D::InitMeshAnimStatus() {
       totalMorphedVertices += StaticModel->Meshes[i].VertexCount;
     }
   }
-  CurrentMorphedVertices = (MorphVertexBuffer*)malloc(
-      totalMorphedVertices * sizeof(MorphVertexBuffer));
+  Morphs.Init(StaticModel);
+  memset(UploadedMorphVersions, 0, sizeof(UploadedMorphVersions));
   ReloadDefaultMeshAnimStatus();
 }
 
@@ -302,131 +304,6 @@ void Renderable3D::ReloadDefaultBoneTransforms() {
   }
 }
 
-void Renderable3D::CalculateMorphedVertices(int id) {
-  Mesh* mesh = &StaticModel->Meshes[id];
-  AnimatedMesh* animStatus = &MeshAnimStatus[id];
-  AnimatedMesh* prevAnimStatus = &PrevMeshAnimStatus[id];
-  if (mesh->MorphTargetCount == 0) return;
-
-  MorphVertexBuffer* currentMorphedVertex =
-      CurrentMorphedVertices + animStatus->MorphedVerticesOffset;
-
-  void* currentVertex;
-  if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-    currentVertex =
-        ((VertexBufferDaSH*)StaticModel->VertexBuffers) + mesh->VertexOffset;
-  } else {
-    currentVertex =
-        ((VertexBuffer*)StaticModel->VertexBuffers) + mesh->VertexOffset;
-  }
-
-  VertexBuffer* currentVertexRNE = (VertexBuffer*)currentVertex;
-  VertexBufferDaSH* currentVertexDaSH = (VertexBufferDaSH*)currentVertex;
-
-  for (uint32_t j = 0; j < mesh->VertexCount; j++) {
-    if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-      currentMorphedVertex->Position = currentVertexDaSH->Position;
-      currentMorphedVertex->Normal = currentVertexDaSH->Normal;
-      currentVertexDaSH++;
-    } else {
-      currentMorphedVertex->Position = currentVertexRNE->Position;
-      currentMorphedVertex->Normal = currentVertexRNE->Normal;
-      currentVertexRNE++;
-    }
-    currentMorphedVertex++;
-  }
-
-  for (int k = 0; k < mesh->MorphTargetCount; k++) {
-    float influence;
-    if (PrevPoseWeight > 0.0f) {
-      influence = glm::mix(prevAnimStatus->MorphInfluences[k],
-                           animStatus->MorphInfluences[k],
-                           glm::smoothstep(0.0f, 1.0f, 1.0f - PrevPoseWeight));
-    } else {
-      influence = animStatus->MorphInfluences[k];
-    }
-
-    if (influence == 0.0f) continue;
-
-    currentMorphedVertex =
-        CurrentMorphedVertices + animStatus->MorphedVerticesOffset;
-
-    if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-      currentVertex =
-          ((VertexBufferDaSH*)StaticModel->VertexBuffers) + mesh->VertexOffset;
-    } else {
-      currentVertex =
-          ((VertexBuffer*)StaticModel->VertexBuffers) + mesh->VertexOffset;
-    }
-
-    currentVertexRNE = (VertexBuffer*)currentVertex;
-    currentVertexDaSH = (VertexBufferDaSH*)currentVertex;
-
-    MorphVertexBuffer* currentMorphTargetVbo =
-        StaticModel->MorphVertexBuffers +
-        StaticModel->MorphTargets[mesh->MorphTargetIds[k]].VertexOffset;
-
-    for (uint32_t j = 0; j < mesh->VertexCount; j++) {
-      if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-        currentMorphedVertex->Position +=
-            (currentMorphTargetVbo->Position - currentVertexDaSH->Position) *
-            influence;
-        currentMorphedVertex->Normal +=
-            (currentMorphTargetVbo->Normal - currentVertexDaSH->Normal) *
-            influence;
-        currentVertexDaSH++;
-      } else {
-        currentMorphedVertex->Position +=
-            (currentMorphTargetVbo->Position - currentVertexRNE->Position) *
-            influence;
-        currentMorphedVertex->Normal +=
-            (currentMorphTargetVbo->Normal - currentVertexRNE->Normal) *
-            influence;
-        currentVertexRNE++;
-      }
-      currentMorphedVertex++;
-      currentMorphTargetVbo++;
-    }
-  }
-}
-
-void Renderable3D::Pose() {
-  for (int i = 0; i < StaticModel->RootBoneCount; i++) {
-    PoseBone(StaticModel->RootBones[i]);
-  }
-}
-
-void Renderable3D::PoseBone(int16_t id) {
-  StaticBone* bone = &StaticModel->Bones[id];
-  PosedBone* transformed = &CurrentPose[id];
-
-  glm::mat4 parentWorld;
-  if (bone->Parent < 0) {
-    parentWorld = glm::mat4(1.0);
-  } else {
-    parentWorld = CurrentPose[bone->Parent].World;
-  }
-
-  Transform transform;
-  if (PrevPoseWeight > 0.0f) {
-    transform = PrevBoneTransforms[id].Interpolate(
-        transformed->LocalTransform,
-        glm::smoothstep(0.0f, 1.0f, 1.0f - PrevPoseWeight));
-  } else {
-    transform = transformed->LocalTransform;
-  }
-
-  glm::mat4 local = transform.Matrix();
-
-  transformed->World = parentWorld * local;
-
-  for (int i = 0; i < bone->ChildrenCount; i++) {
-    PoseBone(bone->Children[i]);
-  }
-
-  transformed->Offset = transformed->World * bone->BindInverse;
-}
-
 void Renderable3D::Update(float dt) {
   if (!IsUsed) return;
   if (Animator.CurrentAnimation) {
@@ -437,14 +314,15 @@ void Renderable3D::Update(float dt) {
       Animator.Update(dt);
     }
   }
-  Pose();
+  Poser.Pose(CurrentPose, PrevBoneTransforms, PrevPoseWeight);
   if (PrevPoseWeight > 0.0f) {
     PrevPoseWeight -= dt / AnimationTransitionTime;
     if (PrevPoseWeight < 0.0f) PrevPoseWeight = 0.0f;
   }
 
   for (uint32_t i = 0; i < StaticModel->MeshCount; i++) {
-    CalculateMorphedVertices(i);
+    Morphs.SetInfluences(i, MeshAnimStatus[i].MorphInfluences,
+                         PrevMeshAnimStatus[i].MorphInfluences, PrevPoseWeight);
   }
 }
 
@@ -548,7 +426,6 @@ void Renderable3D::Render() {
 
   LoadModelUniforms();
 
-  memset(VAOsUpdated, 0, sizeof(VAOsUpdated));
   memset(UniformsUpdated, 0, sizeof(UniformsUpdated));
 
   for (uint32_t i = RP_First; i < RP_Count; i++) {
@@ -648,21 +525,18 @@ void Renderable3D::UseMesh(int id) {
 
   LoadMeshUniforms(id);
 
-  if (!VAOsUpdated[id]) {
-    if (StaticModel->Meshes[id].MorphTargetCount > 0) {
-      glBindBuffer(GL_ARRAY_BUFFER, MorphVBOs[id]);
-      glBufferData(
-          GL_ARRAY_BUFFER,
-          sizeof(MorphVertexBuffer) * StaticModel->Meshes[id].VertexCount,
-          CurrentMorphedVertices + MeshAnimStatus[id].MorphedVerticesOffset,
-          GL_DYNAMIC_DRAW);
-      glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MorphVertexBuffer),
-                            (void*)offsetof(MorphVertexBuffer, Position));
-      glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MorphVertexBuffer),
-                            (void*)offsetof(MorphVertexBuffer, Normal));
-    }
-
-    VAOsUpdated[id] = true;
+  if (StaticModel->Meshes[id].MorphTargetCount > 0 &&
+      UploadedMorphVersions[id] != Morphs.Version(id)) {
+    glBindBuffer(GL_ARRAY_BUFFER, MorphVBOs[id]);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        sizeof(MorphVertexBuffer) * StaticModel->Meshes[id].VertexCount,
+        Morphs.Vertices(id), GL_DYNAMIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MorphVertexBuffer),
+                          (void*)offsetof(MorphVertexBuffer, Position));
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MorphVertexBuffer),
+                          (void*)offsetof(MorphVertexBuffer, Normal));
+    UploadedMorphVersions[id] = Morphs.Version(id);
   }
 }
 
@@ -723,10 +597,7 @@ void Renderable3D::UnloadSync() {
     delete StaticModel;
     StaticModel = 0;
   }
-  if (CurrentMorphedVertices) {
-    free(CurrentMorphedVertices);
-    CurrentMorphedVertices = 0;
-  }
+  Morphs.Clear();
   ModelTransform = Transform();
   IsSubmitted = false;
   IsUsed = false;
@@ -32,11 +32,6 @@ class Renderable3D : public IRenderable3D {
   void MainThreadOnLoad() override;
 
  private:
-  void Pose();
-  void PoseBone(int16_t id);
-
-  void CalculateMorphedVertices(int id);
-
   void UseMaterial(MaterialType type);
   void UseMesh(int id);
   void LoadModelUniforms();
@@ -54,7 +49,7 @@ class Renderable3D : public IRenderable3D {
 
   GLuint TexBuffers[ModelMaxTexturesPerModel];
 
-  bool VAOsUpdated[ModelMaxMeshesPerModel];
+  uint32_t UploadedMorphVersions[ModelMaxMeshesPerModel];
   bool UniformsUpdated[ModelMaxMeshesPerModel];
 
   Transform PrevBoneTransforms[ModelMaxBonesPerModel];
@@ -33,14 +33,82 @@ void Renderer::Init() {
   // Generate buffers
   glGenBuffers(1, &VBO);
   glGenBuffers(1, &IBO);
+  glGenBuffers(1, &QuadIBO);
   glGenVertexArrays(1, &VAOSprites);
 
   GLC::InitializeFramebuffers();
 
-  // Specify vertex layouts
   glBindVertexArray(VAOSprites);
+
+  // Every quad shares the same index pattern relative to its first vertex
+  std::vector<uint16_t> quadIndices(QuadIndexCount);
+  for (size_t quad = 0; quad < QuadIndexCount / 6; quad++) {
+    const uint16_t base = (uint16_t)(quad * 4);
+    const std::array<uint16_t, 6> pattern = {
+        base, (uint16_t)(base + 1), (uint16_t)(base + 2),
+        base, (uint16_t)(base + 2), (uint16_t)(base + 3)};
+    std::copy(pattern.begin(), pattern.end(), quadIndices.begin() + quad * 6);
+  }
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, QuadIBO);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, quadIndices.size() * sizeof(uint16_t),
+               quadIndices.data(), GL_STATIC_DRAW);
+
+  // Set up the streaming ring
+  const GLsizeiptr vertexRingSize =
+      RingSegmentCount * MaxVertexCount * sizeof(VertexBufferSprites);
+  const GLsizeiptr indexRingSize =
+      RingSegmentCount * MaxIndexCount * sizeof(uint16_t);
+
+  PersistentMapping =
+      ActualGraphicsApi == GfxApi_GL && GLAD_GL_ARB_buffer_storage;
+  if (PersistentMapping) {
+    const GLbitfield flags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferStorage(GL_ARRAY_BUFFER, vertexRingSize, nullptr, flags);
+    MappedVertices = (VertexBufferSprites*)glMapBufferRange(
+        GL_ARRAY_BUFFER, 0, vertexRingSize, flags);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+    glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, indexRingSize, nullptr, flags);
+    MappedIndices = (uint16_t*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0,
+                                                indexRingSize, flags);
+
+    if (MappedVertices == nullptr || MappedIndices == nullptr) {
+      ImpLog(LogLevel::Warning, LogChannel::Render,
+             "Failed to persistently map sprite buffers, falling back to "
+             "buffer uploads\n");
+      PersistentMapping = false;
+      MappedVertices = nullptr;
+      MappedIndices = nullptr;
+
+      // Immutable storage can't be respecified, start over with new buffers
+      glDeleteBuffers(1, &VBO);
+      glDeleteBuffers(1, &IBO);
+      glGenBuffers(1, &VBO);
+      glGenBuffers(1, &IBO);
+    }
+  }
+
+  if (!PersistentMapping) {
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertexRingSize, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexRingSize, nullptr,
+                 GL_STREAM_DRAW);
+
+    VertexStaging.resize(MaxVertexCount);
+    IndexStaging.resize(MaxIndexCount);
+  }
+
+  ImpLog(LogLevel::Debug, LogChannel::Render,
+         "Sprite batcher using {:s}\n",
+         PersistentMapping ? "persistently mapped ring buffers"
+                           : "ring buffer uploads");
+
+  // Specify vertex layouts
   glBindBuffer(GL_ARRAY_BUFFER, VBO);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
   glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(VertexBufferSprites),
                         (void*)offsetof(VertexBufferSprites, Position));
   glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(VertexBufferSprites),
@@ -85,6 +153,13 @@ void Renderer::Init() {
   CCMessageBoxShaderProgram.emplace(Shaders.Compile("CCMessageBoxSprite"));
   CHLCCMenuBackgroundShaderProgram.emplace(
       Shaders.Compile("CHLCCMenuBackground"));
+  SDFTextShaderProgram.emplace(Shaders.Compile("SDFText"));
+  {
+    ShaderParamMap maskedParams;
+    maskedParams["IS_MASKED"] = ShaderParameter(1, true);
+    MaskedSDFTextShaderProgram.emplace(
+        Shaders.Compile("SDFText", maskedParams));
+  }
 
   glGenSamplers((GLsizei)Samplers.size(), Samplers.data());
   for (size_t i = 0; i < TextureUnitCount; i++) {
@@ -99,14 +174,37 @@ void Renderer::Init() {
     glSamplerParameteri(Samplers[i], GL_TEXTURE_MAX_ANISOTROPY, 16);
   }
 
+  // Videos drawn downscaled sample their mip chain, nearest level so mild
+  // downscales stay as sharp as plain bilinear filtering
+  glGenSamplers(1, &VideoMipmapSampler);
+  glSamplerParameteri(VideoMipmapSampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glSamplerParameteri(VideoMipmapSampler, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glSamplerParameteri(VideoMipmapSampler, GL_TEXTURE_MIN_FILTER,
+                      GL_LINEAR_MIPMAP_NEAREST);
+  glSamplerParameteri(VideoMipmapSampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
   glActiveTexture(GL_TEXTURE0);
   glBindSampler(0, Samplers[0]);
 }
 
 void Renderer::Shutdown() {
   if (!IsInit) return;
+  for (GLsync& fence : SegmentFences) {
+    if (fence) glDeleteSync(fence);
+    fence = nullptr;
+  }
+  if (PersistentMapping) {
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindVertexArray(VAOSprites);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+    glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+    MappedVertices = nullptr;
+    MappedIndices = nullptr;
+  }
   if (VBO) glDeleteBuffers(1, &VBO);
   if (IBO) glDeleteBuffers(1, &IBO);
+  if (QuadIBO) glDeleteBuffers(1, &QuadIBO);
   if (VAOSprites) glDeleteVertexArrays(1, &VAOSprites);
   if (RectSprite.Sheet.Texture) glDeleteTextures(1, &RectSprite.Sheet.Texture);
   IsInit = false;
@@ -118,7 +216,13 @@ void Renderer::Shutdown() {
   glDeleteRenderbuffers((GLsizei)GLC::StencilBuffers.size(),
                         GLC::StencilBuffers.data());
 
+  for (size_t layer = 0; layer < CachedLayers.size(); layer++) {
+    FreeCachedLayer((uint32_t)layer + 1);
+  }
+  CachedLayers.clear();
+
   glDeleteSamplers((GLsizei)Samplers.size(), Samplers.data());
+  glDeleteSamplers(1, &VideoMipmapSampler);
 
   if (Profile::GameFeatures & GameFeature::Scene3D) {
     Scene->Shutdown();
@@ -144,9 +248,7 @@ void Renderer::BeginFrame2D() {
 
   Drawing = true;
 
-  VertexBuffer.clear();
-  IndexBuffer.clear();
-  NextFreeIndex = 0;
+  CurrentBatchMode = BatchMode::Quads;
 
   glDisable(GL_CULL_FACE);
 
@@ -156,6 +258,7 @@ void Renderer::BeginFrame2D() {
 void Renderer::EndFrame() {
   if (!Drawing) return;
   Flush();
+  NextRingSegment();
   Drawing = false;
 
   glBindSampler(0, 0);
@@ -247,55 +350,73 @@ void Renderer::InsertVertices(
     const std::span<const VertexBufferSprites> vertices,
     const std::span<const uint16_t> indices) {
   if (vertices.empty() || indices.empty()) return;
+  assert(vertices.size() <= MaxVertexCount);
   assert(indices.size() <= MaxIndexCount);
 
-  if (IndexBuffer.size() + indices.size() > MaxIndexCount) Flush();
+  if (CurrentBatchMode != BatchMode::Indexed) {
+    DrawBatch();
+    CurrentBatchMode = BatchMode::Indexed;
+  }
 
-  const uint16_t maxIndex = *std::max_element(indices.begin(), indices.end());
+  if (VertexCount + vertices.size() > MaxVertexCount ||
+      IndexCount + indices.size() > MaxIndexCount) {
+    DrawBatch();
+    NextRingSegment();
+  }
 
-  VertexBuffer.insert(VertexBuffer.end(), vertices.begin(), vertices.end());
+  std::copy(vertices.begin(), vertices.end(), SegmentVertices() + VertexCount);
 
-  IndexBuffer.reserve(IndexBuffer.size() + indices.size());
-  std::transform(
-      indices.begin(), indices.end(), std::back_inserter(IndexBuffer),
-      [this](uint16_t index) { return index + this->NextFreeIndex; });
+  // Indices are relative to the first vertex of the batch
+  const uint16_t baseIndex = (uint16_t)(VertexCount - BatchVertexStart);
+  uint16_t* const indexDest = SegmentIndices() + IndexCount;
+  for (size_t i = 0; i < indices.size(); i++) {
+    indexDest[i] = indices[i] + baseIndex;
+  }
 
-  NextFreeIndex += maxIndex + 1;
+  VertexCount += vertices.size();
+  IndexCount += indices.size();
 }
 
 void Renderer::InsertVerticesQuad(const CornersQuad pos, const CornersQuad uv,
                                   const std::span<const glm::vec4, 4> tints,
                                   const CornersQuad maskUV) {
-  const std::array<const VertexBufferSprites, 4> vertices = {
-      VertexBufferSprites{
-          .Position = pos.BottomLeft,
-          .UV = uv.BottomLeft,
-          .Tint = tints[0],
-          .MaskUV = maskUV.BottomLeft,
-      },
-      VertexBufferSprites{
-          .Position = pos.TopLeft,
-          .UV = uv.TopLeft,
-          .Tint = tints[1],
-          .MaskUV = maskUV.TopLeft,
-      },
-      VertexBufferSprites{
-          .Position = pos.TopRight,
-          .UV = uv.TopRight,
-          .Tint = tints[2],
-          .MaskUV = maskUV.TopRight,
-      },
-      VertexBufferSprites{
-          .Position = pos.BottomRight,
-          .UV = uv.BottomRight,
-          .Tint = tints[3],
-          .MaskUV = maskUV.BottomRight,
-      },
-  };
+  if (CurrentBatchMode != BatchMode::Quads) {
+    DrawBatch();
+    CurrentBatchMode = BatchMode::Quads;
+  }
 
-  const std::array<const uint16_t, 6> indices = {0, 1, 2, 0, 2, 3};
+  if (VertexCount + 4 > MaxVertexCount) {
+    DrawBatch();
+    NextRingSegment();
+  }
 
-  InsertVertices(vertices, indices);
+  VertexBufferSprites* const vertices = SegmentVertices() + VertexCount;
+  vertices[0] = VertexBufferSprites{
+      .Position = pos.BottomLeft,
+      .UV = uv.BottomLeft,
+      .Tint = tints[0],
+      .MaskUV = maskUV.BottomLeft,
+  };
+  vertices[1] = VertexBufferSprites{
+      .Position = pos.TopLeft,
+      .UV = uv.TopLeft,
+      .Tint = tints[1],
+      .MaskUV = maskUV.TopLeft,
+  };
+  vertices[2] = VertexBufferSprites{
+      .Position = pos.TopRight,
+      .UV = uv.TopRight,
+      .Tint = tints[2],
+      .MaskUV = maskUV.TopRight,
+  };
+  vertices[3] = VertexBufferSprites{
+      .Position = pos.BottomRight,
+      .UV = uv.BottomRight,
+      .Tint = tints[3],
+      .MaskUV = maskUV.BottomRight,
+  };
+
+  VertexCount += 4;
 }
 
 void Renderer::UseTextures(
@@ -698,6 +819,45 @@ void Renderer::DrawVertices(const SpriteSheet& sheet,
   InsertVertices(transformedVertices, indices);
 }
 
+void Renderer::DrawSDFText(const SpriteSheet& sheet,
+                           const SpriteSheet* const mask,
+                           const std::span<const VertexBufferSprites> vertices,
+                           const std::span<const uint16_t> indices,
+                           const SDFTextParams& params) {
+  if (!Drawing) {
+    ImpLog(LogLevel::Error, LogChannel::Render,
+           "Renderer->DrawSDFText() called before BeginFrame()\n");
+    return;
+  }
+
+  SDFTextUniforms uniforms{
+      .Projection = Projection,
+      .SpriteTransformation = glm::mat4(1.0f),
+      .MaskTransformation = glm::mat4(1.0f),
+      .ColorMap = 0,
+      .Mask = 2,
+      .OutlineColor = params.OutlineColor,
+      .OutlineOffset = params.OutlineOffset,
+      .OutlineEdge = params.OutlineEdge,
+      .Opacity = params.Opacity,
+  };
+
+  if (mask == nullptr) {
+    UseShader(*SDFTextShaderProgram, uniforms);
+    UseTextures(std::array<std::pair<uint32_t, size_t>, 1>{
+        std::pair{sheet.Texture, 0},
+    });
+  } else {
+    UseShader(*MaskedSDFTextShaderProgram, uniforms);
+    UseTextures(std::array<std::pair<uint32_t, size_t>, 2>{
+        std::pair{sheet.Texture, 0},
+        std::pair{mask->Texture, 2},
+    });
+  }
+
+  InsertVertices(vertices, indices);
+}
+
 void Renderer::DrawCCMessageBox(Sprite const& sprite, Sprite const& mask,
                                 RectF const& dest, glm::vec4 tint, int alpha,
                                 int fadeRange, float effectCt) {
@@ -774,25 +934,94 @@ void Renderer::Flush() {
            "Renderer->Flush() called before BeginFrame()\n");
     return;
   }
-  if (!VertexBuffer.empty() && !IndexBuffer.empty()) {
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER,
-                 VertexBuffer.size() * sizeof(VertexBufferSprites),
-                 VertexBuffer.data(), GL_DYNAMIC_DRAW);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, IndexBuffer.size() * sizeof(uint16_t),
-                 IndexBuffer.data(), GL_DYNAMIC_DRAW);
+  DrawBatch();
+  FlushTextures();
+}
+
+void Renderer::DrawBatch() {
+  const size_t batchVertexCount = VertexCount - BatchVertexStart;
+  if (batchVertexCount == 0) return;
+
+  glBindVertexArray(VAOSprites);
+  glBindBuffer(GL_ARRAY_BUFFER, VBO);
 
-    glDrawElements(GL_TRIANGLES, (GLsizei)IndexBuffer.size(), GL_UNSIGNED_SHORT,
-                   0);
+  const size_t vertexOffset =
+      (CurrentSegment * MaxVertexCount + BatchVertexStart) *
+      sizeof(VertexBufferSprites);
+  if (!PersistentMapping) {
+    glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)vertexOffset,
+                    batchVertexCount * sizeof(VertexBufferSprites),
+                    VertexStaging.data() + BatchVertexStart);
   }
 
-  VertexBuffer.clear();
-  IndexBuffer.clear();
-  NextFreeIndex = 0;
+  // Point the attributes at the start of the batch so indices stay relative
+  // to it (no glDrawElementsBaseVertex on GLES 3.0/WebGL 2)
+  glVertexAttribPointer(
+      0, 2, GL_FLOAT, GL_FALSE, sizeof(VertexBufferSprites),
+      (void*)(vertexOffset + offsetof(VertexBufferSprites, Position)));
+  glVertexAttribPointer(
+      1, 2, GL_FLOAT, GL_FALSE, sizeof(VertexBufferSprites),
+      (void*)(vertexOffset + offsetof(VertexBufferSprites, UV)));
+  glVertexAttribPointer(
+      2, 4, GL_FLOAT, GL_FALSE, sizeof(VertexBufferSprites),
+      (void*)(vertexOffset + offsetof(VertexBufferSprites, Tint)));
+  glVertexAttribPointer(
+      3, 2, GL_FLOAT, GL_FALSE, sizeof(VertexBufferSprites),
+      (void*)(vertexOffset + offsetof(VertexBufferSprites, MaskUV)));
+
+  switch (CurrentBatchMode) {
+    case BatchMode::Quads: {
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, QuadIBO);
+      glDrawElements(GL_TRIANGLES, (GLsizei)(batchVertexCount / 4 * 6),
+                     GL_UNSIGNED_SHORT, 0);
+    } break;
 
-  FlushTextures();
+    case BatchMode::Indexed: {
+      const size_t batchIndexCount = IndexCount - BatchIndexStart;
+      const size_t indexOffset =
+          (CurrentSegment * MaxIndexCount + BatchIndexStart) * sizeof(uint16_t);
+
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+      if (!PersistentMapping) {
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)indexOffset,
+                        batchIndexCount * sizeof(uint16_t),
+                        IndexStaging.data() + BatchIndexStart);
+      }
+      glDrawElements(GL_TRIANGLES, (GLsizei)batchIndexCount, GL_UNSIGNED_SHORT,
+                     (void*)indexOffset);
+    } break;
+  }
+
+  BatchVertexStart = VertexCount;
+  BatchIndexStart = IndexCount;
+}
+
+void Renderer::NextRingSegment() {
+  SegmentFences[CurrentSegment] =
+      glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  CurrentSegment = (CurrentSegment + 1) % RingSegmentCount;
+
+  GLsync& fence = SegmentFences[CurrentSegment];
+  if (fence) {
+    GLenum result;
+    do {
+      result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                1'000'000'000);
+    } while (result == GL_TIMEOUT_EXPIRED);
+    if (result == GL_WAIT_FAILED) {
+      ImpLog(LogLevel::Error, LogChannel::Render,
+             "Waiting on sprite ring segment fence failed\n");
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+  }
+
+  VertexCount = 0;
+  BatchVertexStart = 0;
+  IndexCount = 0;
+  BatchIndexStart = 0;
 }
 
 void Renderer::DrawVideoTexture(const YUVFrame& frame, const RectF& dest,
@@ -803,6 +1032,19 @@ void Renderer::DrawVideoTexture(const YUVFrame& frame, const RectF& dest,
     return;
   }
 
+  const RectF viewport = Window->GetScaledViewport();
+  const bool downscaled =
+      dest.Width * viewport.Width / Profile::DesignWidth < frame.Width ||
+      dest.Height * viewport.Height / Profile::DesignHeight < frame.Height;
+  if (downscaled) {
+    // The sampler switch only applies to this quad's batch
+    Flush();
+    static_cast<const GLYUVFrame&>(frame).UpdateMipmaps();
+    for (GLuint unit = 0; unit < 3; unit++) {
+      glBindSampler(unit, VideoMipmapSampler);
+    }
+  }
+
   UseTextures(std::array<std::pair<uint32_t, size_t>, 3>{
       std::pair{frame.LumaId, 0},
       std::pair{frame.CbId, 1},
@@ -822,6 +1064,13 @@ void Renderer::DrawVideoTexture(const YUVFrame& frame, const RectF& dest,
   // OK, all good, make quad
 
   InsertVerticesQuad(dest, RectF(0.0f, 0.0f, 1.0f, 1.0f), tint);
+
+  if (downscaled) {
+    Flush();
+    for (GLuint unit = 0; unit < 3; unit++) {
+      glBindSampler(unit, Samplers[unit]);
+    }
+  }
 }
 
 void Renderer::CaptureScreencap(Sprite& sprite) {
@@ -850,6 +1099,122 @@ void Renderer::CaptureScreencap(Sprite& sprite) {
   GLC::BindFramebuffer(GL_READ_FRAMEBUFFER, prevReadBuffer);
 }
 
+uint32_t Renderer::CreateCachedLayer() {
+  auto target = std::find_if(CachedLayers.begin(), CachedLayers.end(),
+                             [](const auto& layer) { return !layer.InUse; });
+  if (target == CachedLayers.end()) {
+    CachedLayers.emplace_back();
+    target = CachedLayers.end() - 1;
+  }
+
+  // Storage is only allocated once the layer is first rendered into
+  target->InUse = true;
+  return (uint32_t)std::distance(CachedLayers.begin(), target) + 1;
+}
+
+void Renderer::FreeCachedLayer(uint32_t layer) {
+  // Layers outliving the renderer have already been freed by Shutdown
+  if (layer == 0 || layer > CachedLayers.size()) return;
+
+  CachedLayerTarget& target = CachedLayers[layer - 1];
+  if (target.Framebuffer) {
+    GLC::DeleteFramebuffers(1, &target.Framebuffer);
+    glDeleteTextures(1, &target.Texture);
+    glDeleteRenderbuffers(1, &target.StencilBuffer);
+  }
+  target = CachedLayerTarget();
+}
+
+bool Renderer::CachedLayerIsValid(uint32_t layer) {
+  const CachedLayerTarget& target = CachedLayers.at(layer - 1);
+  const Rect viewport = Window->GetViewport();
+  return target.Framebuffer && target.Width == viewport.Width &&
+         target.Height == viewport.Height;
+}
+
+void Renderer::BeginCachedLayer(uint32_t layer) {
+  if (RenderingCachedLayer) {
+    ImpLog(LogLevel::Error, LogChannel::Render,
+           "Cached layers can't be nested\n");
+    return;
+  }
+
+  Flush();
+
+  glGetIntegerv(GL_FRAMEBUFFER_BINDING, &CachedLayerPreviousFramebuffer);
+
+  CachedLayerTarget& target = CachedLayers.at(layer - 1);
+  if (!CachedLayerIsValid(layer)) {
+    // Cached layers match the framebuffers' viewport dimensions, so they need
+    // to be recreated when the window is resized
+    const Rect viewport = Window->GetViewport();
+    if (!target.Framebuffer) {
+      glGenFramebuffers(1, &target.Framebuffer);
+      glGenTextures(1, &target.Texture);
+      glGenRenderbuffers(1, &target.StencilBuffer);
+    }
+    target.Width = viewport.Width;
+    target.Height = viewport.Height;
+
+    GLC::BindFramebuffer(GL_FRAMEBUFFER, target.Framebuffer);
+    glBindTexture(GL_TEXTURE_2D, target.Texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, target.Width, target.Height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           target.Texture, 0);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, target.StencilBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_STENCIL_INDEX8, target.Width,
+                          target.Height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT,
+                              GL_RENDERBUFFER, target.StencilBuffer);
+
+    // The texture might still be bound to a texture unit with stale state
+    FlushTextures();
+  }
+
+  GLC::BindFramebuffer(GL_FRAMEBUFFER, target.Framebuffer);
+
+  if (ScissorEnabled) glDisable(GL_SCISSOR_TEST);
+  glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+  glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+  if (ScissorEnabled) glEnable(GL_SCISSOR_TEST);
+
+  RenderingCachedLayer = true;
+  ApplyBlendMode();
+}
+
+void Renderer::EndCachedLayer() {
+  if (!RenderingCachedLayer) return;
+
+  Flush();
+  GLC::BindFramebuffer(GL_FRAMEBUFFER, CachedLayerPreviousFramebuffer);
+
+  RenderingCachedLayer = false;
+  ApplyBlendMode();
+}
+
+void Renderer::DrawCachedLayer(uint32_t layer, float opacity) {
+  const CachedLayerTarget& target = CachedLayers.at(layer - 1);
+  if (!target.Framebuffer) return;
+
+  Sprite sprite(SpriteSheet(Profile::DesignWidth, Profile::DesignHeight), 0.0f,
+                0.0f, Profile::DesignWidth, Profile::DesignHeight);
+  sprite.Sheet.Texture = target.Texture;
+  sprite.Sheet.IsScreenCap = true;
+
+  // Layer contents are premultiplied, so the opacity applies to all channels
+  Flush();
+  glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+  const glm::vec4 tint(opacity);
+  DrawSprite(sprite, sprite.ScaledBounds(), glm::mat4(1.0f),
+             std::array{tint, tint, tint, tint});
+  Flush();
+  ApplyBlendMode();
+}
+
 void Renderer::EnableScissor() {
   if (ScissorEnabled) return;
 
@@ -931,12 +1296,28 @@ void Renderer::ClearStencilBuffer() {
 void Renderer::SetBlendMode(RendererBlendMode blendMode) {
   Flush();
 
-  switch (blendMode) {
+  CurrentBlendMode = blendMode;
+  ApplyBlendMode();
+}
+
+void Renderer::ApplyBlendMode() {
+  // Inside cached layers alpha has to accumulate like it would when
+  // compositing, so the layer can be blended as premultiplied later
+  switch (CurrentBlendMode) {
     case RendererBlendMode::Normal:
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      if (RenderingCachedLayer) {
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                            GL_ONE_MINUS_SRC_ALPHA);
+      } else {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      }
       return;
     case RendererBlendMode::Additive:
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+      if (RenderingCachedLayer) {
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ZERO, GL_ONE);
+      } else {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+      }
       return;
   }
 }
@@ -64,6 +64,12 @@ class Renderer : public BaseRenderer {
                     glm::mat4 spriteTransformation,
                     glm::mat4 maskTransformation, bool inverted) override;
 
+  bool SupportsSDFText() const override { return true; }
+  void DrawSDFText(const SpriteSheet& sheet, const SpriteSheet* mask,
+                   std::span<const VertexBufferSprites> vertices,
+                   std::span<const uint16_t> indices,
+                   const SDFTextParams& params) override;
+
   void DrawCCMessageBox(Sprite const& sprite, Sprite const& mask,
                         RectF const& dest, glm::vec4 tint, int alpha,
                         int fadeRange, float effectCt) override;
@@ -88,6 +94,13 @@ class Renderer : public BaseRenderer {
                        : GLC::FramebufferTextures[buffer - 1];
   }
 
+  uint32_t CreateCachedLayer() override;
+  void FreeCachedLayer(uint32_t layer) override;
+  bool CachedLayerIsValid(uint32_t layer) override;
+  void BeginCachedLayer(uint32_t layer) override;
+  void EndCachedLayer() override;
+  void DrawCachedLayer(uint32_t layer, float opacity) override;
+
   void EnableScissor() override;
   void SetScissorRect(RectF const& rect) override;
   void DisableScissor() override;
@@ -118,6 +131,8 @@ class Renderer : public BaseRenderer {
   std::optional<YUVFrameShader> YUVFrameShaderProgram;
   std::optional<CCMessageBoxShader> CCMessageBoxShaderProgram;
   std::optional<CHLCCMenuBackgroundShader> CHLCCMenuBackgroundShaderProgram;
+  std::optional<SDFTextShader> SDFTextShaderProgram;
+  std::optional<SDFTextShader> MaskedSDFTextShaderProgram;
 
   const void* CurrentShaderProgram = nullptr;
 
@@ -139,6 +154,24 @@ class Renderer : public BaseRenderer {
 
   void Flush() override;
 
+  // Draws everything written since the last batch without releasing the
+  // texture units the pending geometry was recorded against
+  void DrawBatch();
+
+  // Fences the current ring segment and moves on to the next one, waiting for
+  // the GPU to be done reading it
+  void NextRingSegment();
+
+  VertexBufferSprites* SegmentVertices() {
+    return PersistentMapping
+               ? MappedVertices + CurrentSegment * MaxVertexCount
+               : VertexStaging.data();
+  }
+  uint16_t* SegmentIndices() {
+    return PersistentMapping ? MappedIndices + CurrentSegment * MaxIndexCount
+                             : IndexStaging.data();
+  }
+
   void InsertVertices(std::span<const VertexBufferSprites> vertices,
                       std::span<const uint16_t> indices);
   void InsertVerticesQuad(CornersQuad pos, CornersQuad uv,
@@ -154,6 +187,7 @@ class Renderer : public BaseRenderer {
 
   GLuint VBO;
   GLuint IBO;
+  GLuint QuadIBO;
   GLuint VAOSprites;
 
   bool Drawing = false;
@@ -176,16 +210,39 @@ class Renderer : public BaseRenderer {
   }
 
   std::array<GLuint, TextureUnitCount> Samplers;
+  GLuint VideoMipmapSampler = 0;
 
+  // Vertex and index data is streamed through a ring of segments, each of
+  // which is fenced once the frame using it is submitted, so we never write
+  // into memory the GPU may still be reading from
+  static constexpr size_t RingSegmentCount = 3;
   static constexpr size_t MaxVertexCount =
       1024 * 1024 / sizeof(VertexBufferSprites);
-  static constexpr uint16_t MaxIndexCount =
-      std::numeric_limits<uint16_t>::max();
-
-  std::vector<VertexBufferSprites> VertexBuffer;
-  std::vector<uint16_t> IndexBuffer;
-
-  uint16_t NextFreeIndex = 0;
+  static constexpr size_t MaxIndexCount = std::numeric_limits<uint16_t>::max();
+  static constexpr size_t QuadIndexCount = MaxVertexCount / 4 * 6;
+  static_assert(MaxVertexCount <= (size_t)MaxIndexCount + 1);
+
+  // Quads use the prebuilt QuadIBO, arbitrary geometry from DrawVertices
+  // streams its own indices
+  enum class BatchMode { Quads, Indexed };
+  BatchMode CurrentBatchMode = BatchMode::Quads;
+
+  // With ARB_buffer_storage the ring is persistently mapped and written to
+  // directly, otherwise we write to a staging segment and upload each batch
+  // with glBufferSubData into the ring
+  bool PersistentMapping = false;
+  VertexBufferSprites* MappedVertices = nullptr;
+  uint16_t* MappedIndices = nullptr;
+  std::vector<VertexBufferSprites> VertexStaging;
+  std::vector<uint16_t> IndexStaging;
+
+  std::array<GLsync, RingSegmentCount> SegmentFences{};
+  size_t CurrentSegment = 0;
+
+  size_t VertexCount = 0;
+  size_t BatchVertexStart = 0;
+  size_t IndexCount = 0;
+  size_t BatchIndexStart = 0;
 
   const glm::mat4 Projection =
       glm::ortho(0.0f, Profile::DesignWidth, Profile::DesignHeight, 0.0f,
@@ -195,6 +252,24 @@ class Renderer : public BaseRenderer {
   ShaderCompiler Shaders;
 
   bool ScissorEnabled = false;
+
+  RendererBlendMode CurrentBlendMode = RendererBlendMode::Normal;
+  void ApplyBlendMode();
+
+  // Cached layers are cleared to transparent black and keep premultiplied
+  // color, so they can be composited with a single ONE, ONE_MINUS_SRC_ALPHA
+  // blend without the layer's alpha getting applied twice
+  struct CachedLayerTarget {
+    GLuint Framebuffer = 0;
+    GLuint Texture = 0;
+    GLuint StencilBuffer = 0;
+    int Width = 0;
+    int Height = 0;
+    bool InUse = false;
+  };
+  std::vector<CachedLayerTarget> CachedLayers;
+  bool RenderingCachedLayer = false;
+  GLint CachedLayerPreviousFramebuffer = 0;
 };
 
 }  // namespace OpenGL
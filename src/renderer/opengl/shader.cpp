@@ -662,5 +662,47 @@ void CHLCCMenuBackgroundShader::UploadUniforms(
   UpdateVar(newUniforms.Alpha, Uniforms.Alpha, AlphaLocation);
 }
 
+SDFTextShader::SDFTextShader(GLint programId)
+    : Shader(programId),
+      ProjectionLocation(glGetUniformLocation(programId, "Projection")),
+      SpriteTransformationLocation(
+          glGetUniformLocation(programId, "SpriteTransformation")),
+      MaskTransformationLocation(
+          glGetUniformLocation(programId, "MaskTransformation")),
+      ColorMapLocation(glGetUniformLocation(programId, "ColorMap")),
+      MaskLocation(glGetUniformLocation(programId, "Mask")),
+      OutlineColorLocation(glGetUniformLocation(programId, "OutlineColor")),
+      OutlineOffsetLocation(glGetUniformLocation(programId, "OutlineOffset")),
+      OutlineEdgeLocation(glGetUniformLocation(programId, "OutlineEdge")),
+      OpacityLocation(glGetUniformLocation(programId, "Opacity")) {
+  UploadVar(Uniforms.Projection, ProjectionLocation);
+  UploadVar(Uniforms.SpriteTransformation, SpriteTransformationLocation);
+  UploadVar(Uniforms.MaskTransformation, MaskTransformationLocation);
+  UploadVar(Uniforms.ColorMap, ColorMapLocation);
+  UploadVar(Uniforms.Mask, MaskLocation);
+  UploadVar(Uniforms.OutlineColor, OutlineColorLocation);
+  UploadVar(Uniforms.OutlineOffset, OutlineOffsetLocation);
+  UploadVar(Uniforms.OutlineEdge, OutlineEdgeLocation);
+  UploadVar(Uniforms.Opacity, OpacityLocation);
+}
+
+void SDFTextShader::UploadUniforms(SDFTextUniforms newUniforms) {
+  UpdateVar(newUniforms.Projection, Uniforms.Projection, ProjectionLocation);
+  UpdateVar(newUniforms.SpriteTransformation, Uniforms.SpriteTransformation,
+            SpriteTransformationLocation);
+  UpdateVar(newUniforms.MaskTransformation, Uniforms.MaskTransformation,
+            MaskTransformationLocation);
+
+  UpdateVar(newUniforms.ColorMap, Uniforms.ColorMap, ColorMapLocation);
+  UpdateVar(newUniforms.Mask, Uniforms.Mask, MaskLocation);
+  UpdateVar(newUniforms.OutlineColor, Uniforms.OutlineColor,
+            OutlineColorLocation);
+  UpdateVar(newUniforms.OutlineOffset, Uniforms.OutlineOffset,
+            OutlineOffsetLocation);
+  UpdateVar(newUniforms.OutlineEdge, Uniforms.OutlineEdge,
+            OutlineEdgeLocation);
+  UpdateVar(newUniforms.Opacity, Uniforms.Opacity, OpacityLocation);
+}
+
 }  // namespace OpenGL
 }  // namespace Impacto
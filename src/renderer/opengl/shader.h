@@ -540,5 +540,40 @@ class CHLCCMenuBackgroundShader : public Shader<CHLCCMenuBackgroundUniforms> {
   const GLint AlphaLocation;
 };
 
+// Shared by the plain and masked variant, the latter compiled with IS_MASKED
+struct SDFTextUniforms {
+  bool operator==(const SDFTextUniforms& other) const = default;
+
+  glm::mat4 Projection{};
+  glm::mat4 SpriteTransformation{};
+  glm::mat4 MaskTransformation{};
+
+  GLint ColorMap = 0;
+  GLint Mask = 0;
+  glm::vec4 OutlineColor{};
+  glm::vec2 OutlineOffset{};
+  float OutlineEdge = 0.5f;
+  float Opacity = 1.0f;
+};
+
+class SDFTextShader : public Shader<SDFTextUniforms> {
+ public:
+  SDFTextShader(GLint programId);
+
+  void UploadUniforms(SDFTextUniforms uniforms) override;
+
+ private:
+  const GLint ProjectionLocation;
+  const GLint SpriteTransformationLocation;
+  const GLint MaskTransformationLocation;
+
+  const GLint ColorMapLocation;
+  const GLint MaskLocation;
+  const GLint OutlineColorLocation;
+  const GLint OutlineOffsetLocation;
+  const GLint OutlineEdgeLocation;
+  const GLint OpacityLocation;
+};
+
 }  // namespace OpenGL
 }  // namespace Impacto
\ No newline at end of file
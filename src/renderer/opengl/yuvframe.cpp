@@ -1,37 +1,175 @@
 #include "yuvframe.h"
+#include "../renderer.h"
 #include "../../log.h"
 
-#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
 
 namespace Impacto {
 namespace OpenGL {
 
+static GLsizei MipLevelCount(int width, int height) {
+  GLsizei levels = 1;
+  while ((std::max(width, height) >> levels) > 0) levels++;
+  return levels;
+}
+
 void GLYUVFrame::Init(float width, float height) {
   Width = width;
   Height = height;
-  GLuint yuv[3];
+  LumaWidth = (int)width;
+  LumaHeight = (int)height;
+  ChromaWidth = LumaWidth / 2;
+  ChromaHeight = LumaHeight / 2;
+  LumaSize = (size_t)LumaWidth * LumaHeight;
+  ChromaSize = (size_t)ChromaWidth * ChromaHeight;
 
+  GLuint yuv[3];
   glGenTextures(3, yuv);
   LumaId = yuv[0];
   CbId = yuv[1];
   CrId = yuv[2];
+
+  // Storage is allocated once per video, frames only ever replace level 0
+  const bool immutableStorage =
+      ActualGraphicsApi != GfxApi_GL || GLAD_GL_ARB_texture_storage;
+  const auto allocate = [immutableStorage](GLuint texture, int w, int h) {
+    const GLsizei levels = MipLevelCount(w, h);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    if (immutableStorage) {
+      glTexStorage2D(GL_TEXTURE_2D, levels, GL_R8, w, h);
+    } else {
+      for (GLsizei level = 0; level < levels; level++) {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_R8, std::max(1, w >> level),
+                     std::max(1, h >> level), 0, GL_RED, GL_UNSIGNED_BYTE,
+                     nullptr);
+      }
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+  };
+  allocate(LumaId, LumaWidth, LumaHeight);
+  allocate(CbId, ChromaWidth, ChromaHeight);
+  allocate(CrId, ChromaWidth, ChromaHeight);
+
+#ifndef EMSCRIPTEN
+  const GLsizeiptr pboSize = LumaSize + 2 * ChromaSize;
+  glGenBuffers(PboCount, Pbos.data());
+
+  PersistentMapping =
+      ActualGraphicsApi == GfxApi_GL && GLAD_GL_ARB_buffer_storage;
+  if (PersistentMapping) {
+    const GLbitfield flags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    for (int i = 0; i < PboCount; i++) {
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, Pbos[i]);
+      glBufferStorage(GL_PIXEL_UNPACK_BUFFER, pboSize, nullptr, flags);
+      MappedPbos[i] = (uint8_t*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0,
+                                                 pboSize, flags);
+      if (MappedPbos[i] == nullptr) PersistentMapping = false;
+    }
+
+    if (!PersistentMapping) {
+      ImpLog(LogLevel::Warning, LogChannel::Render,
+             "Failed to persistently map video upload buffers, falling back "
+             "to mapping them per frame\n");
+      MappedPbos = {};
+
+      // Immutable storage can't be respecified, start over with new buffers
+      glDeleteBuffers(PboCount, Pbos.data());
+      glGenBuffers(PboCount, Pbos.data());
+    }
+  }
+
+  if (!PersistentMapping) {
+    for (GLuint pbo : Pbos) {
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+      glBufferData(GL_PIXEL_UNPACK_BUFFER, pboSize, nullptr, GL_STREAM_DRAW);
+    }
+  }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+#endif
 }
 
-void GLYUVFrame::Submit(const void* luma, const void* cb, const void* cr) {
+void GLYUVFrame::UploadPlanes(const void* luma, const void* cb,
+                              const void* cr) {
   glBindTexture(GL_TEXTURE_2D, LumaId);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, (GLsizei)Width, (GLsizei)Height, 0,
-               GL_RED, GL_UNSIGNED_BYTE, luma);
-  glGenerateMipmap(GL_TEXTURE_2D);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, LumaWidth, LumaHeight, GL_RED,
+                  GL_UNSIGNED_BYTE, luma);
 
   glBindTexture(GL_TEXTURE_2D, CbId);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, (GLsizei)(Width / 2),
-               (GLsizei)(Height / 2), 0, GL_RED, GL_UNSIGNED_BYTE, cb);
-  glGenerateMipmap(GL_TEXTURE_2D);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, ChromaWidth, ChromaHeight, GL_RED,
+                  GL_UNSIGNED_BYTE, cb);
 
   glBindTexture(GL_TEXTURE_2D, CrId);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, (GLsizei)(Width / 2),
-               (GLsizei)(Height / 2), 0, GL_RED, GL_UNSIGNED_BYTE, cr);
-  glGenerateMipmap(GL_TEXTURE_2D);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, ChromaWidth, ChromaHeight, GL_RED,
+                  GL_UNSIGNED_BYTE, cr);
+}
+
+void GLYUVFrame::Submit(const void* luma, const void* cb, const void* cr) {
+  const auto startTime = std::chrono::steady_clock::now();
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+#ifdef EMSCRIPTEN
+  // WebGL can't map buffers, upload straight from client memory
+  UploadPlanes(luma, cb, cr);
+#else
+  const int pbo = CurrentPbo;
+  CurrentPbo = (CurrentPbo + 1) % PboCount;
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, Pbos[pbo]);
+
+  uint8_t* staging;
+  if (PersistentMapping) {
+    // Wait for the transfer that last read from this buffer, PboCount frames
+    // ago, so this should practically never block
+    GLsync& fence = PboFences[pbo];
+    if (fence) {
+      GLenum result;
+      do {
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                  1'000'000'000);
+      } while (result == GL_TIMEOUT_EXPIRED);
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+    staging = MappedPbos[pbo];
+  } else {
+    staging = (uint8_t*)glMapBufferRange(
+        GL_PIXEL_UNPACK_BUFFER, 0, LumaSize + 2 * ChromaSize,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  }
+
+  if (staging) {
+    memcpy(staging, luma, LumaSize);
+    memcpy(staging + LumaSize, cb, ChromaSize);
+    memcpy(staging + LumaSize + ChromaSize, cr, ChromaSize);
+    if (!PersistentMapping) glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    // With an unpack buffer bound the plane pointers are offsets into it
+    UploadPlanes((const void*)0, (const void*)LumaSize,
+                 (const void*)(LumaSize + ChromaSize));
+
+    if (PersistentMapping) {
+      PboFences[pbo] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  } else {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    UploadPlanes(luma, cb, cr);
+  }
+#endif
+
+  MipmapsStale = true;
+  RecordUploadTime(startTime);
+}
+
+void GLYUVFrame::UpdateMipmaps() const {
+  if (!MipmapsStale) return;
+
+  for (GLuint texture : {LumaId, CbId, CrId}) {
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glGenerateMipmap(GL_TEXTURE_2D);
+  }
+  MipmapsStale = false;
 }
 
 void GLYUVFrame::Release() {
@@ -40,7 +178,18 @@ void GLYUVFrame::Release() {
   yuv[1] = CbId;
   yuv[2] = CrId;
   glDeleteTextures(3, yuv);
+
+#ifndef EMSCRIPTEN
+  for (GLsync& fence : PboFences) {
+    if (fence) glDeleteSync(fence);
+    fence = nullptr;
+  }
+  // Deleting a buffer also unmaps it
+  glDeleteBuffers(PboCount, Pbos.data());
+  Pbos = {};
+  MappedPbos = {};
+#endif
 }
 
 }  // namespace OpenGL
-}  // namespace Impacto
\ No newline at end of file
+}  // namespace Impacto
@@ -2,6 +2,9 @@
 
 #include "../yuvframe.h"
 
+#include <array>
+#include <glad/glad.h>
+
 namespace Impacto {
 namespace OpenGL {
 
@@ -11,7 +14,36 @@ class GLYUVFrame : public YUVFrame {
 
   void Submit(const void* luma, const void* cb, const void* cr) override;
   void Release() override;
+
+  // Fills the mip chain from the last submitted frame if it isn't already.
+  // Only needed when the frame is drawn downscaled, so this is left to the
+  // renderer instead of being done for every upload.
+  void UpdateMipmaps() const;
+
+ private:
+  // Planes are uploaded from a ring of pixel unpack buffers, so copying the
+  // next frame never waits for the transfer of the previous one
+  static constexpr int PboCount = 3;
+
+  void UploadPlanes(const void* luma, const void* cb, const void* cr);
+
+  int LumaWidth;
+  int LumaHeight;
+  int ChromaWidth;
+  int ChromaHeight;
+  size_t LumaSize;
+  size_t ChromaSize;
+
+  // With ARB_buffer_storage the ring is persistently mapped and fenced,
+  // otherwise each buffer is mapped with invalidation for every frame
+  bool PersistentMapping = false;
+  std::array<GLuint, PboCount> Pbos{};
+  std::array<uint8_t*, PboCount> MappedPbos{};
+  std::array<GLsync, PboCount> PboFences{};
+  int CurrentPbo = 0;
+
+  mutable bool MipmapsStale = false;
 };
 
 }  // namespace OpenGL
-}  // namespace Impacto
\ No newline at end of file
+}  // namespace Impacto
@@ -141,16 +141,8 @@ void BaseRenderer::DrawProcessedText(std::span<const ProcessedTextGlyph> text,
                                      RendererOutlineMode outlineMode,
                                      bool smoothstepGlyphOpacity,
                                      SpriteSheet* maskedSheet) {
-  switch (font->Type) {
-    case FontType::Basic:
-      DrawProcessedText_BasicFont(text, (BasicFont*)font, opacity, outlineMode,
-                                  smoothstepGlyphOpacity, opacity, maskedSheet);
-      break;
-    case FontType::LB: {
-      DrawProcessedText_LBFont(text, (LBFont*)font, opacity, outlineMode,
-                               smoothstepGlyphOpacity, opacity, maskedSheet);
-    }
-  }
+  DrawProcessedText(ScratchGlyphQuads, 0, text, font, opacity, opacity,
+                    outlineMode, smoothstepGlyphOpacity, maskedSheet);
 }
 
 void BaseRenderer::DrawProcessedText(std::span<const ProcessedTextGlyph> text,
@@ -159,182 +151,187 @@ void BaseRenderer::DrawProcessedText(std::span<const ProcessedTextGlyph> text,
                                      RendererOutlineMode outlineMode,
                                      bool smoothstepGlyphOpacity,
                                      SpriteSheet* maskedSheet) {
-  switch (font->Type) {
-    case FontType::Basic:
-      DrawProcessedText_BasicFont(text, (BasicFont*)font, opacity, outlineMode,
-                                  smoothstepGlyphOpacity, outlineOpacity,
-                                  maskedSheet);
-      break;
-    case FontType::LB: {
-      DrawProcessedText_LBFont(text, (LBFont*)font, opacity, outlineMode,
-                               smoothstepGlyphOpacity, outlineOpacity,
-                               maskedSheet);
+  DrawProcessedText(ScratchGlyphQuads, 0, text, font, opacity, outlineOpacity,
+                    outlineMode, smoothstepGlyphOpacity, maskedSheet);
+}
+
+void BaseRenderer::DrawProcessedText(
+    GlyphQuadCache& cache, uint32_t generation,
+    std::span<const ProcessedTextGlyph> text, Font* font, float opacity,
+    float outlineOpacity, RendererOutlineMode outlineMode,
+    bool smoothstepGlyphOpacity, SpriteSheet* maskedSheet) {
+  if (text.empty()) return;
+
+  const glm::vec2 windowDimensions =
+      glm::vec2(Window->WindowWidth, Window->WindowHeight);
+  if (generation == 0 || cache.Generation != generation ||
+      cache.BakedFont != font || cache.MaskedSheet != maskedSheet ||
+      cache.OutlineMode != outlineMode ||
+      cache.SmoothstepGlyphOpacity != smoothstepGlyphOpacity ||
+      cache.GlyphCount != text.size() ||
+      cache.WindowDimensions != windowDimensions) {
+    cache.Generation = generation;
+    cache.BakedFont = font;
+    cache.MaskedSheet = maskedSheet;
+    cache.OutlineMode = outlineMode;
+    cache.SmoothstepGlyphOpacity = smoothstepGlyphOpacity;
+    cache.WindowDimensions = windowDimensions;
+
+    switch (font->Type) {
+      case FontType::Basic:
+        BakeGlyphQuads_BasicFont(cache, text, (BasicFont*)font, outlineMode);
+        break;
+      case FontType::LB:
+        BakeGlyphQuads_LBFont(cache, text, (LBFont*)font, outlineMode);
+        break;
+      case FontType::SDF:
+        BakeGlyphQuads_SDFFont(cache, text, (SDFFont*)font, outlineMode);
+        break;
     }
+
+    cache.GlyphOpacities.assign(text.size(), -1.0f);
+    cache.Opacity = -1.0f;
+    cache.OutlineOpacity = -1.0f;
   }
-}
 
-void BaseRenderer::DrawProcessedText_BasicFont(
-    std::span<const ProcessedTextGlyph> text, BasicFont* font, float opacity,
-    RendererOutlineMode outlineMode, bool smoothstepGlyphOpacity,
-    float outlineOpacity, SpriteSheet* maskedSheet) {
-  const size_t vertexCount = text.size() * 4;
-  const size_t indexCount = text.size() * 6;
-  std::vector<VertexBufferSprites> vertices;
-  std::vector<uint16_t> indices;
-  vertices.resize(vertexCount);
-  indices.resize(indexCount);
+  // SDF fonts apply the opacities as shader parameters
+  const bool sdf = font->Type == +FontType::SDF;
+  const float foregroundOpacity = sdf ? 1.0f : opacity;
+
+  // Only glyphs the typewriter is still fading in need their tint touched
+  const bool allDirty = !sdf && (cache.Opacity != opacity ||
+                                 cache.OutlineOpacity != outlineOpacity);
+  cache.Opacity = opacity;
+  cache.OutlineOpacity = outlineOpacity;
+
+  const size_t passVertexCount = cache.GlyphCount * 4;
+  for (size_t i = 0; i < text.size(); i++) {
+    const float glyphOpacity = text[i].Opacity;
+    if (!allDirty && cache.GlyphOpacities[i] == glyphOpacity) continue;
+    cache.GlyphOpacities[i] = glyphOpacity;
+
+    const float alpha = smoothstepGlyphOpacity
+                            ? glm::smoothstep(0.0f, 1.0f, glyphOpacity)
+                            : glyphOpacity;
+    for (size_t pass = 0; pass <= cache.OutlinePasses; pass++) {
+      const float passAlpha =
+          (pass < cache.OutlinePasses ? outlineOpacity : foregroundOpacity) *
+          alpha;
+      const auto glyphStart =
+          cache.Vertices.begin() + pass * passVertexCount + i * 4;
+      std::for_each(glyphStart, glyphStart + 4,
+                    [passAlpha](auto& vertex) { vertex.Tint.a = passAlpha; });
+    }
+  }
+
+  DrawGlyphQuads(cache, font, maskedSheet, opacity, outlineOpacity);
+}
 
-  for (uint16_t i = 0; i < text.size(); i++) {
-    const uint16_t bl = i * 4;
+static void ResetGlyphQuads(GlyphQuadCache& cache, size_t glyphCount,
+                            size_t outlinePasses, size_t indexedQuadCount) {
+  cache.GlyphCount = glyphCount;
+  cache.OutlinePasses = outlinePasses;
+  cache.Vertices.resize((outlinePasses + 1) * glyphCount * 4);
+
+  // All quads share the same index pattern, so the indices only have to be
+  // regenerated when the quad count changes
+  if (cache.Indices.size() == indexedQuadCount * 6) return;
+  cache.Indices.resize(indexedQuadCount * 6);
+  for (size_t i = 0; i < indexedQuadCount; i++) {
+    const uint16_t bl = (uint16_t)(i * 4);
     const uint16_t tl = bl + 1;
     const uint16_t tr = bl + 2;
     const uint16_t br = bl + 3;
 
-    indices[i * 6 + 0] = bl;
-    indices[i * 6 + 1] = tl;
-    indices[i * 6 + 2] = tr;
-    indices[i * 6 + 3] = bl;
-    indices[i * 6 + 4] = tr;
-    indices[i * 6 + 5] = br;
+    cache.Indices[i * 6 + 0] = bl;
+    cache.Indices[i * 6 + 1] = tl;
+    cache.Indices[i * 6 + 2] = tr;
+    cache.Indices[i * 6 + 3] = bl;
+    cache.Indices[i * 6 + 4] = tr;
+    cache.Indices[i * 6 + 5] = br;
   }
+}
+
+void BaseRenderer::BakeGlyphQuads_BasicFont(
+    GlyphQuadCache& cache, std::span<const ProcessedTextGlyph> text,
+    BasicFont* font, RendererOutlineMode outlineMode) {
+  // Outlines are the glyphs themselves drawn offset in the outline color
+  std::span<const glm::vec2> outlineOffsets;
+  switch (outlineMode) {
+    case RendererOutlineMode::None:
+      break;
 
+    case RendererOutlineMode::Full: {
+      static constexpr glm::vec2 offsets[] = {{-1.0f, -1.0f}, {1.0f, 1.0f}};
+      outlineOffsets = offsets;
+      break;
+    }
+
+    case RendererOutlineMode::BottomRight: {
+      static constexpr glm::vec2 offsets[] = {{1.0f, 1.0f}};
+      outlineOffsets = offsets;
+      break;
+    }
+
+    default:
+      ImpLogSlow(LogLevel::Warning, LogChannel::Render,
+                 "Unexpected outline mode!");
+      break;
+  }
+
+  const size_t passCount = outlineOffsets.size() + 1;
+  ResetGlyphQuads(cache, text.size(), outlineOffsets.size(),
+                  text.size() * passCount);
+
+  const size_t vertexCount = text.size() * 4;
+  const auto foregroundStart =
+      cache.Vertices.begin() + outlineOffsets.size() * vertexCount;
   for (size_t i = 0; i < text.size(); i++) {
-    const ProcessedTextGlyph glyph = text[i];
+    const ProcessedTextGlyph& glyph = text[i];
 
     const CornersQuad dest = glyph.DestRect;
     const CornersQuad destUV = font->Glyph(glyph.CharId).NormalizedBounds();
     const CornersQuad maskUV = CornersQuad(dest).Scale(
         {1.0f / Window->WindowWidth, 1.0f / Window->WindowHeight},
         {0.0f, 0.0f});
-    glm::vec4 color = RgbIntToFloat(glyph.Colors.TextColor);
-    color.a = opacity * (smoothstepGlyphOpacity
-                             ? glm::smoothstep(0.0f, 1.0f, glyph.Opacity)
-                             : glyph.Opacity);
+    const glm::vec4 color = RgbIntToFloat(glyph.Colors.TextColor);
 
-    InsertQuad(std::span<VertexBufferSprites, 4>(vertices.begin() + i * 4, 4),
+    InsertQuad(std::span<VertexBufferSprites, 4>(foregroundStart + i * 4, 4),
                dest, destUV, color, maskUV);
   }
-  uint16_t maxIndex = (uint16_t)vertexCount;
-
-  if (outlineMode != RendererOutlineMode::None) {
-    // Add outline to the front of the buffers
-    vertices.insert(vertices.end(), vertices.begin(), vertices.end());
-
-    indices.reserve(indexCount * 2);
-    std::transform(indices.begin(), indices.end(), std::back_inserter(indices),
-                   [maxIndex](uint16_t index) { return index + maxIndex; });
-    maxIndex += (uint16_t)vertexCount;
 
-    // Set the color of the outline
+  for (size_t pass = 0; pass < outlineOffsets.size(); pass++) {
+    const glm::vec2 offset = outlineOffsets[pass];
+    const auto outlineStart = cache.Vertices.begin() + pass * vertexCount;
     for (size_t i = 0; i < text.size(); i++) {
-      const ProcessedTextGlyph glyph = text[i];
-      glm::vec4 color = RgbIntToFloat(glyph.Colors.OutlineColor);
-      color.a =
-          outlineOpacity * (smoothstepGlyphOpacity
-                                ? glm::smoothstep(0.0f, 1.0f, glyph.Opacity)
-                                : glyph.Opacity);
-      const auto glyphStart = vertices.begin() + i * 4;
-      const auto glyphEnd = glyphStart + 4;
-      std::transform(glyphStart, glyphEnd, glyphStart, [color](auto vertex) {
-        vertex.Tint = color;
-        return vertex;
-      });
-    }
-
-    const auto translateVertex = [](VertexBufferSprites vertex,
-                                    const glm::vec2 offset) {
-      vertex.Position += offset;
-      return vertex;
-    };
-
-    switch (outlineMode) {
-      case RendererOutlineMode::Full: {
-        // Add bottom-right outline
-        vertices.insert(vertices.begin() + vertexCount, vertices.begin(),
-                        vertices.begin() + vertexCount);
-
-        indices.resize(indexCount * 3);
-        std::transform(indices.begin(), indices.begin() + indexCount,
-                       indices.begin() + indexCount * 2,
-                       [maxIndex](uint16_t index) { return index + maxIndex; });
-        maxIndex += (uint16_t)vertexCount;
-
-        // Translate outlines
-        const auto tlOutlineStart = vertices.begin();
-        const auto brOutlineStart = tlOutlineStart + vertexCount;
-        const auto foregroundStart = brOutlineStart + vertexCount;
-        std::transform(tlOutlineStart, brOutlineStart, tlOutlineStart,
-                       [translateVertex](auto vertex) {
-                         return translateVertex(vertex, {-1.0f, -1.0f});
-                       });
-        std::transform(brOutlineStart, foregroundStart, brOutlineStart,
-                       [translateVertex](auto vertex) {
-                         return translateVertex(vertex, {1.0f, 1.0f});
-                       });
-
-        break;
-      }
-
-      case RendererOutlineMode::BottomRight: {
-        const auto brOutlineStart = vertices.begin();
-        const auto foregroundStart = vertices.begin() + vertexCount;
-        std::transform(brOutlineStart, foregroundStart, brOutlineStart,
-                       [translateVertex](auto vertex) {
-                         return translateVertex(vertex, {1.0f, 1.0f});
-                       });
-
-        break;
-      }
-
-      default:
-        ImpLogSlow(LogLevel::Warning, LogChannel::Render,
-                   "Unexpected outline mode!");
-        break;
+      const glm::vec4 color = RgbIntToFloat(text[i].Colors.OutlineColor);
+      std::transform(foregroundStart + i * 4, foregroundStart + i * 4 + 4,
+                     outlineStart + i * 4, [offset, color](auto vertex) {
+                       vertex.Position += offset;
+                       vertex.Tint = color;
+                       return vertex;
+                     });
     }
   }
-
-  const ShaderProgramType shader = maskedSheet == nullptr
-                                       ? ShaderProgramType::Sprite
-                                       : ShaderProgramType::MaskedSpriteNoAlpha;
-  DrawVertices(font->Sheet, maskedSheet, shader, vertices, indices);
 }
 
-void BaseRenderer::DrawProcessedText_LBFont(
-    std::span<const ProcessedTextGlyph> text, LBFont* font, float opacity,
-    RendererOutlineMode outlineMode, bool smoothstepGlyphOpacity,
-    float outlineOpacity, SpriteSheet* maskedSheet) {
-  const ShaderProgramType shader = maskedSheet == nullptr
-                                       ? ShaderProgramType::Sprite
-                                       : ShaderProgramType::MaskedSpriteNoAlpha;
+void BaseRenderer::BakeGlyphQuads_LBFont(
+    GlyphQuadCache& cache, std::span<const ProcessedTextGlyph> text,
+    LBFont* font, RendererOutlineMode outlineMode) {
+  // Outline and foreground come from different sheets and are drawn
+  // separately, so they share one set of indices
+  const size_t outlinePasses = outlineMode != RendererOutlineMode::None;
+  ResetGlyphQuads(cache, text.size(), outlinePasses, text.size());
 
   const size_t vertexCount = text.size() * 4;
-  const size_t indexCount = text.size() * 6;
-  std::vector<VertexBufferSprites> vertices(vertexCount);
-  std::vector<uint16_t> indices(indexCount);
-
-  for (uint16_t i = 0; i < text.size(); i++) {
-    const uint16_t bl = i * 4;
-    const uint16_t tl = bl + 1;
-    const uint16_t tr = bl + 2;
-    const uint16_t br = bl + 3;
-
-    indices[i * 6 + 0] = bl;
-    indices[i * 6 + 1] = tl;
-    indices[i * 6 + 2] = tr;
-    indices[i * 6 + 3] = bl;
-    indices[i * 6 + 4] = tr;
-    indices[i * 6 + 5] = br;
-  }
+  const auto foregroundStart =
+      cache.Vertices.begin() + outlinePasses * vertexCount;
 
-  if (outlineMode != RendererOutlineMode::None) {
+  if (outlinePasses != 0) {
     for (size_t i = 0; i < text.size(); i++) {
-      const ProcessedTextGlyph glyph = text[i];
+      const ProcessedTextGlyph& glyph = text[i];
 
-      glm::vec4 color = RgbIntToFloat(glyph.Colors.OutlineColor);
-      color.a =
-          outlineOpacity * (smoothstepGlyphOpacity
-                                ? glm::smoothstep(0.0f, 1.0f, glyph.Opacity)
-                                : glyph.Opacity);
+      const glm::vec4 color = RgbIntToFloat(glyph.Colors.OutlineColor);
       const CornersQuad destUV =
           font->OutlineGlyph(glyph.CharId).NormalizedBounds();
 
@@ -369,15 +366,14 @@ void BaseRenderer::DrawProcessedText_LBFont(
       const CornersQuad maskUV = CornersQuad(dest).Scale(
           {1.0f / Window->WindowWidth, 1.0f / Window->WindowHeight},
           {0.0f, 0.0f});
-      InsertQuad(std::span<VertexBufferSprites, 4>(vertices.begin() + i * 4, 4),
-                 dest, destUV, color, maskUV);
+      InsertQuad(
+          std::span<VertexBufferSprites, 4>(cache.Vertices.begin() + i * 4, 4),
+          dest, destUV, color, maskUV);
     }
-
-    DrawVertices(font->OutlineSheet, maskedSheet, shader, vertices, indices);
   }
 
   for (size_t i = 0; i < text.size(); i++) {
-    const ProcessedTextGlyph glyph = text[i];
+    const ProcessedTextGlyph& glyph = text[i];
 
     glm::vec2 scale = {glyph.DestRect.Height / font->BitmapEmWidth,
                        glyph.DestRect.Height / font->BitmapEmHeight};
@@ -387,20 +383,136 @@ void BaseRenderer::DrawProcessedText_LBFont(
                            .Translate(glyph.DestRect.GetPos());
 
     const CornersQuad destUV = font->Glyph(glyph.CharId).NormalizedBounds();
-
-    glm::vec4 color = RgbIntToFloat(glyph.Colors.TextColor);
-    color.a = opacity * (smoothstepGlyphOpacity
-                             ? glm::smoothstep(0.0f, 1.0f, glyph.Opacity)
-                             : glyph.Opacity);
+    const glm::vec4 color = RgbIntToFloat(glyph.Colors.TextColor);
 
     const CornersQuad maskUV = CornersQuad(dest).Scale(
         {1.0f / Window->WindowWidth, 1.0f / Window->WindowHeight},
         {0.0f, 0.0f});
-    InsertQuad(std::span<VertexBufferSprites, 4>(vertices.begin() + i * 4, 4),
+    InsertQuad(std::span<VertexBufferSprites, 4>(foregroundStart + i * 4, 4),
                dest, destUV, color, maskUV);
   }
+}
+
+void BaseRenderer::BakeGlyphQuads_SDFFont(
+    GlyphQuadCache& cache, std::span<const ProcessedTextGlyph> text,
+    SDFFont* font, RendererOutlineMode outlineMode) {
+  ResetGlyphQuads(cache, text.size(), 0, text.size());
+
+  cache.OutlineRuns.clear();
+  for (size_t i = 0; i < text.size(); i++) {
+    const ProcessedTextGlyph& glyph = text[i];
+
+    // The padded cell leaves room for the outline and shadow around the glyph
+    const glm::vec2 scale = {glyph.DestRect.Height / font->BitmapEmWidth,
+                             glyph.DestRect.Height / font->BitmapEmHeight};
+    const CornersQuad dest =
+        RectF(-font->Spread, -font->Spread,
+              font->AdvanceWidths[glyph.CharId] + 2.0f * font->Spread,
+              font->BitmapEmHeight + 2.0f * font->Spread)
+            .Scale(scale, {0.0f, 0.0f})
+            .Translate(glyph.DestRect.GetPos());
+
+    const CornersQuad destUV = font->Glyph(glyph.CharId).NormalizedBounds();
+    const glm::vec4 color = RgbIntToFloat(glyph.Colors.TextColor);
+    const CornersQuad maskUV = CornersQuad(dest).Scale(
+        {1.0f / Window->WindowWidth, 1.0f / Window->WindowHeight},
+        {0.0f, 0.0f});
+    InsertQuad(
+        std::span<VertexBufferSprites, 4>(cache.Vertices.begin() + i * 4, 4),
+        dest, destUV, color, maskUV);
+
+    if (outlineMode == RendererOutlineMode::None) continue;
+    const glm::vec4 outlineColor = RgbIntToFloat(glyph.Colors.OutlineColor);
+    if (cache.OutlineRuns.empty() ||
+        cache.OutlineRuns.back().Color != outlineColor) {
+      cache.OutlineRuns.push_back({.FirstGlyph = i, .Color = outlineColor});
+    }
+  }
+
+  if (cache.OutlineRuns.empty()) {
+    cache.OutlineRuns.push_back({.FirstGlyph = 0, .Color = glm::vec4(0.0f)});
+  }
+}
+
+void BaseRenderer::DrawGlyphQuads(const GlyphQuadCache& cache, Font* font,
+                                  SpriteSheet* maskedSheet, float opacity,
+                                  float outlineOpacity) {
+  const ShaderProgramType shader = maskedSheet == nullptr
+                                       ? ShaderProgramType::Sprite
+                                       : ShaderProgramType::MaskedSpriteNoAlpha;
+
+  switch (font->Type) {
+    case FontType::Basic:
+      DrawVertices(((BasicFont*)font)->Sheet, maskedSheet, shader,
+                   cache.Vertices, cache.Indices);
+      break;
+
+    case FontType::LB: {
+      LBFont* lbFont = (LBFont*)font;
+      std::span<const VertexBufferSprites> vertices = cache.Vertices;
+      const size_t vertexCount = cache.GlyphCount * 4;
+      if (cache.OutlinePasses != 0) {
+        DrawVertices(lbFont->OutlineSheet, maskedSheet, shader,
+                     vertices.first(vertexCount), cache.Indices);
+        vertices = vertices.subspan(vertexCount);
+      }
+      DrawVertices(lbFont->ForegroundSheet, maskedSheet, shader, vertices,
+                   cache.Indices);
+      break;
+    }
+
+    case FontType::SDF: {
+      SDFFont* sdfFont = (SDFFont*)font;
+      SDFTextParams params{.Opacity = opacity};
+      switch (cache.OutlineMode) {
+        case RendererOutlineMode::Full:
+          params.OutlineEdge = sdfFont->OutlineEdge();
+          break;
+        case RendererOutlineMode::BottomRight:
+          // The glyph itself, moved down right like a drop shadow
+          params.OutlineOffset =
+              sdfFont->ShadowOffset / sdfFont->Sheet.GetDimensions();
+          break;
+        default:
+          break;
+      }
+
+      const std::span<const VertexBufferSprites> vertices = cache.Vertices;
+      for (size_t run = 0; run < cache.OutlineRuns.size(); run++) {
+        const size_t first = cache.OutlineRuns[run].FirstGlyph;
+        const size_t end = run + 1 < cache.OutlineRuns.size()
+                               ? cache.OutlineRuns[run + 1].FirstGlyph
+                               : cache.GlyphCount;
+
+        params.OutlineColor = cache.OutlineRuns[run].Color;
+        params.OutlineColor.a *= outlineOpacity;
+        DrawSDFText(sdfFont->Sheet, maskedSheet,
+                    vertices.subspan(first * 4, (end - first) * 4),
+                    std::span(cache.Indices).first((end - first) * 6), params);
+      }
+      break;
+    }
+  }
+}
 
-  DrawVertices(font->ForegroundSheet, maskedSheet, shader, vertices, indices);
+void BaseRenderer::DrawSDFText(
+    const SpriteSheet& sheet, const SpriteSheet* mask,
+    const std::span<const VertexBufferSprites> vertices,
+    const std::span<const uint16_t> indices, const SDFTextParams& params) {
+  DrawVertices(sheet, mask,
+               mask == nullptr ? ShaderProgramType::Sprite
+                               : ShaderProgramType::MaskedSpriteNoAlpha,
+               vertices, indices);
+}
+
+void GlyphQuadCache::Translate(glm::vec2 offset) {
+  if (Generation == 0) return;
+
+  const glm::vec2 maskUVOffset = offset / WindowDimensions;
+  for (VertexBufferSprites& vertex : Vertices) {
+    vertex.Position += offset;
+    vertex.MaskUV += maskUVOffset;
+  }
 }
 
 void BaseRenderer::QuadSetPosition(CornersQuad quad, glm::vec2* const pos,
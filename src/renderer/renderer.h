@@ -6,6 +6,7 @@
 #include "../spritesheet.h"
 #include "../text.h"
 #include "yuvframe.h"
+#include "glyphcache.h"
 #include <span>
 
 namespace Impacto {
@@ -13,19 +14,10 @@ namespace Impacto {
 inline GraphicsApi GraphicsApiHint;
 inline GraphicsApi ActualGraphicsApi;
 
-enum class RendererOutlineMode { None, BottomRight, Full };
-
 enum class StencilBufferMode { Off, Test, Write };
 
 constexpr inline int MaxFramebuffers = 10;
 
-struct VertexBufferSprites {
-  glm::vec2 Position = {0.0f, 0.0f};
-  glm::vec2 UV = {0.0f, 0.0f};
-  glm::vec4 Tint = glm::vec4(1.0f);
-  glm::vec2 MaskUV = {0.0f, 0.0f};
-};
-
 BETTER_ENUM(ShaderProgramType, int, AdditiveMaskedSprite, CCMessageBoxSprite,
             CHLCCMenuBackground, ColorBurnMaskedSprite, ColorDodgeMaskedSprite,
             ColorMaskedSprite, HardLightMaskedSprite, LinearBurnMaskedSprite,
@@ -286,18 +278,6 @@ class BaseRenderer {
   virtual void DrawCHLCCMenuBackground(const Sprite& sprite, const Sprite& mask,
                                        const RectF& dest, float alpha) = 0;
 
-  void DrawProcessedText_BasicFont(std::span<const ProcessedTextGlyph> text,
-                                   BasicFont* font, float opacity,
-                                   RendererOutlineMode outlineMode,
-                                   bool smoothstepGlyphOpacity,
-                                   float outlineOpacity,
-                                   SpriteSheet* maskedSheet);
-
-  void DrawProcessedText_LBFont(std::span<const ProcessedTextGlyph> text,
-                                LBFont* font, float opacity,
-                                RendererOutlineMode outlineMode,
-                                bool smoothstepGlyphOpacity,
-                                float outlineOpacity, SpriteSheet* maskedSheet);
   void DrawProcessedText(
       std::span<const ProcessedTextGlyph> text, Font* font,
       float opacity = 1.0f,
@@ -310,6 +290,37 @@ class BaseRenderer {
       RendererOutlineMode outlineMode = RendererOutlineMode::None,
       bool smoothstepGlyphOpacity = true, SpriteSheet* maskedSheet = nullptr);
 
+  // Draws text through a cache owned by the caller, which is rebaked whenever
+  // generation (the layout generation of the text) or the draw parameters
+  // change. Generation 0 never hits the cache.
+  void DrawProcessedText(
+      GlyphQuadCache& cache, uint32_t generation,
+      std::span<const ProcessedTextGlyph> text, Font* font, float opacity,
+      float outlineOpacity,
+      RendererOutlineMode outlineMode = RendererOutlineMode::None,
+      bool smoothstepGlyphOpacity = true, SpriteSheet* maskedSheet = nullptr);
+
+  void DrawProcessedText(
+      GlyphQuadCache& cache, uint32_t generation,
+      std::span<const ProcessedTextGlyph> text, Font* font,
+      float opacity = 1.0f,
+      RendererOutlineMode outlineMode = RendererOutlineMode::None,
+      bool smoothstepGlyphOpacity = true, SpriteSheet* maskedSheet = nullptr) {
+    DrawProcessedText(cache, generation, text, font, opacity, opacity,
+                      outlineMode, smoothstepGlyphOpacity, maskedSheet);
+  }
+
+  // Whether DrawSDFText really draws the field, SDF fonts load their bitmap
+  // fallback sheet instead when it doesn't
+  virtual bool SupportsSDFText() const { return false; }
+
+  // go. Renderers without SDF support draw the raw field instead.
+  // go. Renderers without the SDF shaders draw the raw field instead.
+  virtual void DrawSDFText(const SpriteSheet& sheet, const SpriteSheet* mask,
+                           std::span<const VertexBufferSprites> vertices,
+                           std::span<const uint16_t> indices,
+                           const SDFTextParams& params);
+
   virtual void DrawVideoTexture(const YUVFrame& frame, const RectF& dest,
                                 glm::vec4 tint, bool alphaVideo = false) = 0;
 
@@ -318,6 +329,19 @@ class BaseRenderer {
   virtual void SetFramebuffer(size_t buffer) = 0;
   virtual int GetFramebufferTexture(size_t buffer) = 0;
 
+  // Offscreen layers retaining rendered UI, see UI::CachedLayer. Renderers
+  // without support return 0 from CreateCachedLayer(), in which case callers
+  // keep drawing directly.
+  virtual uint32_t CreateCachedLayer() { return 0; }
+  virtual void FreeCachedLayer(uint32_t layer) {}
+  // Whether the layer still holds what was last rendered into it, which isn't
+  // the case e.g. after the window was resized
+  virtual bool CachedLayerIsValid(uint32_t layer) { return false; }
+  // Redirects drawing into the cleared layer until EndCachedLayer()
+  virtual void BeginCachedLayer(uint32_t layer) {}
+  virtual void EndCachedLayer() {}
+  virtual void DrawCachedLayer(uint32_t layer, float opacity = 1.0f) {}
+
   virtual void EnableScissor() = 0;
   virtual void SetScissorRect(RectF const& rect) = 0;
   virtual void DisableScissor() = 0;
@@ -349,6 +373,23 @@ class BaseRenderer {
 
   void QuadSetPosition(CornersQuad destQuad, glm::vec2* positions, int stride);
 
+  void BakeGlyphQuads_BasicFont(GlyphQuadCache& cache,
+                                std::span<const ProcessedTextGlyph> text,
+                                BasicFont* font,
+                                RendererOutlineMode outlineMode);
+  void BakeGlyphQuads_LBFont(GlyphQuadCache& cache,
+                             std::span<const ProcessedTextGlyph> text,
+                             LBFont* font, RendererOutlineMode outlineMode);
+  void BakeGlyphQuads_SDFFont(GlyphQuadCache& cache,
+                              std::span<const ProcessedTextGlyph> text,
+                              SDFFont* font, RendererOutlineMode outlineMode);
+  void DrawGlyphQuads(const GlyphQuadCache& cache, Font* font,
+                      SpriteSheet* maskedSheet, float opacity,
+                      float outlineOpacity);
+
+  // Used for text drawn without a cache of its own
+  GlyphQuadCache ScratchGlyphQuads;
+
   virtual glm::vec2 DesignToNDC(glm::vec2 designCoord) const {
     return designCoord;
   }
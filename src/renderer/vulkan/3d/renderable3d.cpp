@@ -297,6 +297,7 @@ bool Renderable3D::LoadSync(uint32_t modelId) {
 
   InitMeshAnimStatus();
   ReloadDefaultBoneTransforms();
+  Poser.Init(StaticModel);
 
   Animator.Character = this;
   SwitchAnimation(StaticModel->IdleAnimation, 0.0f);
@@ -317,6 +318,7 @@ void Renderable3D::MakePlane() {
 
   InitMeshAnimStatus();
   ReloadDefaultBoneTransforms();
+  Poser.Init(StaticModel);
 
   IsUsed = true;
 }
@@ -343,7 +345,25 @@ void Renderable3D::InitMeshAnimStatus() {
       vmaMapMemory(Allocator, CurrentMorphedVerticesVk[i].Allocation,
                    &CurrentMorphedVerticesVkMapped[i]);
     }
+
+    // Only positions and normals get morphed, the rest is copied once
+    const size_t stride = Profile::Scene3D::Version == +LKMVersion::DaSH
+                              ? sizeof(VertexBufferDaSH)
+                              : sizeof(VertexBuffer);
+    for (uint32_t i = 0; i < StaticModel->MeshCount; i++) {
+      const Mesh& mesh = StaticModel->Meshes[i];
+      if (mesh.MorphTargetCount == 0) continue;
+      for (int j = 0; j < MAX_FRAMES_IN_FLIGHT; j++) {
+        memcpy((uint8_t*)CurrentMorphedVerticesVkMapped[j] +
+                   MeshAnimStatus[i].MorphedVerticesOffset * stride,
+               (uint8_t*)StaticModel->VertexBuffers +
+                   mesh.VertexOffset * stride,
+               mesh.VertexCount * stride);
+      }
+    }
   }
+  Morphs.Init(StaticModel);
+  memset(UploadedMorphVersions, 0, sizeof(UploadedMorphVersions));
   ReloadDefaultMeshAnimStatus();
 }
 
@@ -393,153 +413,6 @@ void Renderable3D::ReloadDefaultBoneTransforms() {
   }
 }
 
-void Renderable3D::CalculateMorphedVertices(int id) {
-  Mesh* mesh = &StaticModel->Meshes[id];
-  AnimatedMesh* animStatus = &MeshAnimStatus[id];
-  AnimatedMesh* prevAnimStatus = &PrevMeshAnimStatus[id];
-  if (mesh->MorphTargetCount == 0) return;
-
-  void* currentMorphedVertex;
-  if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-    currentMorphedVertex =
-        ((VertexBufferDaSH*)CurrentMorphedVerticesVkMapped[CurrentFrameIndex]) +
-        animStatus->MorphedVerticesOffset;
-  } else {
-    currentMorphedVertex =
-        ((VertexBuffer*)CurrentMorphedVerticesVkMapped[CurrentFrameIndex]) +
-        animStatus->MorphedVerticesOffset;
-  }
-  VertexBuffer* currentMorphedVertexRNE = (VertexBuffer*)currentMorphedVertex;
-  VertexBufferDaSH* currentMorphedVertexDaSH =
-      (VertexBufferDaSH*)currentMorphedVertex;
-
-  void* currentVertex;
-  if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-    currentVertex =
-        ((VertexBufferDaSH*)StaticModel->VertexBuffers) + mesh->VertexOffset;
-  } else {
-    currentVertex =
-        ((VertexBuffer*)StaticModel->VertexBuffers) + mesh->VertexOffset;
-  }
-
-  VertexBuffer* currentVertexRNE = (VertexBuffer*)currentVertex;
-  VertexBufferDaSH* currentVertexDaSH = (VertexBufferDaSH*)currentVertex;
-
-  for (uint32_t j = 0; j < mesh->VertexCount; j++) {
-    if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-      memcpy(currentMorphedVertexDaSH, currentVertexDaSH,
-             sizeof(VertexBufferDaSH));
-      currentMorphedVertexDaSH++;
-      currentVertexDaSH++;
-    } else {
-      memcpy(currentMorphedVertexRNE, currentVertexRNE, sizeof(VertexBuffer));
-      currentMorphedVertexRNE++;
-      currentVertexRNE++;
-    }
-  }
-
-  for (int k = 0; k < mesh->MorphTargetCount; k++) {
-    float influence;
-    if (PrevPoseWeight > 0.0f) {
-      influence = glm::mix(prevAnimStatus->MorphInfluences[k],
-                           animStatus->MorphInfluences[k],
-                           glm::smoothstep(0.0f, 1.0f, 1.0f - PrevPoseWeight));
-    } else {
-      influence = animStatus->MorphInfluences[k];
-    }
-
-    if (influence == 0.0f) continue;
-
-    if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-      currentMorphedVertex =
-          ((VertexBufferDaSH*)
-               CurrentMorphedVerticesVkMapped[CurrentFrameIndex]) +
-          animStatus->MorphedVerticesOffset;
-    } else {
-      currentMorphedVertex =
-          ((VertexBuffer*)CurrentMorphedVerticesVkMapped[CurrentFrameIndex]) +
-          animStatus->MorphedVerticesOffset;
-    }
-    currentMorphedVertexRNE = (VertexBuffer*)currentMorphedVertex;
-    currentMorphedVertexDaSH = (VertexBufferDaSH*)currentMorphedVertex;
-
-    if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-      currentVertex =
-          ((VertexBufferDaSH*)StaticModel->VertexBuffers) + mesh->VertexOffset;
-    } else {
-      currentVertex =
-          ((VertexBuffer*)StaticModel->VertexBuffers) + mesh->VertexOffset;
-    }
-
-    currentVertexRNE = (VertexBuffer*)currentVertex;
-    currentVertexDaSH = (VertexBufferDaSH*)currentVertex;
-
-    MorphVertexBuffer* currentMorphTargetVbo =
-        StaticModel->MorphVertexBuffers +
-        StaticModel->MorphTargets[mesh->MorphTargetIds[k]].VertexOffset;
-
-    for (uint32_t j = 0; j < mesh->VertexCount; j++) {
-      if (Profile::Scene3D::Version == +LKMVersion::DaSH) {
-        currentMorphedVertexDaSH->Position +=
-            (currentMorphTargetVbo->Position - currentVertexDaSH->Position) *
-            influence;
-        currentMorphedVertexDaSH->Normal +=
-            (currentMorphTargetVbo->Normal - currentVertexDaSH->Normal) *
-            influence;
-        currentVertexDaSH++;
-        currentMorphedVertexDaSH++;
-      } else {
-        currentMorphedVertexRNE->Position +=
-            (currentMorphTargetVbo->Position - currentVertexRNE->Position) *
-            influence;
-        currentMorphedVertexRNE->Normal +=
-            (currentMorphTargetVbo->Normal - currentVertexRNE->Normal) *
-            influence;
-        currentVertexRNE++;
-        currentMorphedVertexRNE++;
-      }
-      currentMorphTargetVbo++;
-    }
-  }
-}
-
-void Renderable3D::Pose() {
-  for (int i = 0; i < StaticModel->RootBoneCount; i++) {
-    PoseBone(StaticModel->RootBones[i]);
-  }
-}
-
-void Renderable3D::PoseBone(int16_t id) {
-  StaticBone* bone = &StaticModel->Bones[id];
-  PosedBone* transformed = &CurrentPose[id];
-
-  glm::mat4 parentWorld;
-  if (bone->Parent < 0) {
-    parentWorld = glm::mat4(1.0);
-  } else {
-    parentWorld = CurrentPose[bone->Parent].World;
-  }
-
-  Transform transform;
-  if (PrevPoseWeight > 0.0f) {
-    transform = PrevBoneTransforms[id].Interpolate(
-        transformed->LocalTransform,
-        glm::smoothstep(0.0f, 1.0f, 1.0f - PrevPoseWeight));
-  } else {
-    transform = transformed->LocalTransform;
-  }
-
-  glm::mat4 local = transform.Matrix();
-
-  transformed->World = parentWorld * local;
-
-  for (int i = 0; i < bone->ChildrenCount; i++) {
-    PoseBone(bone->Children[i]);
-  }
-
-  transformed->Offset = transformed->World * bone->BindInverse;
-}
-
 void Renderable3D::Update(float dt) {
   if (!IsUsed) return;
   if (Animator.CurrentAnimation) {
@@ -550,14 +423,15 @@ void Renderable3D::Update(float dt) {
       Animator.Update(dt);
     }
   }
-  Pose();
+  Poser.Pose(CurrentPose, PrevBoneTransforms, PrevPoseWeight);
   if (PrevPoseWeight > 0.0f) {
     PrevPoseWeight -= dt / AnimationTransitionTime;
     if (PrevPoseWeight < 0.0f) PrevPoseWeight = 0.0f;
   }
 
   for (uint32_t i = 0; i < StaticModel->MeshCount; i++) {
-    CalculateMorphedVertices(i);
+    Morphs.SetInfluences(i, MeshAnimStatus[i].MorphInfluences,
+                         PrevMeshAnimStatus[i].MorphInfluences, PrevPoseWeight);
   }
 }
 
@@ -785,6 +659,16 @@ void Renderable3D::DrawMesh(int id, RenderPass pass) {
     size_t stride = Profile::Scene3D::Version == +LKMVersion::DaSH
                         ? sizeof(VertexBufferDaSH)
                         : sizeof(VertexBuffer);
+    // Every frame in flight has its own copy, each one catches up on its own
+    uint32_t& uploadedVersion = UploadedMorphVersions[CurrentFrameIndex][id];
+    if (uploadedVersion != Morphs.Version(id)) {
+      Morphs.CopyVertices(
+          id,
+          (uint8_t*)CurrentMorphedVerticesVkMapped[CurrentFrameIndex] +
+              MeshAnimStatus[id].MorphedVerticesOffset * stride,
+          stride);
+      uploadedVersion = Morphs.Version(id);
+    }
     VkDeviceSize offsets[] = {
         (VkDeviceSize)(MeshAnimStatus[id].MorphedVerticesOffset * stride)};
     vkCmdBindVertexBuffers(CommandBuffers[CurrentFrameIndex], 0, 1,
@@ -1010,10 +894,7 @@ void Renderable3D::UnloadSync() {
                        CurrentMorphedVerticesVk[i].Allocation);
     }
   }
-  if (CurrentMorphedVertices) {
-    free(CurrentMorphedVertices);
-    CurrentMorphedVertices = 0;
-  }
+  Morphs.Clear();
   ModelTransform = Transform();
   IsSubmitted = false;
   IsUsed = false;
@@ -59,11 +59,6 @@ class Renderable3D : public IRenderable3D {
   void MainThreadOnLoad() override;
 
  private:
-  void Pose();
-  void PoseBone(int16_t id);
-
-  void CalculateMorphedVertices(int id);
-
   void UseMaterial(MaterialType type);
   void UseMesh(int id);
   void LoadModelUniforms();
@@ -94,6 +89,7 @@ class Renderable3D : public IRenderable3D {
 
   AllocatedBuffer CurrentMorphedVerticesVk[MAX_FRAMES_IN_FLIGHT];
   void* CurrentMorphedVerticesVkMapped[MAX_FRAMES_IN_FLIGHT];
+  uint32_t UploadedMorphVersions[MAX_FRAMES_IN_FLIGHT][ModelMaxMeshesPerModel];
 
   uint32_t TexBuffers[ModelMaxTexturesPerModel];
 
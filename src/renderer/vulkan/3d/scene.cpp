@@ -50,11 +50,15 @@ void Scene3D::Shutdown() {
 }
 
 void Scene3D::Update(float dt) {
+  std::vector<MorphEngine*> morphs;
   for (int i = 0; i < Profile::Scene3D::MaxRenderables; i++) {
     if (Renderables[i]->Status == LoadStatus::Loaded) {
       Renderables[i]->Update(dt);
+      morphs.push_back(&Renderables[i]->Morphs);
     }
   }
+  // All models at once, so they can share the worker threads
+  MorphEngine::BlendDirty(morphs);
 }
 void Scene3D::Render() {
   RectF viewport = Window->GetViewport();
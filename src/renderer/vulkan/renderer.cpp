@@ -514,15 +514,37 @@ void Renderer::CreateVertexBuffer() {
 }
 
 void Renderer::CreateIndexBuffer() {
-  IndexBufferAlloc =
-      CreateBuffer(IndexBufferCount, VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-                   VMA_MEMORY_USAGE_CPU_ONLY);
+  IndexBufferAlloc = CreateBuffer(IndexBufferCount * sizeof(uint16_t),
+                                  VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                  VMA_MEMORY_USAGE_CPU_ONLY);
 
   void* data;
   vmaMapMemory(Allocator, IndexBufferAlloc.Allocation, &data);
   IndexBuffer = (uint16_t*)data;
 }
 
+void Renderer::CreateQuadIndexBuffer() {
+  QuadIndexBufferAlloc = CreateBuffer(QuadIndexBufferCount * sizeof(uint16_t),
+                                      VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                      VMA_MEMORY_USAGE_CPU_TO_GPU);
+
+  void* data;
+  vmaMapMemory(Allocator, QuadIndexBufferAlloc.Allocation, &data);
+  uint16_t* indices = (uint16_t*)data;
+  for (int quad = 0; quad < QuadIndexBufferCount / 6; quad++) {
+    const uint16_t base = (uint16_t)(quad * 4);
+    // bottom-left -> top-left -> top-right
+    indices[quad * 6 + 0] = base + 0;
+    indices[quad * 6 + 1] = base + 1;
+    indices[quad * 6 + 2] = base + 2;
+    // bottom-left -> top-right -> bottom-right
+    indices[quad * 6 + 3] = base + 0;
+    indices[quad * 6 + 4] = base + 2;
+    indices[quad * 6 + 5] = base + 3;
+  }
+  vmaUnmapMemory(Allocator, QuadIndexBufferAlloc.Allocation);
+}
+
 void Renderer::CreateDescriptors() {
   std::vector<VkDescriptorPoolSize> sizes = {
       {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 10},
@@ -684,6 +706,7 @@ void Renderer::Init() {
   CreateCommandPool();
   CreateVertexBuffer();
   CreateIndexBuffer();
+  CreateQuadIndexBuffer();
   CreateCommandBuffer();
   CreateSyncObjects();
   CreateDescriptors();
@@ -834,6 +857,9 @@ void Renderer::Shutdown() {
   vmaUnmapMemory(Allocator, IndexBufferAlloc.Allocation);
   vmaDestroyBuffer(Allocator, IndexBufferAlloc.Buffer,
                    IndexBufferAlloc.Allocation);
+  vmaDestroyBuffer(Allocator, QuadIndexBufferAlloc.Buffer,
+                   QuadIndexBufferAlloc.Allocation);
+  DestroyOverflowBuffers();
   vkDestroyImageView(Device, DepthImageView, nullptr);
   vmaDestroyImage(Allocator, DepthImage.Image, DepthImage.Allocation);
   vkDestroyImageView(Device, ColorImageView, nullptr);
@@ -887,6 +913,11 @@ void Renderer::BeginFrame() {
     Window->Shutdown();
   }
 
+  // Transfers can't be recorded inside the render pass
+  if (VideoFrameInternal) {
+    VideoFrameInternal->RecordUpload(CommandBuffers[CurrentFrameIndex]);
+  }
+
   VkRenderPassBeginInfo renderPassInfo{};
   renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
   renderPassInfo.renderPass = RenderPass;
@@ -933,8 +964,21 @@ void Renderer::BeginFrame() {
   PreviousScissorRect = RectF(0.0f, 0.0f, (float)SwapChainExtent.width,
                               (float)SwapChainExtent.height);
 
-  VertexBufferOffset = 0;
-  IndexBufferOffset = 0;
+  // The fence above guarantees the GPU is done with this frame's segment,
+  // and its overflow buffers
+  CurrentVertexBuffer = VertexBufferAlloc.Buffer;
+  CurrentVertexData = VertexBuffer;
+  VertexBufferOffset = CurrentFrameIndex * VertexSegmentSize;
+  VertexBufferEnd = VertexBufferOffset + VertexSegmentSize;
+  VertexOverflowUsed = 0;
+  CurrentIndexBuffer = IndexBufferAlloc.Buffer;
+  CurrentIndexData = (uint8_t*)IndexBuffer;
+  IndexBufferOffset = CurrentFrameIndex * IndexSegmentCount * sizeof(uint16_t);
+  IndexBufferEnd = IndexBufferOffset + IndexSegmentCount * sizeof(uint16_t);
+  IndexOverflowUsed = 0;
+  VertexBufferFill = 0;
+  VertexBufferCount = 0;
+  IndexBufferFill = 0;
 }
 
 void Renderer::BeginFrame2D() {}
@@ -1159,12 +1203,7 @@ void Renderer::DrawSprite(const Sprite& sprite, const CornersQuad& dest,
   EnsureTextureBound(sprite.Sheet.Texture);
 
   // OK, all good, make quad
-  MakeQuad();
-
-  VertexBufferSprites* vertices =
-      (VertexBufferSprites*)(VertexBuffer + VertexBufferOffset +
-                             VertexBufferFill);
-  VertexBufferFill += 4 * sizeof(VertexBufferSprites);
+  VertexBufferSprites* vertices = MakeQuad();
 
   QuadSetUV(sprite.Bounds, sprite.Sheet.GetDimensions(), &vertices[0].UV,
             sizeof(VertexBufferSprites));
@@ -1237,12 +1276,7 @@ void Renderer::DrawMaskedSprite(
       VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(SpritePushConstants), &constants);
 
   // OK, all good, make quad
-  MakeQuad();
-
-  VertexBufferSprites* vertices =
-      (VertexBufferSprites*)(VertexBuffer + VertexBufferOffset +
-                             VertexBufferFill);
-  VertexBufferFill += 4 * sizeof(VertexBufferSprites);
+  VertexBufferSprites* vertices = MakeQuad();
 
   QuadSetUV(sprite.Bounds, sprite.Sheet.GetDimensions(), &vertices[0].UV,
             sizeof(VertexBufferSprites));
@@ -1335,12 +1369,7 @@ void Renderer::DrawMaskedSpriteOverlay(
   }
 
   // OK, all good, make quad
-  MakeQuad();
-
-  VertexBufferSprites* vertices =
-      (VertexBufferSprites*)(VertexBuffer + VertexBufferOffset +
-                             VertexBufferFill);
-  VertexBufferFill += 4 * sizeof(VertexBufferSprites);
+  VertexBufferSprites* vertices = MakeQuad();
 
   QuadSetUV(sprite.Bounds, sprite.Sheet.GetDimensions(), &vertices[0].UV,
             sizeof(VertexBufferSprites));
@@ -1373,6 +1402,35 @@ void Renderer::DrawVertices(const SpriteSheet& sheet,
   // The index buffer needs to be flushed
   Flush();
 
+  if (mask != nullptr) {
+    EnsureMode(PipelineMaskedSpriteNoAlpha);
+    PushTextureDescriptors(sheet, mask);
+    MaskedNoAlphaPushConstants constants = {};
+    constants.Alpha = glm::vec2(1.0f, 0.0f);
+    constants.IsInverted = inverted;
+    vkCmdPushConstants(CommandBuffers[CurrentFrameIndex],
+                       CurrentPipeline->PipelineLayout,
+                       VK_SHADER_STAGE_FRAGMENT_BIT, 0,
+                       sizeof(MaskedNoAlphaPushConstants), &constants);
+  } else {
+    if (inverted)
+      EnsureMode(PipelineSpriteInverted);
+    else
+      EnsureMode(PipelineSprite);
+
+    EnsureTextureBound(sheet.Texture);
+  }
+
+  PushVertices(vertices, indices, spriteTransformation, maskTransformation);
+}
+
+void Renderer::PushTextureDescriptors(const SpriteSheet& sheet,
+                                      const SpriteSheet* const mask) {
+  VkDescriptorImageInfo imageBufferInfo[2];
+  imageBufferInfo[0].sampler = Sampler;
+  imageBufferInfo[0].imageView = Textures[sheet.Texture].ImageView;
+  imageBufferInfo[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
   if (mask != nullptr) {
     VkSamplerCreateInfo samplerInfo = {};
     samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
@@ -1385,47 +1443,33 @@ void Renderer::DrawVertices(const SpriteSheet& sheet,
     samplerInfo.anisotropyEnable = VK_TRUE;
     samplerInfo.maxAnisotropy = 16;
 
-    VkDescriptorImageInfo imageBufferInfo[2];
-    imageBufferInfo[0].sampler = Sampler;
-    imageBufferInfo[0].imageView = Textures[sheet.Texture].ImageView;
-    imageBufferInfo[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
     vkCreateSampler(Device, &samplerInfo, nullptr, &imageBufferInfo[1].sampler);
     imageBufferInfo[1].imageView = Textures[mask->Texture].ImageView;
     imageBufferInfo[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+  }
 
-    VkWriteDescriptorSet writeDescriptorSet{};
-    writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    writeDescriptorSet.dstSet = 0;
-    writeDescriptorSet.dstBinding = 0;
-    writeDescriptorSet.descriptorCount = 2;
-    writeDescriptorSet.descriptorType =
-        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    writeDescriptorSet.pImageInfo = imageBufferInfo;
+  VkWriteDescriptorSet writeDescriptorSet{};
+  writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  writeDescriptorSet.dstSet = 0;
+  writeDescriptorSet.dstBinding = 0;
+  writeDescriptorSet.descriptorCount = mask != nullptr ? 2 : 1;
+  writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  writeDescriptorSet.pImageInfo = imageBufferInfo;
 
-    EnsureMode(PipelineMaskedSpriteNoAlpha);
-    vkCmdPushDescriptorSetKHR(
-        CommandBuffers[CurrentFrameIndex], VK_PIPELINE_BIND_POINT_GRAPHICS,
-        CurrentPipeline->PipelineLayout, 0, 1, &writeDescriptorSet);
-    MaskedNoAlphaPushConstants constants = {};
-    constants.Alpha = glm::vec2(1.0f, 0.0f);
-    constants.IsInverted = inverted;
-    vkCmdPushConstants(CommandBuffers[CurrentFrameIndex],
-                       CurrentPipeline->PipelineLayout,
-                       VK_SHADER_STAGE_FRAGMENT_BIT, 0,
-                       sizeof(MaskedNoAlphaPushConstants), &constants);
-  } else {
-    if (inverted)
-      EnsureMode(PipelineSpriteInverted);
-    else
-      EnsureMode(PipelineSprite);
+  vkCmdPushDescriptorSetKHR(
+      CommandBuffers[CurrentFrameIndex], VK_PIPELINE_BIND_POINT_GRAPHICS,
+      CurrentPipeline->PipelineLayout, 0, 1, &writeDescriptorSet);
+}
 
-    EnsureTextureBound(sheet.Texture);
-  }
+void Renderer::PushVertices(const std::span<const VertexBufferSprites> vertices,
+                            const std::span<const uint16_t> indices,
+                            const glm::mat4 spriteTransformation,
+                            const glm::mat4 maskTransformation) {
+  ReserveGeometry(vertices.size_bytes(), indices.size_bytes());
 
   // Push vertices
   VertexBufferSprites* vertexBuffer =
-      (VertexBufferSprites*)(VertexBuffer + VertexBufferOffset +
+      (VertexBufferSprites*)(CurrentVertexData + VertexBufferOffset +
                              VertexBufferFill);
   VertexBufferFill += vertices.size_bytes();
 
@@ -1441,9 +1485,10 @@ void Renderer::DrawVertices(const SpriteSheet& sheet,
                  vertexInfoToNDC);
 
   // Push indices
+  uint16_t* indexBuffer = (uint16_t*)(CurrentIndexData + IndexBufferOffset +
+                                      IndexBufferFill * sizeof(uint16_t));
   IndexBufferFill += indices.size();
-  size_t indexBufferOffset = IndexBufferOffset / sizeof(uint16_t);
-  std::copy(indices.begin(), indices.end(), IndexBuffer + indexBufferOffset);
+  std::copy(indices.begin(), indices.end(), indexBuffer);
 
   // Flush again and bind back our buffer
   Flush();
@@ -1497,12 +1542,7 @@ void Renderer::DrawCCMessageBox(Sprite const& sprite, Sprite const& mask,
       VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(CCBoxPushConstants), &constants);
 
   // OK, all good, make quad
-  MakeQuad();
-
-  VertexBufferSprites* vertices =
-      (VertexBufferSprites*)(VertexBuffer + VertexBufferOffset +
-                             VertexBufferFill);
-  VertexBufferFill += 4 * sizeof(VertexBufferSprites);
+  VertexBufferSprites* vertices = MakeQuad();
 
   QuadSetUV(sprite.Bounds, sprite.Sheet.GetDimensions(), &vertices[0].UV,
             sizeof(VertexBufferSprites));
@@ -1560,12 +1600,7 @@ void Renderer::DrawCHLCCMenuBackground(const Sprite& sprite, const Sprite& mask,
       VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(CCBoxPushConstants), &constants);
 
   // OK, all good, make quad
-  MakeQuad();
-
-  VertexBufferSprites* vertices =
-      (VertexBufferSprites*)(VertexBuffer + VertexBufferOffset +
-                             VertexBufferFill);
-  VertexBufferFill += 4 * sizeof(VertexBufferSprites);
+  VertexBufferSprites* vertices = MakeQuad();
 
   QuadSetUV(sprite.Bounds, sprite.Sheet.GetDimensions(), &vertices[0].UV,
             sizeof(VertexBufferSprites));
@@ -1575,28 +1610,93 @@ void Renderer::DrawCHLCCMenuBackground(const Sprite& sprite, const Sprite& mask,
   QuadSetPosition(dest, &vertices[0].Position, sizeof(VertexBufferSprites));
 }
 
-inline void Renderer::MakeQuad() {
-  size_t indexBufferOffset = IndexBufferOffset / sizeof(uint16_t);
-  if (IndexBufferFill + 6 <= IndexBufferCount) {
-    // bottom-left -> top-left -> top-right
-    IndexBuffer[indexBufferOffset + IndexBufferFill] =
-        (uint16_t)VertexBufferCount + 0;
-    IndexBuffer[indexBufferOffset + IndexBufferFill + 1] =
-        (uint16_t)VertexBufferCount + 1;
-    IndexBuffer[indexBufferOffset + IndexBufferFill + 2] =
-        (uint16_t)VertexBufferCount + 2;
-    // bottom-left -> top-right -> bottom-right
-    IndexBuffer[indexBufferOffset + IndexBufferFill + 3] =
-        (uint16_t)VertexBufferCount + 0;
-    IndexBuffer[indexBufferOffset + IndexBufferFill + 4] =
-        (uint16_t)VertexBufferCount + 2;
-    IndexBuffer[indexBufferOffset + IndexBufferFill + 5] =
-        (uint16_t)VertexBufferCount + 3;
-    IndexBufferFill += 6;
-    VertexBufferCount += 4;
+Renderer::OverflowBuffer& Renderer::NextOverflowBuffer(
+    std::vector<OverflowBuffer>& buffers, size_t& used, size_t minSize,
+    VkBufferUsageFlags usage) {
+  if (used == buffers.size() || buffers[used].Size < minSize) {
+    OverflowBuffer buffer;
+    buffer.Size = std::max(minSize, (size_t)VertexSegmentSize);
+    buffer.Alloc =
+        CreateBuffer(buffer.Size, usage, VMA_MEMORY_USAGE_CPU_ONLY);
+    void* data;
+    vmaMapMemory(Allocator, buffer.Alloc.Allocation, &data);
+    buffer.Data = (uint8_t*)data;
+    ImpLog(LogLevel::Warning, LogChannel::Render,
+           "Frame geometry exceeded its segment, allocated another {:d} KiB "
+           "buffer\n",
+           buffer.Size / 1024);
+
+    // Only ever used by this frame, which the GPU is done with
+    if (used < buffers.size()) {
+      vmaUnmapMemory(Allocator, buffers[used].Alloc.Allocation);
+      vmaDestroyBuffer(Allocator, buffers[used].Alloc.Buffer,
+                       buffers[used].Alloc.Allocation);
+      buffers[used] = buffer;
+    } else {
+      buffers.push_back(buffer);
+    }
+  }
+  return buffers[used++];
+}
+
+void Renderer::DestroyOverflowBuffers() {
+  for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+    for (auto* buffers : {&VertexOverflow[i], &IndexOverflow[i]}) {
+      for (OverflowBuffer& buffer : *buffers) {
+        vmaUnmapMemory(Allocator, buffer.Alloc.Allocation);
+        vmaDestroyBuffer(Allocator, buffer.Alloc.Buffer,
+                         buffer.Alloc.Allocation);
+      }
+      buffers->clear();
+    }
+  }
+}
+
+void Renderer::ReserveGeometry(size_t vertexBytes, size_t indexBytes) {
+  const bool vertexFits =
+      VertexBufferOffset + VertexBufferFill + vertexBytes <= VertexBufferEnd;
+  const bool indexFits = IndexBufferOffset +
+                             IndexBufferFill * sizeof(uint16_t) +
+                             indexBytes <=
+                         IndexBufferEnd;
+  if (vertexFits && indexFits) return;
+
+  // Draw what we have from the current buffers before switching
+  Flush();
+
+  if (VertexBufferOffset + vertexBytes > VertexBufferEnd) {
+    OverflowBuffer& buffer = NextOverflowBuffer(
+        VertexOverflow[CurrentFrameIndex], VertexOverflowUsed, vertexBytes,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    CurrentVertexBuffer = buffer.Alloc.Buffer;
+    CurrentVertexData = buffer.Data;
+    VertexBufferOffset = 0;
+    VertexBufferEnd = buffer.Size;
+  }
+  if (IndexBufferOffset + indexBytes > IndexBufferEnd) {
+    OverflowBuffer& buffer = NextOverflowBuffer(
+        IndexOverflow[CurrentFrameIndex], IndexOverflowUsed, indexBytes,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+    CurrentIndexBuffer = buffer.Alloc.Buffer;
+    CurrentIndexData = buffer.Data;
+    IndexBufferOffset = 0;
+    IndexBufferEnd = buffer.Size;
   }
 }
 
+VertexBufferSprites* Renderer::MakeQuad() {
+  // Stay within what the prebuilt quad indices can address
+  if (VertexBufferCount + 4 > MaxQuadBatchVertices) Flush();
+  ReserveGeometry(4 * sizeof(VertexBufferSprites), 0);
+
+  VertexBufferSprites* vertices =
+      (VertexBufferSprites*)(CurrentVertexData + VertexBufferOffset +
+                             VertexBufferFill);
+  VertexBufferFill += 4 * sizeof(VertexBufferSprites);
+  VertexBufferCount += 4;
+  return vertices;
+}
+
 void Renderer::EnsureTextureBound(unsigned int texture) {
   if (CurrentTexture != texture) {
     ImpLogSlow(LogLevel::Trace, LogChannel::Render,
@@ -1646,17 +1746,26 @@ void Renderer::Flush() {
     return;
   }
 
-  if (VertexBufferFill > 0 && IndexBufferFill > 0) {
-    VkBuffer vertexBuffers[] = {VertexBufferAlloc.Buffer};
+  if (VertexBufferFill > 0) {
+    VkBuffer vertexBuffers[] = {CurrentVertexBuffer};
     VkDeviceSize offsets[] = {(VkDeviceSize)VertexBufferOffset};
     vkCmdBindVertexBuffers(CommandBuffers[CurrentFrameIndex], 0, 1,
                            vertexBuffers, offsets);
-    vkCmdBindIndexBuffer(CommandBuffers[CurrentFrameIndex],
-                         IndexBufferAlloc.Buffer, IndexBufferOffset,
-                         VK_INDEX_TYPE_UINT16);
 
-    vkCmdDrawIndexed(CommandBuffers[CurrentFrameIndex],
-                     (uint32_t)IndexBufferFill, 1, 0, 0, 0);
+    if (IndexBufferFill > 0) {
+      // Arbitrary geometry from DrawVertices streams its own indices
+      vkCmdBindIndexBuffer(CommandBuffers[CurrentFrameIndex],
+                           CurrentIndexBuffer, IndexBufferOffset,
+                           VK_INDEX_TYPE_UINT16);
+      vkCmdDrawIndexed(CommandBuffers[CurrentFrameIndex],
+                       (uint32_t)IndexBufferFill, 1, 0, 0, 0);
+    } else if (VertexBufferCount > 0) {
+      vkCmdBindIndexBuffer(CommandBuffers[CurrentFrameIndex],
+                           QuadIndexBufferAlloc.Buffer, 0,
+                           VK_INDEX_TYPE_UINT16);
+      vkCmdDrawIndexed(CommandBuffers[CurrentFrameIndex],
+                       (uint32_t)(VertexBufferCount / 4 * 6), 1, 0, 0, 0);
+    }
   }
   IndexBufferOffset += IndexBufferFill * sizeof(uint16_t);
   IndexBufferFill = 0;
@@ -1707,12 +1816,7 @@ void Renderer::DrawVideoTexture(const YUVFrame& frame, const RectF& dest,
                      sizeof(YUVFramePushConstants), &constants);
 
   // OK, all good, make quad
-  MakeQuad();
-
-  VertexBufferSprites* vertices =
-      (VertexBufferSprites*)(VertexBuffer + VertexBufferOffset +
-                             VertexBufferFill);
-  VertexBufferFill += 4 * sizeof(VertexBufferSprites);
+  VertexBufferSprites* vertices = MakeQuad();
 
   QuadSetUV(RectF(0.0f, 0.0f, frame.Width, frame.Height),
             {frame.Width, frame.Height}, &vertices[0].UV,
@@ -138,14 +138,26 @@ class Renderer : public BaseRenderer {
 
   void CreateVertexBuffer();
   void CreateIndexBuffer();
+  void CreateQuadIndexBuffer();
 
   void CleanupSwapChain();
 
   void EnsureTextureBound(unsigned int texture);
   void EnsureMode(Pipeline* pipeline, bool flush = true);
+  // Binds sheet, and mask if given, to the current pipeline
+  void PushTextureDescriptors(const SpriteSheet& sheet,
+                              const SpriteSheet* mask);
+  // Writes vertices transformed into NDC and indices, and draws them
+  void PushVertices(std::span<const VertexBufferSprites> vertices,
+                    std::span<const uint16_t> indices,
+                    glm::mat4 spriteTransformation,
+                    glm::mat4 maskTransformation);
   void Flush() override;
 
-  void MakeQuad();
+  // Makes room for this much more geometry, moving on to an overflow buffer
+  // of the frame once its segment is full
+  void ReserveGeometry(size_t vertexBytes, size_t indexBytes);
+  VertexBufferSprites* MakeQuad();
 
   glm::vec2 DesignToNDC(glm::vec2 designCoord) const override;
 
@@ -201,19 +213,57 @@ class Renderer : public BaseRenderer {
 
   AllocatedBuffer VertexBufferAlloc;
   AllocatedBuffer IndexBufferAlloc;
+  AllocatedBuffer QuadIndexBufferAlloc;
 
   uint32_t CurrentTexture = 0;
   uint32_t NextTextureId = 1;
 
-  VkYUVFrame* VideoFrameInternal;
+  VkYUVFrame* VideoFrameInternal = nullptr;
 
+  // The persistently mapped vertex and index buffers are split into one
+  // segment per frame in flight, a segment is only reused once the frame's
+  // InFlightFences entry has been waited on in BeginFrame
   static int constexpr VertexBufferSize = 4096 * 4096;
+  static int constexpr VertexSegmentSize =
+      VertexBufferSize / MAX_FRAMES_IN_FLIGHT;
   static int constexpr IndexBufferCount =
       VertexBufferSize / (4 * sizeof(VertexBufferSprites)) * 6;
+  static int constexpr IndexSegmentCount =
+      IndexBufferCount / MAX_FRAMES_IN_FLIGHT;
+
+  // Quads are drawn with a prebuilt index buffer, so a single quad batch is
+  // limited to what 16-bit indices can address
+  static int constexpr MaxQuadBatchVertices = 65536;
+  static int constexpr QuadIndexBufferCount = MaxQuadBatchVertices / 4 * 6;
 
   uint8_t* VertexBuffer;
   uint16_t* IndexBuffer;
 
+  // Extra geometry buffers of a frame, used in order once its segment is full
+  // and reused in later frames
+  struct OverflowBuffer {
+    AllocatedBuffer Alloc;
+    uint8_t* Data;
+    size_t Size;
+  };
+  std::vector<OverflowBuffer> VertexOverflow[MAX_FRAMES_IN_FLIGHT];
+  std::vector<OverflowBuffer> IndexOverflow[MAX_FRAMES_IN_FLIGHT];
+  size_t VertexOverflowUsed = 0;
+  size_t IndexOverflowUsed = 0;
+  OverflowBuffer& NextOverflowBuffer(std::vector<OverflowBuffer>& buffers,
+                                     size_t& used, size_t minSize,
+                                     VkBufferUsageFlags usage);
+  void DestroyOverflowBuffers();
+
+  // Where geometry is currently written to, the frame's segment or an
+  // overflow buffer. Offsets and ends are in bytes.
+  VkBuffer CurrentVertexBuffer;
+  uint8_t* CurrentVertexData;
+  size_t VertexBufferEnd = 0;
+  VkBuffer CurrentIndexBuffer;
+  uint8_t* CurrentIndexData;
+  size_t IndexBufferEnd = 0;
+
   size_t VertexBufferFill = 0;
   size_t VertexBufferOffset = 0;
   size_t VertexBufferCount = 0;
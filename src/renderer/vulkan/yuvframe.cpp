@@ -1,5 +1,7 @@
 #include "yuvframe.h"
 
+#include <cstring>
+
 namespace Impacto {
 namespace Vulkan {
 
@@ -12,9 +14,13 @@ void VkYUVFrame::Init(float width, float height) {
       imageSize + 2 * (((VkDeviceSize)width / 2) * ((VkDeviceSize)height / 2));
   VkFormat imageFormat = VK_FORMAT_R8_UNORM;
 
-  StagingBuffer = CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                               VMA_MEMORY_USAGE_CPU_ONLY);
-  vmaMapMemory(Allocator, StagingBuffer.Allocation, &MappedStagingBuffer);
+  for (int i = 0; i < StagingCount; i++) {
+    StagingBuffers[i] =
+        CreateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VMA_MEMORY_USAGE_CPU_ONLY);
+    vmaMapMemory(Allocator, StagingBuffers[i].Allocation,
+                 &MappedStagingBuffers[i]);
+  }
 
   VkExtent3D lumaImageExtent;
   lumaImageExtent.width = static_cast<uint32_t>(width);
@@ -71,104 +77,123 @@ void VkYUVFrame::Init(float width, float height) {
 }
 
 void VkYUVFrame::Submit(const void* luma, const void* cb, const void* cr) {
-  int cbOffset = (int)(Width * Height);
-  int crOffset = (int)((Width * Height) + ((Width / 2) * (Height / 2)));
-
-  uint8_t* mappedStagingBuffer = (uint8_t*)MappedStagingBuffer;
-
-  memcpy(mappedStagingBuffer, luma, cbOffset);
-  memcpy(mappedStagingBuffer + cbOffset, cb,
-         (size_t)((Width / 2) * (Height / 2)));
-  memcpy(mappedStagingBuffer + crOffset, cr,
-         (size_t)((Width / 2) * (Height / 2)));
-
-  ImmediateSubmit([&](VkCommandBuffer cmd) {
-    VkExtent3D lumaImageExtent;
-    lumaImageExtent.width = static_cast<uint32_t>(Width);
-    lumaImageExtent.height = static_cast<uint32_t>(Height);
-    lumaImageExtent.depth = 1;
-    VkExtent3D cbCrImageExtent;
-    cbCrImageExtent.width = static_cast<uint32_t>(Width / 2);
-    cbCrImageExtent.height = static_cast<uint32_t>(Height / 2);
-    cbCrImageExtent.depth = 1;
-
-    VkImageSubresourceRange range;
-    range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    range.baseMipLevel = 0;
-    range.levelCount = 1;
-    range.baseArrayLayer = 0;
-    range.layerCount = 1;
-
-    VkImageMemoryBarrier imageBarrierToTransfer = {};
-    imageBarrierToTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    imageBarrierToTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageBarrierToTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    imageBarrierToTransfer.image = LumaImage.Image.Image;
-    imageBarrierToTransfer.subresourceRange = range;
-    imageBarrierToTransfer.srcAccessMask = 0;
-    imageBarrierToTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
-                         nullptr, 1, &imageBarrierToTransfer);
-
-    VkBufferImageCopy copyRegion = {};
-    copyRegion.bufferOffset = 0;
-    copyRegion.bufferRowLength = 0;
-    copyRegion.bufferImageHeight = 0;
-    copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    copyRegion.imageSubresource.mipLevel = 0;
-    copyRegion.imageSubresource.baseArrayLayer = 0;
-    copyRegion.imageSubresource.layerCount = 1;
-    copyRegion.imageExtent = lumaImageExtent;
-    vkCmdCopyBufferToImage(cmd, StagingBuffer.Buffer, LumaImage.Image.Image,
-                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
-                           &copyRegion);
-
-    VkImageMemoryBarrier imageBarrierToReadable = imageBarrierToTransfer;
-    imageBarrierToReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    imageBarrierToReadable.newLayout = VK_IMAGE_LAYOUT_GENERAL;
-    imageBarrierToReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    imageBarrierToReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr,
-                         0, nullptr, 1, &imageBarrierToReadable);
-
-    imageBarrierToTransfer.image = CbImage.Image.Image;
-    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
-                         nullptr, 1, &imageBarrierToTransfer);
-
-    copyRegion.bufferOffset = (VkDeviceSize)(Width * Height);
-    copyRegion.imageExtent = cbCrImageExtent;
-    vkCmdCopyBufferToImage(cmd, StagingBuffer.Buffer, CbImage.Image.Image,
-                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
-                           &copyRegion);
-
-    imageBarrierToReadable.image = CbImage.Image.Image;
-    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr,
-                         0, nullptr, 1, &imageBarrierToReadable);
-
-    imageBarrierToTransfer.image = CrImage.Image.Image;
-    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
-                         nullptr, 1, &imageBarrierToTransfer);
-
-    copyRegion.bufferOffset = crOffset;
-    vkCmdCopyBufferToImage(cmd, StagingBuffer.Buffer, CrImage.Image.Image,
-                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
-                           &copyRegion);
-
-    imageBarrierToReadable.image = CrImage.Image.Image;
-    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr,
-                         0, nullptr, 1, &imageBarrierToReadable);
-  });
+  const auto startTime = std::chrono::steady_clock::now();
+
+  // A frame that was never recorded can just be overwritten
+  if (PendingStaging < 0) {
+    PendingStaging = CurrentStaging;
+    CurrentStaging = (CurrentStaging + 1) % StagingCount;
+  }
+
+  const size_t lumaSize = (size_t)(Width * Height);
+  const size_t chromaSize = (size_t)((Width / 2) * (Height / 2));
+  uint8_t* mappedStagingBuffer = (uint8_t*)MappedStagingBuffers[PendingStaging];
+
+  memcpy(mappedStagingBuffer, luma, lumaSize);
+  memcpy(mappedStagingBuffer + lumaSize, cb, chromaSize);
+  memcpy(mappedStagingBuffer + lumaSize + chromaSize, cr, chromaSize);
+
+  RecordUploadTime(startTime);
+}
+
+void VkYUVFrame::RecordUpload(VkCommandBuffer cmd) {
+  if (PendingStaging < 0) return;
+  const VkBuffer stagingBuffer = StagingBuffers[PendingStaging].Buffer;
+  PendingStaging = -1;
+
+  VkExtent3D lumaImageExtent;
+  lumaImageExtent.width = static_cast<uint32_t>(Width);
+  lumaImageExtent.height = static_cast<uint32_t>(Height);
+  lumaImageExtent.depth = 1;
+  VkExtent3D cbCrImageExtent;
+  cbCrImageExtent.width = static_cast<uint32_t>(Width / 2);
+  cbCrImageExtent.height = static_cast<uint32_t>(Height / 2);
+  cbCrImageExtent.depth = 1;
+
+  VkImageSubresourceRange range;
+  range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  range.baseMipLevel = 0;
+  range.levelCount = 1;
+  range.baseArrayLayer = 0;
+  range.layerCount = 1;
+
+  // The whole image is overwritten, so the old contents can be discarded.
+  // Waiting on the fragment shader stage keeps the copy from racing the
+  // previous frame's draw, which reads the same images.
+  VkImageMemoryBarrier imageBarrierToTransfer = {};
+  imageBarrierToTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  imageBarrierToTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  imageBarrierToTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  imageBarrierToTransfer.subresourceRange = range;
+  imageBarrierToTransfer.srcAccessMask = 0;
+  imageBarrierToTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+  VkImageMemoryBarrier imageBarrierToReadable = imageBarrierToTransfer;
+  imageBarrierToReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  imageBarrierToReadable.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+  imageBarrierToReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  imageBarrierToReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+  std::array<VkImageMemoryBarrier, 3> toTransfer;
+  std::array<VkImageMemoryBarrier, 3> toReadable;
+  const std::array<VkImage, 3> images = {
+      LumaImage.Image.Image, CbImage.Image.Image, CrImage.Image.Image};
+  for (size_t i = 0; i < images.size(); i++) {
+    toTransfer[i] = imageBarrierToTransfer;
+    toTransfer[i].image = images[i];
+    toReadable[i] = imageBarrierToReadable;
+    toReadable[i].image = images[i];
+  }
+
+  vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+                       nullptr, (uint32_t)toTransfer.size(), toTransfer.data());
+
+  VkBufferImageCopy copyRegion = {};
+  copyRegion.bufferOffset = 0;
+  copyRegion.bufferRowLength = 0;
+  copyRegion.bufferImageHeight = 0;
+  copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  copyRegion.imageSubresource.mipLevel = 0;
+  copyRegion.imageSubresource.baseArrayLayer = 0;
+  copyRegion.imageSubresource.layerCount = 1;
+  copyRegion.imageExtent = lumaImageExtent;
+  vkCmdCopyBufferToImage(cmd, stagingBuffer, LumaImage.Image.Image,
+                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+
+  copyRegion.bufferOffset = (VkDeviceSize)(Width * Height);
+  copyRegion.imageExtent = cbCrImageExtent;
+  vkCmdCopyBufferToImage(cmd, stagingBuffer, CbImage.Image.Image,
+                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+
+  copyRegion.bufferOffset =
+      (VkDeviceSize)((Width * Height) + ((Width / 2) * (Height / 2)));
+  vkCmdCopyBufferToImage(cmd, stagingBuffer, CrImage.Image.Image,
+                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+
+  vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0,
+                       nullptr, (uint32_t)toReadable.size(), toReadable.data());
 }
 
 void VkYUVFrame::Release() {
-  vmaUnmapMemory(Allocator, StagingBuffer.Allocation);
+  // Frames in flight may still sample the images
+  vkDeviceWaitIdle(MainUploadContext.Device);
+  PendingStaging = -1;
+
+  for (VkTexture* texture : {&LumaImage, &CbImage, &CrImage}) {
+    vkDestroyImageView(MainUploadContext.Device, texture->ImageView, nullptr);
+    vmaDestroyImage(Allocator, texture->Image.Image, texture->Image.Allocation);
+    *texture = {};
+  }
+
+  for (int i = 0; i < StagingCount; i++) {
+    vmaUnmapMemory(Allocator, StagingBuffers[i].Allocation);
+    vmaDestroyBuffer(Allocator, StagingBuffers[i].Buffer,
+                     StagingBuffers[i].Allocation);
+  }
+  StagingBuffers = {};
+  MappedStagingBuffers = {};
 }
 
 }  // namespace Vulkan
@@ -3,6 +3,7 @@
 #include "../yuvframe.h"
 #include "utils.h"
 
+#include <array>
 #include <vulkan/vulkan.h>
 
 namespace Impacto {
@@ -22,9 +23,20 @@ class VkYUVFrame : public YUVFrame {
   VkTexture CbImage{};
   VkTexture CrImage{};
 
+  // Records the copy of the last submitted frame into the frame's command
+  // buffer, which the renderer does before its render pass begins
+  void RecordUpload(VkCommandBuffer cmd);
+
  private:
-  AllocatedBuffer StagingBuffer;
-  void* MappedStagingBuffer;
+  // One staging buffer per frame in flight plus the one being filled, so a
+  // new frame never overwrites data the GPU may still be copying from
+  static constexpr int StagingCount = MAX_FRAMES_IN_FLIGHT + 1;
+
+  std::array<AllocatedBuffer, StagingCount> StagingBuffers{};
+  std::array<void*, StagingCount> MappedStagingBuffers{};
+  int CurrentStaging = 0;
+  // Staging buffer holding a frame that wasn't recorded yet, -1 if none
+  int PendingStaging = -1;
 };
 
 }  // namespace Vulkan
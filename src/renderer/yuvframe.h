@@ -2,8 +2,24 @@
 
 #include "../impacto.h"
 
+#include <algorithm>
+#include <chrono>
+
 namespace Impacto {
 
+struct YUVFrameUploadStats {
+  uint64_t Uploads = 0;
+  float LastUploadMs = 0.0f;
+  float AverageUploadMs = 0.0f;
+  float PeakUploadMs = 0.0f;
+
+  void Reset() { *this = {}; }
+};
+
+// Main thread time spent in YUVFrame::Submit, for comparing movie playback
+// cost across backends and resolutions
+inline YUVFrameUploadStats VideoUploadStats;
+
 class YUVFrame {
  public:
   float Width;
@@ -16,6 +32,20 @@ class YUVFrame {
 
   virtual void Submit(const void* luma, const void* cb, const void* cr) = 0;
   virtual void Release() = 0;
+
+ protected:
+  static void RecordUploadTime(
+      std::chrono::steady_clock::time_point startTime) {
+    const float ms = std::chrono::duration<float, std::milli>(
+                         std::chrono::steady_clock::now() - startTime)
+                         .count();
+    YUVFrameUploadStats& stats = VideoUploadStats;
+    stats.Uploads++;
+    stats.LastUploadMs = ms;
+    stats.AverageUploadMs =
+        stats.Uploads == 1 ? ms : stats.AverageUploadMs * 0.95f + ms * 0.05f;
+    stats.PeakUploadMs = std::max(stats.PeakUploadMs, ms);
+  }
 };
 
-}  // namespace Impacto
\ No newline at end of file
+}  // namespace Impacto
@@ -0,0 +1,36 @@
+in vec2 uv;
+in vec4 tint;
+in vec2 maskUV;
+
+out vec4 color;
+
+uniform sampler2D ColorMap;
+uniform sampler2D Mask;
+uniform vec4 OutlineColor;
+uniform vec2 OutlineOffset;
+uniform float OutlineEdge;
+uniform float Opacity;
+
+// Antialiased coverage of the area above edge, over about one screen pixel
+// whatever the text is scaled to
+float coverage(float dist, float edge) {
+  float width = max(0.7 * fwidth(dist), 0.0001);
+  return smoothstep(edge - width, edge + width, dist);
+}
+
+void main() {
+  float fill = coverage(texture(ColorMap, uv).a, 0.5) * tint.a * Opacity;
+  float outline = coverage(texture(ColorMap, uv - OutlineOffset).a,
+                           OutlineEdge) * tint.a * OutlineColor.a;
+
+  // Fill over outline
+  color.a = fill + outline * (1.0 - fill);
+  color.rgb = (tint.rgb * fill + OutlineColor.rgb * outline * (1.0 - fill)) /
+              max(color.a, 0.0001);
+
+#ifdef IS_MASKED
+  vec3 mask = texture(Mask, maskUV).rgb;
+  color.a *= (max(max(mask.r, mask.g), mask.b) +
+              min(min(mask.r, mask.g), mask.b)) / 2.0;
+#endif
+}
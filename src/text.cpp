@@ -1,5 +1,8 @@
+#include <chrono>
+#include <climits>
 #include <memory>
 #include "text.h"
+#include "textlayoutcache.h"
 #include "vm/expression.h"
 #include "log.h"
 #include "animation.h"
@@ -35,6 +38,11 @@ using namespace Impacto::Profile::ScriptVars;
 
 static DialogueBox* TextBox;
 
+static uint32_t LastLayoutGeneration = 0;
+
+// Set while benchmarking, so strings are only laid out
+static bool LayoutOnly = false;
+
 enum StringTokenType : uint8_t {
   STT_LineBreak = 0x00,
   STT_CharacterNameStart = 0x01,
@@ -239,6 +247,11 @@ float TypewriterEffect::CalcOpacity(int glyph) {
 
 bool DialoguePage::TextIsFullyOpaque() { return Typewriter.Progress == 1.0f; }
 
+DialoguePage::DialoguePage() {
+  Glyphs.reserve(DialogueGlyphReserve);
+  Name.reserve(DialogueMaxNameLength);
+}
+
 void DialoguePage::Init() {
   Profile::Dialogue::Configure();
 
@@ -264,6 +277,7 @@ void DialoguePage::Init() {
   SkipIconDisplay::Init();
 
   for (int i = 0; i < Profile::Dialogue::PageCount; i++) {
+    DialoguePages[i].Glyphs.reserve(DialogueNVLGlyphReserve);
     DialoguePages[i].Clear();
     DialoguePages[i].Mode = DPM_NVL;
     DialoguePages[i].Id = i;
@@ -273,12 +287,21 @@ void DialoguePage::Init() {
   }
 }
 
+void DialoguePage::InvalidateLayout() {
+  // Generations are unique across pages, so a cache can never mistake another
+  // page's (or a copied page's) layout for its own. 0 means "don't cache".
+  if (++LastLayoutGeneration == 0) ++LastLayoutGeneration;
+  LayoutGeneration = LastLayoutGeneration;
+}
+
 void DialoguePage::Clear() {
+  InvalidateLayout();
   Glyphs.clear();
   NameLength = 0;
   Name.clear();
   HasName = false;
-  memset(RubyChunks, 0, sizeof(RubyChunk) * DialogueMaxRubyChunks);
+  memset(RubyChunks, 0,
+         sizeof(RubyChunk) * std::min(RubyChunkCount, DialogueMaxRubyChunks));
   RubyChunkCount = 0;
   CurrentRubyChunk = 0;
   FirstRubyChunkOnLine = 0;
@@ -293,6 +316,7 @@ void DialoguePage::Clear() {
   }
   CurrentLineTopMargin = 0.0f;
   NVLResetBeforeAdd = false;
+  GlyphBounds = RectF();
 }
 
 enum TextParseState { TPS_Normal, TPS_Name, TPS_Ruby };
@@ -455,6 +479,8 @@ void DialoguePage::AddString(Vm::Sc3VmThread* ctx, Audio::AudioStream* voice,
   }
 
   float CurrentX = 0.0f;
+  // Advance widths are in bitmap em units, scaled to FontSize
+  float advanceScale = FontSize / DialogueFont->BitmapEmWidth;
 
   uint16_t name[DialogueMaxNameLength];
 
@@ -531,6 +557,7 @@ void DialoguePage::AddString(Vm::Sc3VmThread* ctx, Audio::AudioStream* voice,
       }
       case STT_SetFontSize: {
         FontSize = DefaultFontSize * (token.Val_Uint16 / SetFontSizeRatio);
+        advanceScale = FontSize / DialogueFont->BitmapEmWidth;
         break;
       }
       case STT_RubyBaseStart: {
@@ -553,7 +580,8 @@ void DialoguePage::AddString(Vm::Sc3VmThread* ctx, Audio::AudioStream* voice,
         break;
       }
       case STT_UnlockTip: {
-        if ((Mode == DPM_ADV ||
+        if (!LayoutOnly &&
+            (Mode == DPM_ADV ||
              (DialogueBoxCurrentType == +DialogueBoxType::CHLCC &&
               Mode == DPM_REV) ||
              Mode == DPM_NVL) &&
@@ -589,8 +617,8 @@ void DialoguePage::AddString(Vm::Sc3VmThread* ctx, Audio::AudioStream* voice,
           }
 
           ptg.DestRect.X = BoxBounds.X + CurrentX;
-          ptg.DestRect.Width = (FontSize / DialogueFont->BitmapEmWidth) *
-                               DialogueFont->AdvanceWidths[ptg.CharId];
+          ptg.DestRect.Width =
+              advanceScale * DialogueFont->AdvanceWidths[ptg.CharId];
           ptg.DestRect.Height = FontSize;
 
           CurrentX += ptg.DestRect.Width;
@@ -637,11 +665,13 @@ void DialoguePage::AddString(Vm::Sc3VmThread* ctx, Audio::AudioStream* voice,
   FinishLine(ctx, (int)Glyphs.size(), BoxBounds, Alignment);
   CurrentX = 0.0f;
 
-  RectF boundingBox = Glyphs.empty() ? RectF() : Glyphs.begin()->DestRect;
-  for (const ProcessedTextGlyph& glyph : Glyphs) {
-    boundingBox = RectF::Coalesce(boundingBox, glyph.DestRect);
+  // Earlier lines are final, only this string's glyphs can grow the bounds
+  for (size_t i = typewriterStart; i < Glyphs.size(); i++) {
+    GlyphBounds = i == 0 ? Glyphs[i].DestRect
+                         : RectF::Coalesce(GlyphBounds, Glyphs[i].DestRect);
   }
-  Dimensions = glm::vec2(boundingBox.Width, boundingBox.Height);
+  Dimensions = glm::vec2(GlyphBounds.Width, GlyphBounds.Height);
+  InvalidateLayout();
 
   // Even if there is a name in the string it should not be
   // rendered when in NVL mode
@@ -679,8 +709,10 @@ void DialoguePage::AddString(Vm::Sc3VmThread* ctx, Audio::AudioStream* voice,
       }
     }
     Vm::Sc3Stream nameStream(name);
-    Name = TextLayoutPlainLine(nameStream, NameLength, DialogueFont, fontSize,
-                               ColorTable[colorIndex], 1.0f, pos, alignment);
+    Name.resize(NameLength);
+    Name.resize(TextLayoutPlainLine(nameStream, NameLength, Name, DialogueFont,
+                                    fontSize, ColorTable[colorIndex], 1.0f,
+                                    pos, alignment));
     assert(NameLength == Name.size());
   }
 
@@ -743,11 +775,13 @@ void DialoguePage::Render() {
   glm::vec4 col = glm::vec4(1.0f);  // ScrWorkGetColor(SW_MESWINDOW_COLOR);
   col.a = opacityTint.a;
 
-  Renderer->DrawProcessedText(Glyphs, DialogueFont, opacityTint.a,
+  Renderer->DrawProcessedText(GlyphQuads, LayoutGeneration, Glyphs,
+                              DialogueFont, opacityTint.a,
                               RendererOutlineMode::Full);
 
   if (HasName && ADVBoxShowName) {
-    Renderer->DrawProcessedText(Name, DialogueFont, opacityTint.a,
+    Renderer->DrawProcessedText(NameQuads, LayoutGeneration, Name,
+                                DialogueFont, opacityTint.a,
                                 RendererOutlineMode::Full);
   }
 
@@ -772,6 +806,12 @@ void DialoguePage::Move(glm::vec2 relativePos) {
       Name[i].DestRect.Y += relativePos.y;
     }
   }
+
+  // Moving doesn't change the layout, just shift what's already baked
+  if (GlyphQuads.Generation == LayoutGeneration)
+    GlyphQuads.Translate(relativePos);
+  if (HasName && NameQuads.Generation == LayoutGeneration)
+    NameQuads.Translate(relativePos);
 }
 
 void DialoguePage::MoveTo(glm::vec2 pos) {
@@ -893,16 +933,63 @@ std::vector<ProcessedTextGlyph> TextLayoutPlainLine(
   return outGlyphs;
 }
 
+// Lays out the line at the thread's position through the layout cache,
+// advancing the thread past it like reading it would
+static const TextLayoutCache::Entry& LayoutCachedLine(Vm::Sc3VmThread* thd,
+                                                      int maxLength,
+                                                      Font* font,
+                                                      float fontSize) {
+  const TextLayoutCache::Key key{
+      .ScriptBufferId = thd->ScriptBufferId,
+      .ScriptGeneration = Vm::ScriptBufferGenerations[thd->ScriptBufferId],
+      .Offset = thd->IpOffset,
+      .MaxLength = maxLength,
+      .LayoutFont = font,
+      .FontSize = fontSize};
+
+  const TextLayoutCache::Entry* entry = TextLayoutCache::Find(key);
+  if (!entry) {
+    TextLayoutCache::Entry layout;
+    const uint32_t start = thd->IpOffset;
+    layout.Width =
+        TextLayoutPlainLineHelper(thd, maxLength,
+                                  std::back_inserter(layout.Glyphs), font,
+                                  fontSize, DialogueColorPair{}, 1.0f,
+                                  glm::vec2(0.0f), TextAlignment::Left, 0.0f)
+            .second;
+    layout.BytesRead = thd->IpOffset - start;
+    thd->IpOffset = start;
+    entry = &TextLayoutCache::Insert(key, std::move(layout));
+  }
+
+  thd->IpOffset += entry->BytesRead;
+  return *entry;
+}
+
+static int CopyCachedLine(const TextLayoutCache::Entry& layout,
+                          std::span<ProcessedTextGlyph> outGlyphs,
+                          DialogueColorPair colors, float opacity, float y) {
+  assert(outGlyphs.size() >= layout.Glyphs.size());
+  for (size_t i = 0; i < layout.Glyphs.size(); i++) {
+    ProcessedTextGlyph& ptg = outGlyphs[i];
+    ptg = layout.Glyphs[i];
+    ptg.Colors = colors;
+    ptg.Opacity = opacity;
+    ptg.DestRect.Y = y;
+  }
+  return (int)layout.Glyphs.size();
+}
+
 int TextLayoutPlainLine(Vm::Sc3VmThread* thd, int stringLength,
                         std::span<ProcessedTextGlyph> outGlyphs, Font* font,
                         float fontSize, DialogueColorPair colors, float opacity,
                         glm::vec2 pos, TextAlignment alignment,
                         float blockWidth) {
-  auto [count, currentX] = TextLayoutPlainLineHelper(
-      thd, stringLength, outGlyphs.begin(), font, fontSize, colors, opacity,
-      pos, alignment, blockWidth);
-  assert(outGlyphs.size() >= count);
-  TextLayoutAlignment(alignment, blockWidth, currentX, pos, count, outGlyphs);
+  const TextLayoutCache::Entry& layout =
+      LayoutCachedLine(thd, stringLength, font, fontSize);
+  const int count = CopyCachedLine(layout, outGlyphs, colors, opacity, pos.y);
+  TextLayoutAlignment(alignment, blockWidth, layout.Width, pos, count,
+                      outGlyphs);
   return count;
 }
 
@@ -910,12 +997,12 @@ std::vector<ProcessedTextGlyph> TextLayoutPlainLine(
     Vm::Sc3VmThread* thd, int maxLength, Font* font, float fontSize,
     DialogueColorPair colors, float opacity, glm::vec2 pos,
     TextAlignment alignment, float blockWidth) {
-  std::vector<ProcessedTextGlyph> outGlyphs;
-  outGlyphs.reserve(maxLength);
-  auto [count, currentX] = TextLayoutPlainLineHelper(
-      thd, maxLength, std::back_inserter(outGlyphs), font, fontSize, colors,
-      opacity, pos, alignment, blockWidth);
-  TextLayoutAlignment(alignment, blockWidth, currentX, pos, count, outGlyphs);
+  const TextLayoutCache::Entry& layout =
+      LayoutCachedLine(thd, maxLength, font, fontSize);
+  std::vector<ProcessedTextGlyph> outGlyphs(layout.Glyphs.size());
+  const int count = CopyCachedLine(layout, outGlyphs, colors, opacity, pos.y);
+  TextLayoutAlignment(alignment, blockWidth, layout.Width, pos, count,
+                      outGlyphs);
   return outGlyphs;
 }
 
@@ -974,19 +1061,7 @@ int TextLayoutAlignment(Impacto::TextAlignment& alignment, float blockWidth,
 }
 
 float TextGetPlainLineWidth(Vm::Sc3VmThread* ctx, Font* font, float fontSize) {
-  StringToken token;
-
-  float width = 0.0f;
-  while (true) {
-    token.Read(ctx);
-    if (token.Type == STT_EndOfString) break;
-    if (token.Type != STT_Character) continue;
-
-    width += std::floor((fontSize / font->BitmapEmWidth) *
-                        font->AdvanceWidths[token.Val_Uint16]);
-  }
-
-  return width;
+  return LayoutCachedLine(ctx, INT_MAX, font, fontSize).Width;
 }
 
 float TextGetPlainLineWidth(Vm::Sc3Stream& stream, Font* font, float fontSize) {
@@ -1082,4 +1157,60 @@ uint32_t GetNameId(uint8_t* name, int nameLength) {
   else
     return 0;
 }
-}  // namespace Impacto
\ No newline at end of file
+
+TextLayoutBenchmarkResult TextBenchmarkLayout(DialoguePageMode mode) {
+  static DialoguePage* page = [] {
+    DialoguePage* page = new DialoguePage();
+    page->Glyphs.reserve(DialogueNVLGlyphReserve);
+    return page;
+  }();
+  page->Mode = mode;
+  page->Clear();
+
+  TextLayoutBenchmarkResult result;
+  LayoutOnly = true;
+  const auto startTime = std::chrono::steady_clock::now();
+
+  for (uint32_t bufferId = 0; bufferId < Vm::MaxLoadedScripts; bufferId++) {
+    const std::span<uint8_t> script = Vm::ScriptBuffers[bufferId];
+    if (script.size() < 16) continue;
+
+    // Strings follow right after the string table
+    const uint32_t stringTable =
+        SDL_SwapLE32(UnalignedRead<uint32_t>(&script[4]));
+    if ((size_t)stringTable + 4 > script.size()) continue;
+    const uint32_t firstString = Vm::ScriptGetStrAddress(bufferId, 0);
+    if (firstString <= stringTable || firstString >= script.size()) continue;
+    const uint32_t stringCount = (firstString - stringTable) / 4;
+
+    for (uint32_t i = 0; i < stringCount; i++) {
+      if ((size_t)stringTable + (size_t)(i + 1) * 4 > script.size()) break;
+      const uint32_t address = Vm::ScriptGetStrAddress(bufferId, i);
+      if (address >= script.size()) continue;
+
+      if (mode == DPM_NVL &&
+          page->Glyphs.size() > DialogueNVLGlyphReserve / 2) {
+        page->NVLResetBeforeAdd = true;
+      }
+      const size_t glyphsBefore =
+          mode == DPM_NVL && !page->NVLResetBeforeAdd ? page->Glyphs.size()
+                                                      : 0;
+
+      Vm::Sc3VmThread dummy;
+      dummy.ScriptBufferId = bufferId;
+      dummy.IpOffset = address;
+      page->AddString(&dummy);
+
+      result.Lines++;
+      result.Glyphs += page->Glyphs.size() - glyphsBefore;
+    }
+  }
+
+  result.Seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - startTime)
+                       .count();
+  LayoutOnly = false;
+  return result;
+}
+
+}  // namespace Impacto
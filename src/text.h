@@ -11,6 +11,7 @@
 #include "audio/audiosystem.h"
 #include "audio/audiostream.h"
 #include "audio/audiochannel.h"
+#include "renderer/glyphcache.h"
 
 namespace Impacto {
 
@@ -49,6 +50,10 @@ enum DialoguePageMode : uint8_t {
 int constexpr DialogueMaxNameLength = 64;
 int constexpr DialogueMaxRubyChunks = 32;
 int constexpr DialogueMaxRubyChunkLength = 32;
+// Glyphs reserved up front, so laying out text doesn't allocate. NVL pages
+// keep appending until cleared, and get more.
+int constexpr DialogueGlyphReserve = 512;
+int constexpr DialogueNVLGlyphReserve = 4096;
 
 struct RubyChunk {
   int FirstBaseCharacter;
@@ -75,6 +80,8 @@ struct TypewriterEffect : public Animation {
 };
 
 struct DialoguePage {
+  DialoguePage();
+
   static void Init();
 
   int Id;
@@ -94,7 +101,8 @@ struct DialoguePage {
   bool HasName;
   std::vector<ProcessedTextGlyph> Name;
 
-  int RubyChunkCount;
+  // Only chunks up to RubyChunkCount are reset on Clear
+  int RubyChunkCount = DialogueMaxRubyChunks;
   int CurrentRubyChunk;
   RubyChunk RubyChunks[DialogueMaxRubyChunks];
 
@@ -110,6 +118,11 @@ struct DialoguePage {
 
   RectF BoxBounds;
 
+  // Bumped whenever glyphs are laid out anew, keys the glyph quad caches
+  uint32_t LayoutGeneration = 0;
+  GlyphQuadCache GlyphQuads;
+  GlyphQuadCache NameQuads;
+
   void Clear();
   void AddString(Vm::Sc3VmThread* ctx, Audio::AudioStream* voice = 0,
                  int animId = 0);
@@ -122,6 +135,7 @@ struct DialoguePage {
   void FinishLine(Vm::Sc3VmThread* ctx, int nextLineStart,
                   const RectF& boxBounds, TextAlignment alignment);
   void EndRubyBase(int lastBaseCharacter);
+  void InvalidateLayout();
 
   bool BuildingRubyBase;
   size_t FirstRubyChunkOnLine;
@@ -130,6 +144,8 @@ struct DialoguePage {
   float CurrentLineTopMargin;
   size_t LastLineStart;
   DialoguePageMode PrevMode = DPM_ADV;
+  // Bounds of all glyphs so far, appended strings only add their own glyphs
+  RectF GlyphBounds;
 };
 
 inline DialoguePage* DialoguePages;
@@ -173,6 +189,17 @@ std::vector<ProcessedTextGlyph> TextLayoutPlainString(
 
 void TextGetSc3String(std::string_view str, std::span<uint16_t> out);
 
+struct TextLayoutBenchmarkResult {
+  int Lines = 0;
+  int64_t Glyphs = 0;
+  double Seconds = 0.0;
+};
+
+// Lays out every string of every loaded script into a scratch page of the
+// given mode (NVL pages are appended to until their reserve is half full),
+// without any of the side effects of showing the text
+TextLayoutBenchmarkResult TextBenchmarkLayout(DialoguePageMode mode);
+
 inline ankerl::unordered_dense::map<uint32_t, uint32_t> NamePlateData;
 void InitNamePlateData(Vm::Sc3Stream& stream);
 uint32_t GetNameId(uint8_t* name, int nameLength);
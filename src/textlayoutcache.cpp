@@ -0,0 +1,64 @@
+#include "textlayoutcache.h"
+
+#include <bit>
+#include <string_view>
+
+namespace Impacto {
+namespace TextLayoutCache {
+
+struct KeyHash {
+  using is_avalanching = void;
+
+  uint64_t operator()(const Key& key) const noexcept {
+    const uint64_t parts[] = {
+        (uint64_t)key.ScriptBufferId << 32 | key.Offset,
+        (uint64_t)key.ScriptGeneration << 32 | (uint32_t)key.MaxLength,
+        (uint64_t)(uintptr_t)key.LayoutFont,
+        std::bit_cast<uint32_t>(key.FontSize)};
+    return ankerl::unordered_dense::hash<std::string_view>{}(
+        std::string_view((const char*)parts, sizeof(parts)));
+  }
+};
+
+static ankerl::unordered_dense::map<Key, Entry, KeyHash> Entries;
+static size_t CachedGlyphs = 0;
+static uint64_t Hits = 0;
+static uint64_t Misses = 0;
+static uint64_t Flushes = 0;
+
+const Entry* Find(const Key& key) {
+  auto it = Entries.find(key);
+  if (it == Entries.end()) {
+    Misses++;
+    return nullptr;
+  }
+  Hits++;
+  return &it->second;
+}
+
+const Entry& Insert(const Key& key, Entry&& entry) {
+  if (Entries.size() >= MaxEntries) {
+    Entries.clear();
+    CachedGlyphs = 0;
+    Flushes++;
+  }
+
+  CachedGlyphs += entry.Glyphs.size();
+  return Entries.insert_or_assign(key, std::move(entry)).first->second;
+}
+
+void Clear() {
+  Entries.clear();
+  CachedGlyphs = 0;
+}
+
+CacheStats GetStats() {
+  return CacheStats{.Entries = Entries.size(),
+                    .Glyphs = CachedGlyphs,
+                    .Hits = Hits,
+                    .Misses = Misses,
+                    .Flushes = Flushes};
+}
+
+}  // namespace TextLayoutCache
+}  // namespace Impacto
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "text.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Impacto {
+namespace TextLayoutCache {
+
+// Plain lines of script text, laid out before alignment and coloring, so
+// every menu laying out the same string with the same font and size shares
+// one layout no matter where it's placed. Script buffers get a new generation
+// whenever a script is loaded into them, so stale offsets never match.
+struct Key {
+  uint32_t ScriptBufferId;
+  uint32_t ScriptGeneration;
+  uint32_t Offset;
+  int MaxLength;
+  const Font* LayoutFont;
+  float FontSize;
+
+  bool operator==(const Key& other) const = default;
+};
+
+struct Entry {
+  // Left aligned at x = 0, y = 0
+  std::vector<ProcessedTextGlyph> Glyphs;
+  float Width = 0.0f;
+  // How far reading the string advances the thread
+  uint32_t BytesRead = 0;
+};
+
+// Past this many entries the cache starts over
+int constexpr MaxEntries = 4096;
+
+// nullptr if the line isn't cached
+const Entry* Find(const Key& key);
+// The returned entry stays valid until the next Insert or Clear
+const Entry& Insert(const Key& key, Entry&& entry);
+// Drops every entry, for when fonts or the charset change
+void Clear();
+
+struct CacheStats {
+  size_t Entries = 0;
+  size_t Glyphs = 0;
+  uint64_t Hits = 0;
+  uint64_t Misses = 0;
+  uint64_t Flushes = 0;
+};
+CacheStats GetStats();
+
+}  // namespace TextLayoutCache
+}  // namespace Impacto
@@ -18,6 +18,8 @@
 #include "../inputsystem.h"
 #include "../io/vfs.h"
 
+#include <algorithm>
+
 namespace Impacto {
 namespace UI {
 
@@ -89,6 +91,7 @@ void BacklogMenu::Show() {
       MainScrollbar->Update(0);
       MainItems->MoveTo(glm::vec2(EntriesStart.x, PageY));
     }
+    UpdateVisibleEntries();
   }
 }
 void BacklogMenu::Hide() {
@@ -210,9 +213,68 @@ void BacklogMenu::UpdateInput(float dt) {
   UpdateScrollingInput(dt);
 }
 
+// Expects the entry and the rest of the window to be marked with the current
+// EntryUseCounter
+void BacklogMenu::LoadEntry(Widgets::BacklogEntry* entry) {
+  if (entry->IsLoaded()) return;
+
+  DialoguePage* page = nullptr;
+  if (!FreePages.empty()) {
+    page = FreePages.back();
+    FreePages.pop_back();
+  } else if (Pages.size() >= MaxLoadedEntries) {
+    auto leastRecentlyUsed = std::min_element(
+        LoadedEntries.begin(), LoadedEntries.end(),
+        [](const BacklogEntry* a, const BacklogEntry* b) {
+          return a->LastUsed < b->LastUsed;
+        });
+    if (leastRecentlyUsed != LoadedEntries.end() &&
+        (*leastRecentlyUsed)->LastUsed != EntryUseCounter) {
+      page = (*leastRecentlyUsed)->Unload();
+      *leastRecentlyUsed = LoadedEntries.back();
+      LoadedEntries.pop_back();
+    }
+  }
+  if (!page) page = Pages.emplace_back(std::make_unique<DialoguePage>()).get();
+
+  entry->Load(page);
+  LoadedEntries.push_back(entry);
+}
+
+void BacklogMenu::UpdateVisibleEntries() {
+  // Entries are stacked top to bottom in the order they were added, keep the
+  // ones within a page of the viewport
+  const RectF& viewport = MainItems->RenderingBounds;
+  const float top = viewport.Y - viewport.Height;
+  const float bottom = viewport.Y + 2.0f * viewport.Height;
+
+  const std::vector<Widget*>& entries = MainItems->Children;
+  const auto first = std::partition_point(
+      entries.begin(), entries.end(), [top](const Widget* el) {
+        return el->Bounds.Y + el->Bounds.Height < top;
+      });
+  const auto end =
+      std::partition_point(first, entries.end(), [bottom](const Widget* el) {
+        return el->Bounds.Y <= bottom;
+      });
+  MainItems->FirstActiveChild = first - entries.begin();
+  MainItems->ActiveChildEnd = end - entries.begin();
+
+  // Mark the whole window before loading any of it, so making room for one
+  // of its entries never unloads another
+  EntryUseCounter++;
+  for (auto it = first; it != end; it++) {
+    static_cast<BacklogEntry*>(*it)->LastUsed = EntryUseCounter;
+  }
+  for (auto it = first; it != end; it++) {
+    LoadEntry(static_cast<BacklogEntry*>(*it));
+  }
+}
+
 void BacklogMenu::Update(float dt) {
   if (State != Hidden && State != Shown) FadeAnimation.Update(dt);
   UpdateVisibility();
+  if (State != Hidden) UpdateVisibleEntries();
 
   if (State == Shown && IsFocused) {
     UpdateInput(dt);
@@ -226,7 +288,10 @@ void BacklogMenu::Update(float dt) {
     }
 
     if (MainScrollbar->Enabled) {
-      MainItems->MoveTo(glm::vec2(EntriesStart.x, PageY));
+      if (MainItems->Bounds.Y != PageY) {
+        MainItems->MoveTo(glm::vec2(EntriesStart.x, PageY));
+        UpdateVisibleEntries();
+      }
       auto lastEntry = MainItems->Children.back();
       CurrentEntryPos.y =
           lastEntry->Bounds.Y + lastEntry->Bounds.Height + EntryYPadding;
@@ -314,6 +379,9 @@ void BacklogMenu::AddMessage(Vm::BufferOffsetContext scrCtx, int audioId,
 
 void BacklogMenu::Clear() {
   MainItems->Clear();
+  LoadedEntries.clear();
+  FreePages.clear();
+  for (const auto& page : Pages) FreePages.push_back(page.get());
   MainItems->MoveTo(EntriesStart);
   PageY = 0.0f;
   CurrentId = 0;
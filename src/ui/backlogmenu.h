@@ -6,6 +6,9 @@
 #include "widgets/backlogentry.h"
 #include "widgets/scrollbar.h"
 
+#include <memory>
+#include <vector>
+
 namespace Impacto {
 namespace UI {
 
@@ -43,6 +46,18 @@ class BacklogMenu : public Menu {
   Animation FadeAnimation;
   Widgets::Scrollbar* MainScrollbar;
 
+  // Pages are only laid out for entries near the viewport, reusing the least
+  // recently shown entries' pages past MaxLoadedEntries. Entries within the
+  // window keep theirs, the pool grows instead when the window holds more.
+  static size_t constexpr MaxLoadedEntries = 64;
+  std::vector<std::unique_ptr<DialoguePage>> Pages;
+  std::vector<DialoguePage*> FreePages;
+  std::vector<Widgets::BacklogEntry*> LoadedEntries;
+  uint64_t EntryUseCounter = 0;
+
+  void UpdateVisibleEntries();
+  void LoadEntry(Widgets::BacklogEntry* entry);
+
   TurboOnHoldHandler DirectionButtonHeldHandler;
   TurboOnHoldHandler PageUpDownButtonHeldHandler;
 
@@ -0,0 +1,41 @@
+#include "cachedlayer.h"
+
+#include "../renderer/renderer.h"
+
+namespace Impacto {
+namespace UI {
+
+CachedLayer::~CachedLayer() {
+  if (Id != 0 && Renderer) Renderer->FreeCachedLayer(Id);
+}
+
+void CachedLayer::Render(const std::function<void()>& render, float opacity) {
+  if (Id == 0 && !Unsupported) {
+    Id = Renderer->CreateCachedLayer();
+    Unsupported = Id == 0;
+  }
+
+  if (Unsupported) {
+    render();
+    return;
+  }
+
+  if (Dirty || !Renderer->CachedLayerIsValid(Id)) {
+    Renderer->BeginCachedLayer(Id);
+    render();
+    Renderer->EndCachedLayer();
+    Dirty = false;
+  }
+
+  Renderer->DrawCachedLayer(Id, opacity);
+}
+
+void CachedLayer::Render(Widget& widget, float opacity) {
+  if (widget.IsDirty()) Invalidate();
+
+  Render([&widget]() { widget.Render(); }, opacity);
+  widget.MarkClean();
+}
+
+}  // namespace UI
+}  // namespace Impacto
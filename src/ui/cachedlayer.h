@@ -0,0 +1,34 @@
+#pragma once
+
+#include <functional>
+
+#include "widget.h"
+
+namespace Impacto {
+namespace UI {
+
+// Retains what a static part of the UI rendered in an offscreen layer, and
+// composites that as a single quad until it's invalidated. Falls back to
+// drawing directly on renderers without cached layer support.
+class CachedLayer {
+ public:
+  CachedLayer() = default;
+  CachedLayer(const CachedLayer&) = delete;
+  CachedLayer& operator=(const CachedLayer&) = delete;
+  ~CachedLayer();
+
+  void Invalidate() { Dirty = true; }
+
+  // render is only called if the layer is invalid
+  void Render(const std::function<void()>& render, float opacity = 1.0f);
+  // Rerenders when the widget reports itself dirty
+  void Render(Widget& widget, float opacity = 1.0f);
+
+ private:
+  uint32_t Id = 0;
+  bool Unsupported = false;
+  bool Dirty = true;
+};
+
+}  // namespace UI
+}  // namespace Impacto
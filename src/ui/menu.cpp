@@ -32,6 +32,13 @@ void Menu::Hide() {
   }
 }
 
+void Menu::RecordRenderTime(uint64_t ticks) {
+  const float renderTime =
+      (float)ticks * 1000.0f / (float)SDL_GetPerformanceFrequency();
+  RenderTime = glm::mix(RenderTime, renderTime, 0.1f);
+  PeakRenderTime = std::max(PeakRenderTime, renderTime);
+}
+
 void Menu::UpdateInput() {
   if (IsFocused) {
     if (PADinputButtonWentDown & PAD1DOWN) {
@@ -32,6 +32,12 @@ class Menu {
 
   uint8_t DrawType = Game::DrawComponentType::Main;
 
+  // CPU time spent in Render() in milliseconds, smoothed over recent frames,
+  // and the worst frame seen while shown
+  float RenderTime = 0.0f;
+  float PeakRenderTime = 0.0f;
+  void RecordRenderTime(uint64_t ticks);
+
  protected:
   void AdvanceFocus(FocusDirection dir);
 };
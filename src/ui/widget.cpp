@@ -58,5 +58,14 @@ void Widget::SetFocus(Widget* widget, FocusDirection dir) {
   FocusElements[dir] = widget;
 }
 
+bool Widget::IsDirty() const {
+  return Dirty || GetRenderState() != CleanState;
+}
+
+void Widget::MarkClean() {
+  Dirty = false;
+  CleanState = GetRenderState();
+}
+
 }  // namespace UI
 }  // namespace Impacto
\ No newline at end of file
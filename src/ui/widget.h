@@ -23,6 +23,10 @@ class Widget {
   virtual ~Widget() = default;
 
   virtual void Update(float dt);
+  // Whether Update() has anything to do, groups skip the children for which it
+  // doesn't. Widgets whose Update() does more than play MoveAnimation must
+  // return true while that is needed.
+  virtual bool NeedsUpdate() const { return true; }
   virtual void UpdateInput() = 0;
   virtual void Render() = 0;
 
@@ -40,6 +44,16 @@ class Widget {
   virtual Widget* GetFocus(FocusDirection dir);
   virtual void SetFocus(Widget* widget, FocusDirection dir);
 
+  // Marks the widget as looking different from when it was last drawn into a
+  // cached layer (see UI::CachedLayer), so the layer gets rerendered
+  void Invalidate() { Dirty = true; }
+  // Whether the widget may look different since the last MarkClean(). Changes
+  // to focus, hover, enabled state, tint and bounds are picked up on their
+  // own; anything else (text, sprites, internal animations) has to call
+  // Invalidate() or override this.
+  virtual bool IsDirty() const;
+  virtual void MarkClean();
+
   RectF Bounds = RectF(0.0f, 0.0f, 0.0f, 0.0f);
 
   glm::vec2 MoveTarget;
@@ -48,6 +62,22 @@ class Widget {
 
  private:
   Widget* FocusElements[4] = {0, 0, 0, 0};
+
+  struct RenderState {
+    bool Enabled;
+    bool HasFocus;
+    bool Hovered;
+    glm::vec4 Tint;
+    RectF Bounds;
+
+    bool operator==(const RenderState& other) const = default;
+  };
+  RenderState GetRenderState() const {
+    return {Enabled, HasFocus, Hovered, Tint, Bounds};
+  }
+
+  bool Dirty = true;
+  RenderState CleanState{};
 };
 
 }  // namespace UI
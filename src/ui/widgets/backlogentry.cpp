@@ -8,6 +8,8 @@
 #include "../../profile/dialogue.h"
 #include "../../profile/ui/backlogmenu.h"
 
+#include <utility>
+
 namespace Impacto {
 namespace UI {
 namespace Widgets {
@@ -20,53 +22,82 @@ BacklogEntry::BacklogEntry(int id, Vm::BufferOffsetContext scrCtx, int audioId,
     : Id(id),
       AudioId(audioId),
       CharacterId(characterId),
+      ScriptBufferId(scrCtx.ScriptBufferId),
+      LayoutPosition(pos),
       Position(pos),
       HoverBounds(hoverBounds) {
   Enabled = true;
 
-  BacklogPage = new DialoguePage();
-  BacklogPage->Glyphs.reserve(512);
-  BacklogPage->Clear();
-  BacklogPage->Mode = DPM_REV;
-
+  // The script may be unloaded long before the entry is shown
   Impacto::Vm::Sc3VmThread dummy;
   dummy.IpOffset = scrCtx.IpOffset;
   dummy.ScriptBufferId = scrCtx.ScriptBufferId;
-  // CHLCC uses DPM_REV for the Erin DialogueBox
-  if (Profile::Dialogue::DialogueBoxCurrentType != +DialogueBoxType::CHLCC) {
-    Profile::Dialogue::REVBounds.X = pos.x;
-    Profile::Dialogue::REVBounds.Y = pos.y;
-  }
-  BacklogPage->AddString(&dummy);
+  const uint8_t* text = dummy.GetIp();
+  Text.assign(text, text + TextGetStringLength(&dummy));
 
-  TextLength = BacklogPage->Length;
+  // Measured once, entries only get a page of their own near the viewport
+  static DialoguePage* measurePage = new DialoguePage();
+  LayOut(measurePage);
 
-  Bounds = !BacklogPage->Glyphs.empty() ? BacklogPage->Glyphs.begin()->DestRect
+  Bounds = !measurePage->Glyphs.empty() ? measurePage->Glyphs.begin()->DestRect
                                         : RectF(pos.x, pos.y, 0, 0);
-  for (const ProcessedTextGlyph& glyph : BacklogPage->Glyphs) {
+  for (const ProcessedTextGlyph& glyph : measurePage->Glyphs) {
     Bounds = RectF::Coalesce(Bounds, glyph.DestRect);
   }
   Position.x = Bounds.X;  // X position should not take name into account
-  for (const ProcessedTextGlyph& glyph : BacklogPage->Name) {
+  for (const ProcessedTextGlyph& glyph : measurePage->Name) {
     Bounds = RectF::Coalesce(Bounds, glyph.DestRect);
   }
   TextHeight = Bounds.Height;
   Position.y = Bounds.Y;  // Y position should
 
-  switch (BacklogPage->Alignment) {
+  switch (measurePage->Alignment) {
     default:
     case TextAlignment::Left:
       break;
     case TextAlignment::Center: {
       const RectF& revBounds = Profile::Dialogue::REVBounds;
-      pos.x = revBounds.X + (revBounds.Width - BacklogPage->Dimensions.x) / 2;
+      pos.x = revBounds.X + (revBounds.Width - measurePage->Dimensions.x) / 2;
       break;
     }
   }
   MoveTo(pos);
 }
 
-BacklogEntry::~BacklogEntry() { delete BacklogPage; }
+void BacklogEntry::LayOut(DialoguePage* page) const {
+  page->Mode = DPM_REV;
+
+  // CHLCC uses DPM_REV for the Erin DialogueBox
+  if (Profile::Dialogue::DialogueBoxCurrentType != +DialogueBoxType::CHLCC) {
+    Profile::Dialogue::REVBounds.X = LayoutPosition.x;
+    Profile::Dialogue::REVBounds.Y = LayoutPosition.y;
+  }
+
+  // Read the copy through the buffer the line came from, whatever that holds
+  // by now
+  Impacto::Vm::Sc3VmThread dummy;
+  dummy.IpOffset = 0;
+  dummy.ScriptBufferId = ScriptBufferId;
+  const std::span<uint8_t> scriptBuffer = Vm::ScriptBuffers[ScriptBufferId];
+  const uint32_t generation = Vm::ScriptBufferGenerations[ScriptBufferId];
+  Vm::ScriptBuffers[ScriptBufferId] =
+      std::span(const_cast<uint8_t*>(Text.data()), Text.size());
+  Vm::ScriptBufferGenerations[ScriptBufferId] =
+      ++Vm::LastScriptBufferGeneration;
+  page->AddString(&dummy);
+  Vm::ScriptBuffers[ScriptBufferId] = scriptBuffer;
+  Vm::ScriptBufferGenerations[ScriptBufferId] = generation;
+}
+
+void BacklogEntry::Load(DialoguePage* page) {
+  LayOut(page);
+  page->Move(LayoutOffset);
+  BacklogPage = page;
+}
+
+DialoguePage* BacklogEntry::Unload() {
+  return std::exchange(BacklogPage, nullptr);
+}
 
 void BacklogEntry::UpdateInput() {
   if (Enabled) {
@@ -97,8 +128,9 @@ void BacklogEntry::UpdateInput() {
 
 void BacklogEntry::Move(glm::vec2 relativePosition) {
   Position += relativePosition;
+  LayoutOffset += relativePosition;
   Widget::Move(relativePosition);
-  BacklogPage->Move(relativePosition);
+  if (BacklogPage) BacklogPage->Move(relativePosition);
 }
 
 void BacklogEntry::MoveTo(glm::vec2 position) {
@@ -115,15 +147,19 @@ void BacklogEntry::Render() {
         Tint);
   }
 
+  if (!BacklogPage) return;
+
   if (BacklogPage->HasName) {
-    Renderer->DrawProcessedText(BacklogPage->Name,
-                                Profile::Dialogue::DialogueFont, Tint.a,
-                                Profile::Dialogue::REVNameOutlineMode);
+    Renderer->DrawProcessedText(
+        BacklogPage->NameQuads, BacklogPage->LayoutGeneration,
+        BacklogPage->Name, Profile::Dialogue::DialogueFont, Tint.a,
+        Profile::Dialogue::REVNameOutlineMode);
   }
 
-  Renderer->DrawProcessedText(BacklogPage->Glyphs,
-                              Profile::Dialogue::DialogueFont, Tint.a,
-                              Profile::Dialogue::REVOutlineMode);
+  Renderer->DrawProcessedText(
+      BacklogPage->GlyphQuads, BacklogPage->LayoutGeneration,
+      BacklogPage->Glyphs, Profile::Dialogue::DialogueFont, Tint.a,
+      Profile::Dialogue::REVOutlineMode);
 }
 
 }  // namespace Widgets
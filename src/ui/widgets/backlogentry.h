@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <vector>
 
 #include "../widget.h"
 #include "../../text.h"
@@ -10,11 +11,13 @@ namespace Impacto {
 namespace UI {
 namespace Widgets {
 
+// Keeps a copy of its line's script text and its measured bounds. The text is
+// only laid out into a page while the backlog menu lends it one (see
+// BacklogMenu::LoadEntry), so a long backlog doesn't hold a page per line.
 class BacklogEntry : public Widget {
  public:
   BacklogEntry(int id, Vm::BufferOffsetContext scrCtx, int audioId,
                int characterId, glm::vec2 pos, const RectF& hoverBounds);
-  ~BacklogEntry();
 
   void UpdateInput() override;
   void Render() override;
@@ -22,22 +25,37 @@ class BacklogEntry : public Widget {
   void Move(glm::vec2 relativePosition) override;
   void MoveTo(glm::vec2 position) override;
 
+  // Lays the text out into page, which is used until Unload
+  void Load(DialoguePage* page);
+  // Returns the page the text was laid out into
+  DialoguePage* Unload();
+  bool IsLoaded() const { return BacklogPage != nullptr; }
+
   int Id;
   int AudioId = -1;
   int CharacterId = 0;
   float TextHeight = 0.0f;
+  // When the entry was last near the viewport, to pick which page to reuse
+  uint64_t LastUsed = 0;
 
   std::function<void(BacklogEntry*)> OnClickHandler;
 
  protected:
-  DialoguePage* BacklogPage;
-  int TextLength = 0;
+  DialoguePage* BacklogPage = nullptr;
 
  private:
+  void LayOut(DialoguePage* page) const;
+
+  uint32_t ScriptBufferId;
+  std::vector<uint8_t> Text;
+  // Where the text is laid out, and how far the entry moved since
+  glm::vec2 LayoutPosition;
+  glm::vec2 LayoutOffset = glm::vec2(0.0f);
+
   glm::vec2 Position;
   const RectF& HoverBounds;
 };
 
 }  // namespace Widgets
 }  // namespace UI
-}  // namespace Impacto
\ No newline at end of file
+}  // namespace Impacto
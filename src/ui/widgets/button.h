@@ -18,6 +18,9 @@ class Button : public Widget {
          Sprite const& highlight, glm::vec2 pos, RectF hoverBounds = RectF{});
 
   virtual void UpdateInput() override;
+  virtual bool NeedsUpdate() const override {
+    return MoveAnimation.State == +AnimationState::Playing;
+  }
   virtual void Render() override;
   virtual void Move(glm::vec2 relativePosition) override;
   virtual void Move(glm::vec2 relativePosition, float duration) override;
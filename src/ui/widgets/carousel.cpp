@@ -87,6 +87,19 @@ void Carousel::OnChange(Widget* current, Widget* next) {
   next->Show();
 }
 
+bool Carousel::IsDirty() const {
+  return Widget::IsDirty() ||
+         std::any_of(Children.begin(), Children.end(),
+                     [](const Widget* el) { return el->IsDirty(); });
+}
+
+void Carousel::MarkClean() {
+  Widget::MarkClean();
+  for (const auto& el : Children) {
+    el->MarkClean();
+  }
+}
+
 }  // namespace Widgets
 }  // namespace UI
 }  // namespace Impacto
\ No newline at end of file
@@ -25,6 +25,9 @@ class Carousel : public Widget {
   void Next();
   void Previous();
 
+  bool IsDirty() const override;
+  void MarkClean() override;
+
  private:
   void OnChange(Widget* current, Widget* next);
 
@@ -26,13 +26,17 @@ void BacklogEntry::Render() {
                                       Tint, false, false);
   }
 
+  if (!BacklogPage) return;
+
   if (BacklogPage->HasName) {
     Renderer->DrawProcessedText(
+        BacklogPage->NameQuads, BacklogPage->LayoutGeneration,
         BacklogPage->Name, Profile::Dialogue::DialogueFont, Tint.a,
         Profile::Dialogue::REVNameOutlineMode, true, &BacklogMaskSheet);
   }
 
   Renderer->DrawProcessedText(
+      BacklogPage->GlyphQuads, BacklogPage->LayoutGeneration,
       BacklogPage->Glyphs, Profile::Dialogue::DialogueFont, Tint.a,
       Profile::Dialogue::REVOutlineMode, true, &BacklogMaskSheet);
 }
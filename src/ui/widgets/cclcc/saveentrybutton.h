@@ -28,6 +28,7 @@ class SaveEntryButton : public Widgets::Button {
   void Move(glm::vec2 pos) override;
   void MoveTo(glm::vec2 pos) override;
   void Update(float dt) override;
+  bool NeedsUpdate() const override { return true; }
 
  private:
   int Index;
@@ -16,6 +16,7 @@ class TipsEntryButton : public Widgets::Button {
   TipsEntryButton(int tipId, int dispId, RectF const& dest,
                   Sprite const& highlight, bool isNew);
   void Update(float dt) override;
+  bool NeedsUpdate() const override { return true; }
   void UpdateInput() override;
   void Render() override;
   void Move(glm::vec2 pos) override;
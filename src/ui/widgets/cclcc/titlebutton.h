@@ -14,6 +14,7 @@ class TitleButton : public Widgets::Button {
               Sprite const& highlight, glm::vec2 pos);
   void Render() override;
   void Update(float dt) override;
+  bool NeedsUpdate() const override { return true; }
   void UpdateInput() override;
   void Hide() override;
   bool IsSubButton = false;
@@ -16,6 +16,7 @@ class MovieMenuEntryButton : public Widgets::Button {
                        glm::vec2 thumbnailPos, glm::vec2 boxPos);
 
   void Update(float dt) override;
+  bool NeedsUpdate() const override { return true; }
   void Render() override;
 
   bool IsLocked = true;
@@ -16,6 +16,9 @@ class ClickArea : public Widget {
             std::function<void(ClickArea*)> onClickHandler);
 
   virtual void UpdateInput() override;
+  virtual bool NeedsUpdate() const override {
+    return MoveAnimation.State == +AnimationState::Playing;
+  }
 
   virtual void Show() override;
   virtual void Hide() override;
@@ -3,6 +3,13 @@
 #include "../../profile/game.h"
 #include "../../inputsystem.h"
 #include "../../renderer/renderer.h"
+#include "../nullmenu.h"
+#include "button.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
 
 namespace Impacto {
 namespace UI {
@@ -23,7 +30,10 @@ Group::Group(Menu* ctx, glm::vec2 pos) : Group(ctx) {
 
 Group::~Group() { Clear(); }
 
-void Group::Add(Widget* widget) { Children.push_back(widget); }
+void Group::Add(Widget* widget) {
+  Children.push_back(widget);
+  InvalidateIndex();
+}
 
 void Group::Add(Widget* widget, FocusDirection dir) {
   const FocusDirection oppositeDir = [dir]() {
@@ -68,21 +78,122 @@ void Group::Add(Widget* widget, FocusDirection dir) {
 
 WidgetType Group::GetType() { return WT_GROUP; }
 
+std::span<Widget* const> Group::ActiveChildren() const {
+  const size_t end = std::min(ActiveChildEnd, Children.size());
+  const size_t first = std::min(FirstActiveChild, end);
+  return std::span<Widget* const>(Children.data() + first, end - first);
+}
+
+void Group::UpdateChildInput(Widget* el) {
+  el->UpdateInput();
+  if (el->Enabled && el->Hovered && el->Bounds.Intersects(HoverBounds) &&
+      (Input::CurrentInputDevice == Input::Device::Mouse ||
+       Input::CurrentInputDevice == Input::Device::Touch)) {
+    if (MenuContext->CurrentlyFocusedElement &&
+        el != MenuContext->CurrentlyFocusedElement)
+      MenuContext->CurrentlyFocusedElement->HasFocus = false;
+    el->HasFocus = true;
+    MenuContext->CurrentlyFocusedElement = el;
+  }
+}
+
 void Group::UpdateInput() {
-  for (const auto& el : Children) {
-    if (el->GetType() == WT_NORMAL) {
-      el->UpdateInput();
-      if (el->Enabled && el->Hovered && el->Bounds.Intersects(HoverBounds) &&
-          (Input::CurrentInputDevice == Input::Device::Mouse ||
-           Input::CurrentInputDevice == Input::Device::Touch)) {
-        if (MenuContext->CurrentlyFocusedElement &&
-            el != MenuContext->CurrentlyFocusedElement)
-          MenuContext->CurrentlyFocusedElement->HasFocus = false;
-        el->HasFocus = true;
-        MenuContext->CurrentlyFocusedElement = el;
-      }
+  if (!UseSpatialIndex) {
+    for (const auto& el : ActiveChildren()) {
+      if (el->GetType() == WT_NORMAL) UpdateChildInput(el);
+    }
+    return;
+  }
+
+  // Only children under the hover area can be hovered, but the focused one
+  // still has to see its button presses wherever it is
+  InputScratch.clear();
+  QueryChildren(HoverBounds, InputScratch);
+  Widget* const focused = MenuContext->CurrentlyFocusedElement;
+  if (focused &&
+      std::find(InputScratch.begin(), InputScratch.end(), focused) ==
+          InputScratch.end()) {
+    const std::span<Widget* const> active = ActiveChildren();
+    if (std::find(active.begin(), active.end(), focused) != active.end()) {
+      InputScratch.push_back(focused);
+    }
+  }
+  for (Widget* el : InputScratch) {
+    if (el->GetType() == WT_NORMAL) UpdateChildInput(el);
+  }
+}
+
+void Group::RebuildIndex() {
+  Index.clear();
+  Index.reserve(Children.size());
+  glm::vec2 min(std::numeric_limits<float>::max());
+  glm::vec2 max(std::numeric_limits<float>::lowest());
+  for (size_t i = 0; i < Children.size(); i++) {
+    const RectF& bounds = Children[i]->Bounds;
+    Index.push_back({bounds, i, 0.0f});
+    min = glm::min(min, bounds.GetPos());
+    max = glm::max(max, glm::vec2(bounds.X + bounds.Width,
+                                  bounds.Y + bounds.Height));
+  }
+
+  IndexVertical = max.y - min.y >= max.x - min.x;
+  const auto start = [this](const RectF& rect) {
+    return IndexVertical ? rect.Y : rect.X;
+  };
+  std::sort(Index.begin(), Index.end(),
+            [&](const IndexEntry& a, const IndexEntry& b) {
+              return start(a.Bounds) < start(b.Bounds);
+            });
+
+  float reach = std::numeric_limits<float>::lowest();
+  for (IndexEntry& entry : Index) {
+    const float extent =
+        IndexVertical ? entry.Bounds.Height : entry.Bounds.Width;
+    reach = std::max(reach, start(entry.Bounds) + extent);
+    entry.Reach = reach;
+  }
+
+  IndexOrigin = Bounds.GetPos();
+  IndexStale = false;
+}
+
+void Group::QueryChildren(RectF const& rect, std::vector<Widget*>& result) {
+  const std::span<Widget* const> active = ActiveChildren();
+  if (!UseSpatialIndex) {
+    for (const auto& el : active) {
+      if (rect.Intersects(el->Bounds)) result.push_back(el);
     }
+    return;
   }
+
+  if (IndexStale || Index.size() != Children.size()) RebuildIndex();
+
+  // The index holds the children where they were at IndexOrigin
+  const RectF query = rect + (IndexOrigin - Bounds.GetPos());
+  const float queryStart = IndexVertical ? query.Y : query.X;
+  const float queryEnd =
+      queryStart + (IndexVertical ? query.Height : query.Width);
+  const size_t firstActive = active.data() - Children.data();
+  const size_t activeEnd = firstActive + active.size();
+
+  // Everything before this entry ends before the query starts
+  auto it = std::partition_point(Index.begin(), Index.end(),
+                                 [queryStart](const IndexEntry& entry) {
+                                   return entry.Reach < queryStart;
+                                 });
+
+  QueryScratch.clear();
+  for (; it != Index.end(); ++it) {
+    if ((IndexVertical ? it->Bounds.Y : it->Bounds.X) > queryEnd) break;
+    if (it->Child >= firstActive && it->Child < activeEnd &&
+        query.Intersects(it->Bounds)) {
+      QueryScratch.push_back(it->Child);
+    }
+  }
+
+  // Children draw over the ones added before them
+  std::sort(QueryScratch.begin(), QueryScratch.end());
+  for (size_t child : QueryScratch) result.push_back(Children[child]);
 }
 
 void Group::Update(float dt) {
@@ -92,13 +203,17 @@ void Group::Update(float dt) {
       UpdateInput();
     }
     bool isFocused = false;
-    for (const auto& el : Children) {
+    for (const auto& el : ActiveChildren()) {
       if (!FocusLock) {
         isFocused = isFocused ||
                     (el == MenuContext->CurrentlyFocusedElement ? true : false);
         HasFocus = isFocused;
       }
+      if (!el->NeedsUpdate()) continue;
+
+      const RectF bounds = el->Bounds;
       el->Update(dt);
+      if (el->Bounds != bounds) InvalidateIndex();
     }
   }
 }
@@ -107,13 +222,13 @@ void Group::Render() {
   if (IsShown) {
     Renderer->EnableScissor();
     Renderer->SetScissorRect(RenderingBounds);
-    for (const auto& el : Children) {
-      if (RenderingBounds.Intersects(el->Bounds)) {
-        auto tint = el->Tint;
-        el->Tint *= Tint;
-        el->Render();
-        el->Tint = tint;
-      }
+    RenderScratch.clear();
+    QueryChildren(RenderingBounds, RenderScratch);
+    for (const auto& el : RenderScratch) {
+      auto tint = el->Tint;
+      el->Tint *= Tint;
+      el->Render();
+      el->Tint = tint;
     }
     Renderer->DisableScissor();
   }
@@ -192,6 +307,10 @@ void Group::Clear() {
     delete el;
   }
   Children.clear();
+  Index.clear();
+  InvalidateIndex();
+  FirstActiveChild = 0;
+  ActiveChildEnd = SIZE_MAX;
   LastFocusableElementId = -1;
   std::fill(std::begin(FocusStart), std::end(FocusStart), nullptr);
 }
@@ -200,6 +319,67 @@ Widget* Group::GetFirstFocusableChild() {
   return Children.at(FirstFocusableElementId);
 }
 
+bool Group::IsDirty() const {
+  if (Widget::IsDirty() || IsShown != CleanIsShown ||
+      RenderingBounds != CleanRenderingBounds)
+    return true;
+  return std::any_of(Children.begin(), Children.end(),
+                     [](const Widget* el) { return el->IsDirty(); });
+}
+
+void Group::MarkClean() {
+  Widget::MarkClean();
+  CleanIsShown = IsShown;
+  CleanRenderingBounds = RenderingBounds;
+  for (const auto& el : Children) {
+    el->MarkClean();
+  }
+}
+
+GroupBenchmarkResult BenchmarkGroup(int widgetCount, bool spatialIndex) {
+  int constexpr columns = 10;
+  int constexpr frames = 600;
+  glm::vec2 constexpr cellSize(160.0f, 90.0f);
+
+  NullMenu menu;
+  Group group(&menu);
+  group.UseSpatialIndex = spatialIndex;
+  for (int i = 0; i < widgetCount; i++) {
+    Button* button = new Button();
+    button->Bounds = RectF((i % columns) * cellSize.x,
+                           (i / columns) * cellSize.y, cellSize.x, cellSize.y);
+    group.Add(button);
+  }
+  group.Show();
+
+  // Scrolls through the whole grid over the run, a row at a time
+  const float rows = (float)((widgetCount + columns - 1) / columns);
+  const float rowsPerFrame = rows / frames;
+
+  GroupBenchmarkResult result;
+  std::vector<Widget*> visible;
+  for (int frame = 0; frame < frames; frame++) {
+    const float row = std::floor(frame * rowsPerFrame);
+    const float y = -row * cellSize.y;
+    if (group.Bounds.Y != y) group.MoveTo(glm::vec2(0.0f, y));
+
+    const auto startTime = std::chrono::steady_clock::now();
+    group.Update(1.0f / 60.0f);
+    visible.clear();
+    group.QueryChildren(group.RenderingBounds, visible);
+    result.Seconds += std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - startTime)
+                          .count();
+
+    result.Frames++;
+    result.VisibleChildren += (int)visible.size();
+  }
+  result.VisibleChildren /= std::max(result.Frames, 1);
+
+  group.Hide();
+  return result;
+}
+
 }  // namespace Widgets
 }  // namespace UI
 }  // namespace Impacto
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "../widget.h"
 #include "../menu.h"
 
+#include <cstdint>
+#include <span>
 #include <vector>
 #include <enum.h>
 
@@ -27,6 +29,22 @@ class Group : public Widget {
   bool FocusLock = true;
   bool WrapFocus = true;
 
+  // Only children in [FirstActiveChild, ActiveChildEnd) are updated, hit-tested
+  // and rendered, for owners that know which of their children are visible
+  size_t FirstActiveChild = 0;
+  size_t ActiveChildEnd = SIZE_MAX;
+  std::span<Widget* const> ActiveChildren() const;
+
+  // Keeps the children sorted along the axis they are spread out on, so
+  // culling and hit-testing only look at the children in view. Meant for large
+  // groups whose children only move along with the group, call
+  // InvalidateIndex() after moving a child on its own.
+  bool UseSpatialIndex = false;
+  void InvalidateIndex() { IndexStale = true; }
+
+  // Appends the active children whose bounds intersect rect, in order
+  void QueryChildren(RectF const& rect, std::vector<Widget*>& result);
+
   void Update(float dt) override;
   void Render() override;
   void UpdateInput() override;
@@ -47,6 +65,9 @@ class Group : public Widget {
 
   Widget* GetFirstFocusableChild();
 
+  bool IsDirty() const override;
+  void MarkClean() override;
+
  protected:
   Menu* MenuContext;
   int FirstFocusableElementId = -1;
@@ -54,8 +75,42 @@ class Group : public Widget {
   Widget* FocusStart[4] = {0, 0, 0, 0};
   Widget* PreviousFocusElement = 0;
   Widget* PreviousFocusStart[4] = {0, 0, 0, 0};
+
+ private:
+  void UpdateChildInput(Widget* el);
+  void RebuildIndex();
+
+  bool CleanIsShown = false;
+  RectF CleanRenderingBounds{};
+
+  struct IndexEntry {
+    RectF Bounds;
+    size_t Child;
+    // Furthest any entry up to this one reaches along the axis
+    float Reach;
+  };
+  // Sorted by where the children start along the axis, as they were placed
+  // when the group was at IndexOrigin
+  std::vector<IndexEntry> Index;
+  glm::vec2 IndexOrigin{};
+  bool IndexVertical = true;
+  bool IndexStale = true;
+
+  std::vector<size_t> QueryScratch;
+  std::vector<Widget*> InputScratch;
+  std::vector<Widget*> RenderScratch;
+};
+
+struct GroupBenchmarkResult {
+  int Frames = 0;
+  int VisibleChildren = 0;
+  double Seconds = 0.0;
 };
 
+// Updates, hit-tests and culls (without drawing) a scrolling grid of idle
+// buttons every frame
+GroupBenchmarkResult BenchmarkGroup(int widgetCount, bool spatialIndex);
+
 }  // namespace Widgets
 }  // namespace UI
 }  // namespace Impacto
\ No newline at end of file
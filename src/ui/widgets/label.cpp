@@ -95,6 +95,7 @@ void Label::MoveTo(glm::vec2 pos) {
 }
 
 void Label::SetSprite(Sprite const& label) {
+  Invalidate();
   IsText = false;
   LabelSprite = label;
   Bounds = RectF(Bounds.X, Bounds.Y, LabelSprite.Bounds.Width,
@@ -103,6 +104,7 @@ void Label::SetSprite(Sprite const& label) {
 
 void Label::SetText(std::vector<ProcessedTextGlyph> str, float textWidth,
                     float fontSize, RendererOutlineMode outlineMode) {
+  Invalidate();
   IsText = true;
   OutlineMode = outlineMode;
   Text = std::move(str);
@@ -111,6 +113,7 @@ void Label::SetText(std::vector<ProcessedTextGlyph> str, float textWidth,
 
 void Label::SetText(std::span<ProcessedTextGlyph> str, float textWidth,
                     float fontSize, RendererOutlineMode outlineMode) {
+  Invalidate();
   IsText = true;
   OutlineMode = outlineMode;
   Text = std::vector<ProcessedTextGlyph>(str.begin(), str.end());
@@ -137,6 +140,7 @@ void Label::SetText(Vm::Sc3Stream& stream, float fontSize,
 void Label::SetText(Vm::Sc3Stream& stream, float fontSize,
                     RendererOutlineMode outlineMode,
                     DialogueColorPair colorPair) {
+  Invalidate();
   IsText = true;
   FontSize = fontSize;
   Text = TextLayoutPlainLine(
@@ -153,6 +157,7 @@ void Label::SetText(Vm::Sc3Stream& stream, float fontSize,
 void Label::SetText(Vm::BufferOffsetContext scrCtx, float fontSize,
                     RendererOutlineMode outlineMode,
                     DialogueColorPair colorPair) {
+  Invalidate();
   IsText = true;
   Impacto::Vm::Sc3VmThread dummy;
   dummy.IpOffset = scrCtx.IpOffset;
@@ -172,6 +177,7 @@ void Label::SetText(Vm::BufferOffsetContext scrCtx, float fontSize,
 void Label::SetText(std::string_view str, float fontSize,
                     RendererOutlineMode outlineMode,
                     DialogueColorPair colorPair) {
+  Invalidate();
   IsText = true;
   Text = TextLayoutPlainString(str, Profile::Dialogue::DialogueFont, fontSize,
                                colorPair, 1.0f, glm::vec2(Bounds.X, Bounds.Y),
@@ -33,6 +33,9 @@ class Label : public Widget {
         RendererOutlineMode outlineMode, DialogueColorPair colorPair);
 
   void Update(float dt) override;
+  bool NeedsUpdate() const override {
+    return MoveAnimation.State == +AnimationState::Playing;
+  }
   void UpdateInput() override;
   void Render() override;
   void Move(glm::vec2 relativePosition) override;
@@ -52,6 +55,7 @@ class Label : public Widget {
   void SetText(std::string_view str, float fontSize,
                RendererOutlineMode outlineMode, DialogueColorPair colorPair);
   void ClearText() {
+    Invalidate();
     Text.clear();
     IsText = false;
     Bounds = {};
@@ -14,6 +14,7 @@ class AlbumCharacterButton : public Widgets::Button {
                        Sprite const& highlight, Sprite const& lockedHighlight,
                        glm::vec2 pos, float highlightAnimationDuration);
   void Update(float dt) override;
+  bool NeedsUpdate() const override { return true; }
   void Render() override;
 
  private:
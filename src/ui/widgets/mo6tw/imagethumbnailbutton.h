@@ -22,6 +22,7 @@ class ImageThumbnailButton : public Widgets::Button {
                        Sprite const& focusedBottomLeft,
                        Sprite const& focusedBottomRight, glm::vec2 pos);
   void Update(float dt) override;
+  bool NeedsUpdate() const override { return true; }
   void Render() override;
 
   bool IsLocked = true;
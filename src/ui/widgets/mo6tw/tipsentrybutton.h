@@ -17,6 +17,7 @@ class TipsEntryButton : public Widgets::Button {
   TipsEntryButton(int id, Impacto::TipsSystem::TipsDataRecord* tipRecord,
                   RectF const& dest, Sprite const& highlight);
   void Update(float dt) override;
+  bool NeedsUpdate() const override { return true; }
   void Render() override;
 
   Impacto::TipsSystem::TipsDataRecord* TipEntryRecord;
@@ -23,6 +23,9 @@ class Toggle : public Widget {
          Sprite const& label, glm::vec2 labelOfs);
 
   void Update(float dt) override;
+  bool NeedsUpdate() const override {
+    return MoveAnimation.State == +AnimationState::Playing;
+  }
   void UpdateInput() override;
   void Render() override;
 
@@ -13,11 +13,13 @@
 
 extern "C" {
 #include <libavutil/avutil.h>
+#include <libavutil/imgutils.h>
 #include <libavutil/time.h>
 }
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <mutex>
 #include <optional>
 #include <system_error>
@@ -31,6 +33,7 @@ extern "C" {
 #ifndef IMPACTO_DISABLE_OPENAL
 #include "../audio/openal/ffmpegaudioplayer.h"
 #endif
+#include "../audio/mixer/ffmpegaudioplayer.h"
 #include "../profile/scriptvars.h"
 
 namespace Impacto {
@@ -40,17 +43,50 @@ using namespace Impacto::Profile::ScriptVars;
 
 int FFmpegFileIO::read(uint8_t* data, size_t size) {
   if (!FileStream) return -1;
+
+  if (MappedData) {
+    const int64_t bytesRead =
+        std::min((int64_t)size, FileStream->Meta.Size - MappedPosition);
+    if (bytesRead <= 0) return AVERROR_EOF;
+    memcpy(data, MappedData + MappedPosition, bytesRead);
+    MappedPosition += bytesRead;
+    DemuxerIoStats.BytesRead += bytesRead;
+    return (int)bytesRead;
+  }
+
   uint64_t bytesRead = FileStream->Read(data, size);
   if ((bytesRead == static_cast<uint64_t>(IoError_Fail) ||
        bytesRead == static_cast<uint64_t>(IoError_Eof)))
     return AVERROR_EOF;
 
+  DemuxerIoStats.BytesRead += bytesRead;
   return (int)bytesRead;
 }
 
 int64_t FFmpegFileIO::seek(int64_t offset, int whence) {
   if (!FileStream) return -1;
   if (whence == AVSEEK_SIZE) return FileStream->Meta.Size;
+
+  if (MappedData) {
+    int64_t newPos;
+    switch (whence & ~AVSEEK_FORCE) {
+      case SEEK_SET:
+        newPos = offset;
+        break;
+      case SEEK_CUR:
+        newPos = MappedPosition + offset;
+        break;
+      case SEEK_END:
+        newPos = FileStream->Meta.Size + offset;
+        break;
+      default:
+        return -1;
+    }
+    if (newPos < 0 || newPos > FileStream->Meta.Size) return -1;
+    MappedPosition = newPos;
+    return newPos;
+  }
+
   int64_t newPos = FileStream->Seek(offset, whence);
   if (newPos == IoError_Fail) return -1;
   return newPos;
@@ -67,6 +103,9 @@ void FFmpegPlayer::Init() {
       AudioPlayer.reset(new Audio::OpenAL::FFmpegAudioPlayer(this));
     } break;
 #endif
+    case AudioBackendType::Mixer: {
+      AudioPlayer.reset(new Audio::Mixer::FFmpegAudioPlayer(this));
+    } break;
     case AudioBackendType::None:
     default: {
       AudioPlayer.reset(new Audio::FFmpegAudioPlayer(this));
@@ -117,8 +156,25 @@ void FFmpegPlayer::OpenCodec(std::optional<FFmpegStream<MediaType>>& streamOpt,
   }
   double duration = avStream.duration().seconds();
   double frameMultiplier = (rate);
+
+  size_t frameQueueCount = FFmpegStream<MediaType>::MaxFrameQueueCount;
+  if constexpr (MediaType == AVMEDIA_TYPE_VIDEO) {
+    // Decoded frames dwarf everything else, so keep as many as fit the budget
+    const int frameBytes = av_image_get_buffer_size(
+        decoderContext.raw()->pix_fmt, decoderContext.width(),
+        decoderContext.height(), 1);
+    if (frameBytes > 0) {
+      frameQueueCount = std::clamp<size_t>(
+          FrameQueueBudget / frameBytes, MinFrameQueueCount,
+          FFmpegStream<MediaType>::MaxFrameQueueCount);
+    }
+    ImpLog(LogLevel::Debug, LogChannel::Video,
+           "Queueing up to {:d} frames of {:d} bytes\n", frameQueueCount,
+           frameBytes);
+  }
+
   streamOpt.emplace(std::move(avStream), std::move(decoderContext),
-                    (int)(frameMultiplier * duration));
+                    (int)(frameMultiplier * duration), frameQueueCount);
 };
 
 template void FFmpegPlayer::OpenCodec(
@@ -128,31 +184,26 @@ template void FFmpegPlayer::OpenCodec(
     std::optional<FFmpegStream<AVMEDIA_TYPE_AUDIO>>& streamOpt,
     av::Stream&& avStream, int streamId);
 
-void FFmpegPlayer::Play(Io::Stream* stream, bool looping, bool alpha) {
-  // Don't do anything if we don't have the video system
-  if (!IsInit) return;
-  if (stream == nullptr) {
-    ImpLog(LogLevel::Error, LogChannel::Video,
-           "Stream was a nullptr! This means the caller is buggy. Backing "
-           "out.\n");
-    return;
-  }
+bool FFmpegPlayer::Open(Io::Stream* stream) {
   StreamPtr.reset(stream);
   AbortRequest = false;
   SeekRequest = false;
-  Looping = looping;
-  IsAlpha = alpha;
   ImpLog(LogLevel::Info, LogChannel::Video, "Opening file: {:s} from: {:s}\n",
          stream->Meta.FileName, stream->Meta.ArchiveFileName);
 
   std::error_code ec;
   IoContext = FFmpegFileIO{stream};
-  FormatContext.openInput(&IoContext, ec, FILESTREAMBUFFERSZ);
+  DemuxerIoStats.DirectFromMemory = IoContext.MappedData != nullptr;
+  ImpLog(LogLevel::Debug, LogChannel::Video, "Reading video {:s}\n",
+         IoContext.MappedData ? "straight from memory" : "through its stream");
+  FormatContext.openInput(&IoContext, ec,
+                          IoContext.MappedData ? MAPPEDSTREAMBUFFERSZ
+                                               : FILESTREAMBUFFERSZ);
   if (ec) {
     ImpLog(LogLevel::Error, LogChannel::Video,
            "Error opening file, error: {:s}\n", ec.message());
     StreamPtr.reset();
-    return;
+    return false;
   }
 
   FormatContext.findStreamInfo(ec);
@@ -160,7 +211,7 @@ void FFmpegPlayer::Play(Io::Stream* stream, bool looping, bool alpha) {
     ImpLog(LogLevel::Error, LogChannel::Video,
            "Error opening file, error: {:s}\n", ec.message());
     StreamPtr.reset();
-    return;
+    return false;
   }
 
   av::Stream videoStream;
@@ -183,15 +234,15 @@ void FFmpegPlayer::Play(Io::Stream* stream, bool looping, bool alpha) {
   if (videoStream.isVideo() && videoStream.isValid()) {
     OpenCodec<AVMEDIA_TYPE_VIDEO>(VideoStream, std::move(videoStream),
                                   videoStreamId);
-    ScrWork[SW_MOVIEFRAME] = 0;
-    ScrWork[SW_MOVIETOTALFRAME] = VideoStream->Duration;
     if (!VideoTexture)
       VideoTexture =
           Renderer->CreateYUVFrame((float)VideoStream->CodecContext.width(),
                                    (float)VideoStream->CodecContext.height());
     else {
-      VideoTexture->Width = (float)VideoStream->CodecContext.width();
-      VideoTexture->Height = (float)VideoStream->CodecContext.height();
+      // Texture storage is sized once, so start over with the new dimensions
+      VideoTexture->Release();
+      VideoTexture->Init((float)VideoStream->CodecContext.width(),
+                         (float)VideoStream->CodecContext.height());
     }
   }
   if (audioStream.isAudio() && audioStream.isValid()) {
@@ -217,6 +268,61 @@ void FFmpegPlayer::Play(Io::Stream* stream, bool looping, bool alpha) {
         std::thread{&FFmpegPlayer::Decode<AVMEDIA_TYPE_AUDIO>, this};
   }
 
+  return true;
+}
+
+void FFmpegPlayer::Prepare(Io::Stream* stream) {
+  if (!IsInit || stream == nullptr) {
+    delete stream;
+    return;
+  }
+  if (IsPlaying) {
+    ImpLog(LogLevel::Debug, LogChannel::Video,
+           "Not preparing {:s} while another video is playing\n",
+           stream->Meta.FileName);
+    delete stream;
+    return;
+  }
+
+  // Drop whatever was prepared before
+  Stop();
+
+  ImpLog(LogLevel::Debug, LogChannel::Video, "Preparing {:s}\n",
+         stream->Meta.FileName);
+  PreparedMeta = stream->Meta;
+  IsPrepared = Open(stream);
+}
+
+void FFmpegPlayer::Play(Io::Stream* stream, bool looping, bool alpha) {
+  // Don't do anything if we don't have the video system
+  if (!IsInit) return;
+  if (stream == nullptr) {
+    ImpLog(LogLevel::Error, LogChannel::Video,
+           "Stream was a nullptr! This means the caller is buggy. Backing "
+           "out.\n");
+    return;
+  }
+  PlayRequestTime = std::chrono::steady_clock::now();
+
+  const bool prepared = IsPrepared && !IsPlaying &&
+                        PreparedMeta.Id == stream->Meta.Id &&
+                        PreparedMeta.FileName == stream->Meta.FileName &&
+                        PreparedMeta.ArchiveFileName ==
+                            stream->Meta.ArchiveFileName;
+  if (prepared) {
+    // Already demuxing and decoding from our own handle to the same file
+    delete stream;
+  } else {
+    Stop();
+    if (!Open(stream)) return;
+  }
+
+  IsPrepared = false;
+  LastVideoStart.Prepared = prepared;
+  Looping = looping;
+  IsAlpha = alpha;
+  ScrWork[SW_MOVIEFRAME] = 0;
+  if (VideoStream) ScrWork[SW_MOVIETOTALFRAME] = VideoStream->Duration;
   IsPlaying = true;
 }
 
@@ -255,12 +361,19 @@ void FFmpegPlayer::Read() {
     if (ReaderEOF) {
       continue;
     }
+    // Wait for the decoders to catch up rather than block on a full queue, so
+    // seek requests are still picked up
+    if (Memory.PacketBytes > PacketQueueBudget) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      continue;
+    }
     std::error_code ec;
     item.Packet = FormatContext.readPacket(ec);
     if (ec) {
       ImpLog(LogLevel::Error, LogChannel::Video, "Uh oh {:s}\n", ec.message());
     }
     if (item.Packet) {
+      item.Memory = QueuedBytes(Memory, Memory.PacketBytes, item.Packet.size());
       if (item.Packet.streamIndex() == VideoStream->stream.index()) {
         item.Serial = VideoStream->PacketQueueSerial;
         while (!VideoStream->PacketQueue.wait_enqueue_timed(std::move(item),
@@ -337,6 +450,13 @@ void FFmpegPlayer::Decode() {
     } else {
       item.Serial = stream->PacketQueueSerial;
       item.Timestamp = item.Frame.pts();
+      // The frame holds references to buffers from the decoder's pool, which
+      // go back to the pool once the frame is dequeued and released
+      int64_t bytes = 0;
+      for (AVBufferRef const* buf : item.Frame.raw()->buf) {
+        if (buf) bytes += buf->size;
+      }
+      item.Memory = QueuedBytes(Memory, Memory.FrameBytes, bytes);
     }
     auto& frameQueue = stream->FrameQueue;
 
@@ -349,6 +469,21 @@ void FFmpegPlayer::Decode() {
     AVPacketItem const* peek = stream->PacketQueue.peek();
     if (peek == nullptr) continue;
 
+    if constexpr (MediaType == AVMEDIA_TYPE_VIDEO) {
+      // Set by the main thread when frames keep showing up late. Lighter
+      // decoding first, then non-reference frames aren't decoded at all.
+      const int skipLevel = stream->SkipLevel;
+      if (skipLevel != stream->AppliedSkipLevel) {
+        AVCodecContext* codecContext = stream->CodecContext.raw();
+        codecContext->skip_loop_filter = skipLevel >= 2   ? AVDISCARD_ALL
+                                         : skipLevel == 1 ? AVDISCARD_NONREF
+                                                          : AVDISCARD_DEFAULT;
+        codecContext->skip_frame =
+            skipLevel >= 2 ? AVDISCARD_NONREF : AVDISCARD_DEFAULT;
+        stream->AppliedSkipLevel = skipLevel;
+      }
+    }
+
     AVPacketItem packet = verifyPacket(peek);
     std::error_code ec;
 
@@ -380,8 +515,9 @@ template void FFmpegPlayer::Decode<AVMEDIA_TYPE_VIDEO>();
 template void FFmpegPlayer::Decode<AVMEDIA_TYPE_AUDIO>();
 
 void FFmpegPlayer::Stop() {
-  if (IsPlaying) {
+  if (IsPlaying || IsPrepared) {
     IsPlaying = false;
+    IsPrepared = false;
     PlaybackStarted = false;
     AbortRequest = true;
     ReadThread.join();
@@ -397,6 +533,9 @@ void FFmpegPlayer::Stop() {
     }
     FrameTimer = {};
     PreviousFrameTimestamp = {};
+    LateStreak = 0;
+    OnTimeStreak = 0;
+    FrameStats.SkipLevel = 0;
     FormatContext.close();
     StreamPtr.reset();
     if (VideoTexture) {
@@ -407,6 +546,12 @@ void FFmpegPlayer::Stop() {
   }
 }
 
+VideoMemoryStats FFmpegPlayer::GetMemoryStats() const {
+  return {.QueuedBytes = Memory.PacketBytes + Memory.FrameBytes,
+          .PeakQueuedBytes = Memory.PeakBytes,
+          .BudgetBytes = PacketQueueBudget + FrameQueueBudget};
+}
+
 void FFmpegPlayer::Seek(int64_t pos) {
   SeekRequest = true;
   SeekPosition = pos;
@@ -447,12 +592,13 @@ void FFmpegPlayer::Update(float dt) {
       duration = (frame->Timestamp.seconds() - PreviousFrameTimestamp);
     }
 
+    const double frameDuration =
+        ((double)VideoStream->stream.averageFrameRate().getDenominator() /
+         VideoStream->stream.averageFrameRate().getNumerator());
     if (AudioStream) {
       duration = GetTargetDelay(duration);
     } else {
-      duration =
-          ((double)VideoStream->stream.averageFrameRate().getDenominator() /
-           VideoStream->stream.averageFrameRate().getNumerator());
+      duration = frameDuration;
     }
 
     if (time < FrameTimer + duration) {
@@ -460,22 +606,70 @@ void FFmpegPlayer::Update(float dt) {
     }
 
     FrameTimer += duration;
+
+    // How far behind the frame is, against the audio when there is some
+    const double lateBy = AudioStream
+                              ? MasterClock->Get() - frame->Timestamp.seconds()
+                              : time - FrameTimer;
+    const bool late = PlaybackStarted && lateBy > frameDuration;
+    UpdateDecodeSkipping(late);
+
     if (duration > 0 && (time - FrameTimer) > 0.1) {
       FrameTimer = time;
     }
 
     PreviousFrameTimestamp = frame->Timestamp;
 
-    VideoTexture->Submit(frame->Frame.data(0), frame->Frame.data(1),
-                         frame->Frame.data(2));
+    // Once the next frame is due as well there is no point in uploading this
+    // one, it would only delay the next one further
+    if (late && VideoStream->FrameQueue.size_approx() > 1) {
+      FrameStats.Dropped++;
+    } else {
+      if (late) FrameStats.Late++;
+      FrameStats.Shown++;
+      VideoTexture->Submit(frame->Frame.data(0), frame->Frame.data(1),
+                           frame->Frame.data(2));
+    }
     VideoClock.Set(frame->Timestamp.seconds(), frame->Serial);
     MasterClock->SyncTo(&VideoClock);
     AVFrameItem<AVMEDIA_TYPE_VIDEO> unused;
     VideoStream->FrameQueue.wait_dequeue(unused);
+    if (!PlaybackStarted) {
+      LastVideoStart.TimeToFirstFrameMs =
+          std::chrono::duration<float, std::milli>(
+              std::chrono::steady_clock::now() - PlayRequestTime)
+              .count();
+    }
     PlaybackStarted = true;
   }
 }
 
+void FFmpegPlayer::UpdateDecodeSkipping(bool late) {
+  if (late) {
+    LateStreak++;
+    OnTimeStreak = 0;
+  } else {
+    OnTimeStreak++;
+    LateStreak = 0;
+  }
+
+  int skipLevel = VideoStream->SkipLevel;
+  if (LateStreak >= LateFramesToSkip && skipLevel < MaxSkipLevel) {
+    skipLevel++;
+    LateStreak = 0;
+  } else if (OnTimeStreak >= OnTimeFramesToRecover && skipLevel > 0) {
+    skipLevel--;
+    OnTimeStreak = 0;
+  } else {
+    return;
+  }
+
+  ImpLog(LogLevel::Debug, LogChannel::Video, "Decode skip level now {:d}\n",
+         skipLevel);
+  VideoStream->SkipLevel = skipLevel;
+  FrameStats.SkipLevel = skipLevel;
+}
+
 void FFmpegPlayer::Render(float videoAlpha) {
   if (IsPlaying && PlaybackStarted) {
     const RectF dest = {0.0f, 0.0f, Profile::DesignWidth,
@@ -22,8 +22,14 @@ class Stream;
 namespace Video {
 struct FFmpegFileIO : public av::CustomIO {
   FFmpegFileIO() = default;
-  FFmpegFileIO(Io::Stream* Stream) : FileStream(Stream) {}
+  FFmpegFileIO(Io::Stream* Stream)
+      : FileStream(Stream), MappedData(Stream->GetContiguousData()) {}
   Io::Stream* FileStream;
+  // Set when the file is a contiguous region of memory (usually an entry of a
+  // memory mapped archive), which is then read directly instead of through
+  // FileStream
+  const uint8_t* MappedData = nullptr;
+  int64_t MappedPosition = 0;
   int read(uint8_t* data, size_t size) override;
   int64_t seek(int64_t offset, int whence) override;
   int seekable() const override {
@@ -37,6 +43,7 @@ class FFmpegPlayer : public VideoPlayer {
 
   void Init() override;
 
+  void Prepare(Io::Stream* stream) override;
   void Play(Io::Stream* stream, bool loop, bool alpha) override;
   void Stop() override;
   void Seek(int64_t pos) override;
@@ -44,6 +51,8 @@ class FFmpegPlayer : public VideoPlayer {
   void Update(float dt) override;
   void Render(float videoAlpha) override;
 
+  VideoMemoryStats GetMemoryStats() const override;
+
   void Read();
   template <AVMediaType avType>
   void Decode();
@@ -52,6 +61,9 @@ class FFmpegPlayer : public VideoPlayer {
   std::atomic<bool> AbortRequest;
   bool SeekRequest;
   std::thread ReadThread;
+  // Declared ahead of the streams, whose queued items count towards it until
+  // they are destroyed
+  QueueMemory Memory;
   std::optional<FFmpegStream<AVMEDIA_TYPE_VIDEO>> VideoStream;
   std::optional<FFmpegStream<AVMEDIA_TYPE_AUDIO>> AudioStream;
 
@@ -61,12 +73,34 @@ class FFmpegPlayer : public VideoPlayer {
   bool QueuesHaveEnoughPackets();
 
   void HandleSeekRequest();
+  // Raises or lowers the video stream's skip level from how many frames in a
+  // row were late or on time
+  void UpdateDecodeSkipping(bool late);
+
+  // Opens the container and codecs and starts the reader and decoder threads
+  bool Open(Io::Stream* stream);
 
   template <AVMediaType MediaType>
   void OpenCodec(std::optional<FFmpegStream<MediaType>>& streamOpt,
                  av::Stream&& avStream, int streamId);
 
   static int constexpr FILESTREAMBUFFERSZ = 64 * 8192;
+  // libavformat reads anything larger than its IO buffer straight into the
+  // destination, so with a small buffer most packets are copied once, right
+  // out of the mapping
+  static int constexpr MAPPEDSTREAMBUFFERSZ = 4096;
+
+  // Queues are bounded by bytes so that higher resolutions don't multiply
+  // memory use, and several players can decode at once
+  static int64_t constexpr PacketQueueBudget = 16 * 1024 * 1024;
+  static int64_t constexpr FrameQueueBudget = 48 * 1024 * 1024;
+  static size_t constexpr MinFrameQueueCount = 4;
+
+  static int constexpr LateFramesToSkip = 8;
+  static int constexpr OnTimeFramesToRecover = 120;
+  static int constexpr MaxSkipLevel = 2;
+  int LateStreak = 0;
+  int OnTimeStreak = 0;
   std::condition_variable ReadCond;
 
   uint64_t Time;
@@ -89,6 +123,10 @@ class FFmpegPlayer : public VideoPlayer {
   bool Looping = false;
   bool ReaderEOF = false;
   bool PlaybackStarted = false;
+  // Opened by Prepare, decoding but not playing yet
+  bool IsPrepared = false;
+  Io::FileMeta PreparedMeta;
+  std::chrono::steady_clock::time_point PlayRequestTime;
   double PreviousFrameTimestamp = 0.0;
   double FrameTimer = 0.0;
   double MaxFrameDuration = 0.0;
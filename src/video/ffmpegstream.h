@@ -8,9 +8,11 @@
 #include "../impacto.h"
 #include "clock.h"
 
+#include <atomic>
 #include <thread>
 #include <memory>
 #include <type_traits>
+#include <utility>
 #if __SWITCH__
 #define __unix__
 #endif
@@ -49,9 +51,60 @@ using DecodingContext_t = typename AVTypes<MediaType>::DecodingContextType;
 template <AVMediaType MediaType>
 using Frame_t = typename AVTypes<MediaType>::FrameType;
 
+// Bytes held by a player's queued packets and frames
+struct QueueMemory {
+  std::atomic<int64_t> PacketBytes = 0;
+  std::atomic<int64_t> FrameBytes = 0;
+  std::atomic<int64_t> PeakBytes = 0;
+
+  void Add(std::atomic<int64_t>& counter, int64_t bytes) {
+    counter += bytes;
+    const int64_t total = PacketBytes + FrameBytes;
+    int64_t peak = PeakBytes;
+    while (total > peak && !PeakBytes.compare_exchange_weak(peak, total)) {
+    }
+  }
+};
+
+// Counts towards one of a QueueMemory's counters for as long as the queue
+// item holding it is alive, which covers its whole way through the queue and
+// out the other end without every consumer having to account for it
+class QueuedBytes {
+ public:
+  QueuedBytes() = default;
+  QueuedBytes(QueueMemory& memory, std::atomic<int64_t>& counter,
+              int64_t bytes)
+      : Memory(&memory), Counter(&counter), Bytes(bytes) {
+    Memory->Add(*Counter, Bytes);
+  }
+  QueuedBytes(QueuedBytes&& other) noexcept { *this = std::move(other); }
+  QueuedBytes& operator=(QueuedBytes&& other) noexcept {
+    if (this != &other) {
+      Release();
+      Memory = std::exchange(other.Memory, nullptr);
+      Counter = std::exchange(other.Counter, nullptr);
+      Bytes = std::exchange(other.Bytes, 0);
+    }
+    return *this;
+  }
+  ~QueuedBytes() { Release(); }
+
+ private:
+  void Release() {
+    if (Counter) *Counter -= Bytes;
+    Memory = nullptr;
+    Counter = nullptr;
+  }
+
+  QueueMemory* Memory = nullptr;
+  std::atomic<int64_t>* Counter = nullptr;
+  int64_t Bytes = 0;
+};
+
 struct AVPacketItem {
   av::Packet Packet;
   int Serial = -1;
+  QueuedBytes Memory;
 };
 
 template <AVMediaType MediaType>
@@ -59,18 +112,25 @@ struct AVFrameItem {
   Frame_t<MediaType> Frame;
   int Serial = -1;
   av::Timestamp Timestamp;
+  QueuedBytes Memory;
 };
 
 template <AVMediaType MediaType>
 struct FFmpegStream {
   DecodingContext_t<MediaType> CodecContext;
   av::Stream stream;
-  moodycamel::BlockingReaderWriterCircularBuffer<AVPacketItem> PacketQueue{25};
+  // Packets are mostly bounded by the player's packet byte budget
+  moodycamel::BlockingReaderWriterCircularBuffer<AVPacketItem> PacketQueue{
+      MaxPacketQueueCount};
   moodycamel::BlockingReaderWriterCircularBuffer<AVFrameItem<MediaType>>
-      FrameQueue{60};
+      FrameQueue{MaxFrameQueueCount};
   int Duration;
   int PacketQueueSerial = 0;
   int CurrentPacketSerial = 0;
+  // How much decoding work may be skipped to keep up, raised by the player
+  // when frames are late and applied by the decoder thread
+  std::atomic<int> SkipLevel = 0;
+  int AppliedSkipLevel = 0;
 
   std::thread DecoderThread;
 
@@ -84,6 +144,16 @@ struct FFmpegStream {
         stream(std::move(avStream)),
         Duration(duration) {}
 
+  FFmpegStream(av::Stream&& avStream, DecodingContext_t<MediaType>&& codecCtx,
+               int duration, size_t frameQueueCount)
+      : CodecContext(std::move(codecCtx)),
+        stream(std::move(avStream)),
+        FrameQueue(frameQueueCount),
+        Duration(duration) {}
+
+  static constexpr size_t MaxPacketQueueCount = 64;
+  static constexpr size_t MaxFrameQueueCount = 60;
+
   void FlushPacketQueue();
   void FlushFrameQueue();
 };
@@ -3,16 +3,59 @@
 #include "../impacto.h"
 #include "../io/stream.h"
 
+#include <atomic>
 #include <vector>
 
 namespace Impacto {
 namespace Video {
 
+struct VideoIoStats {
+  // Bytes handed to the demuxer by the players' IO callbacks
+  std::atomic<uint64_t> BytesRead = 0;
+  // Whether the last opened video is read straight from memory
+  std::atomic<bool> DirectFromMemory = false;
+};
+
+inline VideoIoStats DemuxerIoStats;
+
+struct VideoStartStats {
+  // From Play to the first frame being uploaded
+  float TimeToFirstFrameMs = 0.0f;
+  // Whether the video was prepared ahead of Play
+  bool Prepared = false;
+};
+
+inline VideoStartStats LastVideoStart;
+
+struct VideoFrameStats {
+  uint64_t Shown = 0;
+  // Shown, but more than a frame behind
+  uint64_t Late = 0;
+  // Decoded, but skipped without being uploaded
+  uint64_t Dropped = 0;
+  int SkipLevel = 0;
+
+  void Reset() { Shown = Late = Dropped = 0; }
+};
+
+inline VideoFrameStats FrameStats;
+
+struct VideoMemoryStats {
+  // Held by queued packets and decoded frames
+  int64_t QueuedBytes = 0;
+  int64_t PeakQueuedBytes = 0;
+  int64_t BudgetBytes = 0;
+};
+
 class VideoPlayer {
  public:
   static VideoPlayer* Create(Io::Stream* stream);
 
   virtual void Init() {};
+  // Starts demuxing and decoding the start of a video in the background,
+  // taking ownership of the stream, so a later Play of the same file can
+  // start on its first frame right away
+  virtual void Prepare(Io::Stream* stream) { delete stream; };
   virtual void Play(Io::Stream* stream, bool loop, bool alpha) {};
   virtual void Stop() {};
   virtual void Seek(int64_t pos) {};
@@ -20,6 +63,8 @@ class VideoPlayer {
   virtual void Update(float dt) {};
   virtual void Render(float videoAlpha) {};
 
+  virtual VideoMemoryStats GetMemoryStats() const { return {}; }
+
   bool IsPlaying = false;
 
  protected:
@@ -8,6 +8,7 @@
 #include "../mem.h"
 #include "../log.h"
 #include "../audio/audiostream.h"
+#include "../audio/voiceprefetch.h"
 #include "../profile/vm.h"
 #include "../hud/saveicondisplay.h"
 #include "../hud/tipsnotification.h"
@@ -159,12 +160,8 @@ VmInstruction(InstMes) {
   ScrWork[dialoguePage.Id + SW_ANIME0CHANO] = characterId;
 
   Audio::AudioStream* audioStream = nullptr;
-  if (voiced) {
-    Io::Stream* stream;
-    IoError err = Io::VfsOpen("voice", audioId, &stream);
-
-    bool playAudio = (err == IoError_OK && !GetFlag(SF_MESALLSKIP));
-    if (playAudio) audioStream = Audio::AudioStream::Create(stream);
+  if (voiced && !GetFlag(SF_MESALLSKIP)) {
+    audioStream = Audio::VoicePrefetch::Open(audioId).release();
   }
 
   uint32_t oldIp = thread->IpOffset;
@@ -144,8 +144,15 @@ VmInstruction(InstMovieMain) {
 VmInstruction(InstLoadMovie) {
   StartInstruction;
   PopExpression(arg1);
-  ImpLogSlow(LogLevel::Warning, LogChannel::VMStub,
-             "STUB instruction LoadMovie(arg1: {:d})\n", arg1);
+  // Assuming arg1 is the movie to be played next, preroll it so PlayMovie
+  // starts on its first frame. A wrong guess only costs the decoding, Play
+  // opens the right file as usual.
+  if (Profile::GameFeatures & GameFeature::Video) {
+    Io::Stream* stream;
+    if (Io::VfsOpen("movie", arg1, &stream) == IoError_OK) {
+      Video::Players[0]->Prepare(stream);
+    }
+  }
 }
 VmInstruction(InstPlayMovieMemory) {
   StartInstruction;
@@ -191,6 +191,7 @@ bool LoadScript(uint32_t bufferId, uint32_t scriptId) {
     return false;
   }
   ScriptBuffers[bufferId] = std::span(static_cast<uint8_t*>(file), fileSize);
+  ScriptBufferGenerations[bufferId] = ++LastScriptBufferGeneration;
   ScrWork[SW_SCRIPTNO0 + bufferId] = scriptId;
   LoadedScriptMetas[bufferId] = meta;
   return true;
@@ -41,6 +41,10 @@ void RunThread(Sc3VmThread* thread);
 
 inline std::span<uint8_t> ScriptBuffers[MaxLoadedScripts];
 inline std::span<uint8_t> MsbBuffers[MaxLoadedScripts];
+// Changes whenever a buffer's contents do, so anything keyed on script buffer
+// offsets (see TextLayoutCache) can tell scripts apart
+inline uint32_t ScriptBufferGenerations[MaxLoadedScripts];
+inline uint32_t LastScriptBufferGeneration = 0;
 
 inline Io::FileMeta LoadedScriptMetas[MaxLoadedScripts];
 
@@ -0,0 +1,251 @@
+// Decodes a corpus of ADX files with both the engine's batched decoder and the
+// previous frame-at-a-time decoder, checks that both produce identical
+// samples and reports how long each took.
+//
+// Usage: adxbench [-n iterations] <file or directory>...
+
+#include "../../src/audio/adxdecoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Impacto::Audio;
+
+namespace {
+
+struct AdxFile {
+  std::string Path;
+  std::vector<uint8_t> Data;
+  AdxDecoderState InitialState;
+  int DataOffset;
+  int SampleCount;
+};
+
+uint16_t ReadBE16(const uint8_t* data) { return (data[0] << 8) | data[1]; }
+uint32_t ReadBE32(const uint8_t* data) {
+  return ((uint32_t)ReadBE16(data) << 16) | ReadBE16(data + 2);
+}
+
+// Same subset of ADX the engine supports, see ParseAdxHeader
+bool ParseHeader(AdxFile& file) {
+  const std::vector<uint8_t>& data = file.Data;
+  if (data.size() < 0x34 || ReadBE16(data.data()) != 0x8000) return false;
+
+  file.DataOffset = ReadBE16(data.data() + 2) + 4;
+  if (file.DataOffset < 6 || (size_t)file.DataOffset > data.size() ||
+      memcmp(data.data() + file.DataOffset - 6, "(c)CRI", 6) != 0) {
+    return false;
+  }
+
+  if (data[4] != 3 || data[6] != 4 || data[18] != 4 || data[19] != 0) {
+    return false;
+  }
+
+  AdxDecoderState& state = file.InitialState;
+  state.FrameSize = data[5];
+  state.ChannelCount = data[7];
+  if (state.ChannelCount != 1 && state.ChannelCount != 2) return false;
+  if (state.FrameSize <= 2) return false;
+
+  const uint32_t sampleRate = ReadBE32(data.data() + 8);
+  file.SampleCount = (int)ReadBE32(data.data() + 12);
+  const uint16_t highpass = ReadBE16(data.data() + 16);
+
+  state.Hist1[0] = (int16_t)ReadBE16(data.data() + 0x18);
+  state.Hist2[0] = (int16_t)ReadBE16(data.data() + 0x1A);
+  state.Hist1[1] = (int16_t)ReadBE16(data.data() + 0x1C);
+  state.Hist2[1] = (int16_t)ReadBE16(data.data() + 0x1E);
+  AdxSetCoefficients(state, highpass, sampleRate);
+
+  return true;
+}
+
+// The decoder as it was before block-batch decoding, one frame per call
+// with per-sample interleaved writes
+int nibble_to_int[16] = {0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1};
+
+int clamp16(int32_t val) {
+  if (val > 32767) return 32767;
+  if (val < -32768) return -32768;
+  return val;
+}
+
+void ReferenceDecodeFrame(AdxDecoderState& state, const uint8_t* input,
+                          int16_t* output) {
+  const int samplesPerFrame = state.SamplesPerFrame();
+  for (int c = 0; c < state.ChannelCount; c++) {
+    int scale = ReadBE16(input) + 1;
+    input += 2;
+
+    for (int i = 0; i < samplesPerFrame; i++) {
+      uint8_t sample_byte = input[i / 2];
+
+      output[i * state.ChannelCount + c] = (int16_t)(clamp16(
+          (i & 1 ? nibble_to_int[sample_byte & 0xf]
+                 : nibble_to_int[sample_byte >> 4]) *
+              scale +
+          (state.Coef1 * state.Hist1[c] >> 12) +
+          (state.Coef2 * state.Hist2[c] >> 12)));
+
+      state.Hist2[c] = state.Hist1[c];
+      state.Hist1[c] = output[i * state.ChannelCount + c];
+    }
+    input += samplesPerFrame / 2;
+  }
+}
+
+// Both decoders decode whole buffers like the stream does, the final one
+// padded with zeroes, and the result is cut to the sample count
+std::vector<int16_t> DecodeReference(const AdxFile& file,
+                                     std::vector<uint8_t>& padded) {
+  AdxDecoderState state = file.InitialState;
+  const int frameBytes = state.FrameSize * state.ChannelCount;
+  const int samplesPerFrame = state.SamplesPerFrame();
+  const int frameCount =
+      (file.SampleCount + samplesPerFrame - 1) / samplesPerFrame;
+
+  std::vector<int16_t> output((size_t)frameCount * samplesPerFrame *
+                              state.ChannelCount);
+  for (int frame = 0; frame < frameCount; frame++) {
+    ReferenceDecodeFrame(
+        state, padded.data() + (size_t)frame * frameBytes,
+        output.data() + (size_t)frame * samplesPerFrame * state.ChannelCount);
+  }
+  output.resize((size_t)file.SampleCount * state.ChannelCount);
+  return output;
+}
+
+std::vector<int16_t> DecodeBatched(const AdxFile& file,
+                                   std::vector<uint8_t>& padded,
+                                   int framesPerBuffer) {
+  AdxDecoderState state = file.InitialState;
+  const int frameBytes = state.FrameSize * state.ChannelCount;
+  const int samplesPerFrame = state.SamplesPerFrame();
+  const int samplesPerBuffer = samplesPerFrame * framesPerBuffer;
+  const int bufferCount =
+      (file.SampleCount + samplesPerBuffer - 1) / samplesPerBuffer;
+
+  std::vector<int16_t> output((size_t)bufferCount * samplesPerBuffer *
+                              state.ChannelCount);
+  std::vector<int16_t> lanes((size_t)samplesPerBuffer * state.ChannelCount);
+  for (int buffer = 0; buffer < bufferCount; buffer++) {
+    AdxDecodeFrames(
+        state, padded.data() + (size_t)buffer * framesPerBuffer * frameBytes,
+        framesPerBuffer,
+        output.data() +
+            (size_t)buffer * samplesPerBuffer * state.ChannelCount,
+        lanes.data());
+  }
+  output.resize((size_t)file.SampleCount * state.ChannelCount);
+  return output;
+}
+
+bool LoadFile(const std::filesystem::path& path, std::vector<AdxFile>& files) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) return false;
+
+  AdxFile file;
+  file.Path = path.string();
+  file.Data.assign(std::istreambuf_iterator<char>(in),
+                   std::istreambuf_iterator<char>());
+  if (!ParseHeader(file)) return false;
+
+  files.push_back(std::move(file));
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  // Matches AdxAudioStream::FramesPerBuffer
+  constexpr int framesPerBuffer = 64;
+  int iterations = 10;
+
+  std::vector<AdxFile> files;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      iterations = std::max(1, atoi(argv[++i]));
+      continue;
+    }
+
+    std::filesystem::path path(argv[i]);
+    if (std::filesystem::is_directory(path)) {
+      for (const auto& entry :
+           std::filesystem::recursive_directory_iterator(path)) {
+        if (entry.is_regular_file()) LoadFile(entry.path(), files);
+      }
+    } else if (!LoadFile(path, files)) {
+      fprintf(stderr, "Skipping %s, not a supported ADX file\n", argv[i]);
+    }
+  }
+
+  if (files.empty()) {
+    fprintf(stderr, "Usage: %s [-n iterations] <file or directory>...\n",
+            argv[0]);
+    return 1;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  Clock::duration referenceTime{}, batchedTime{};
+  uint64_t totalSamples = 0;
+  int mismatches = 0;
+
+  for (const AdxFile& file : files) {
+    const int frameBytes =
+        file.InitialState.FrameSize * file.InitialState.ChannelCount;
+    const int samplesPerBuffer =
+        file.InitialState.SamplesPerFrame() * framesPerBuffer;
+    const size_t bufferCount =
+        (file.SampleCount + samplesPerBuffer - 1) / samplesPerBuffer;
+
+    std::vector<uint8_t> padded(bufferCount * framesPerBuffer * frameBytes);
+    std::copy_n(file.Data.begin() + file.DataOffset,
+                std::min(padded.size(), file.Data.size() - file.DataOffset),
+                padded.begin());
+
+    std::vector<int16_t> reference, batched;
+    for (int i = 0; i < iterations; i++) {
+      auto start = Clock::now();
+      reference = DecodeReference(file, padded);
+      referenceTime += Clock::now() - start;
+
+      start = Clock::now();
+      batched = DecodeBatched(file, padded, framesPerBuffer);
+      batchedTime += Clock::now() - start;
+    }
+    totalSamples += (uint64_t)file.SampleCount * iterations;
+
+    auto mismatch =
+        std::mismatch(reference.begin(), reference.end(), batched.begin());
+    if (mismatch.first != reference.end()) {
+      mismatches++;
+      fprintf(stderr, "MISMATCH %s at sample %zu: %d != %d\n",
+              file.Path.c_str(),
+              (size_t)(mismatch.first - reference.begin()), *mismatch.first,
+              *mismatch.second);
+    }
+  }
+
+  auto toSeconds = [](Clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+  };
+  printf("%zu files, %d iterations, %llu samples per decoder\n", files.size(),
+         iterations, (unsigned long long)totalSamples);
+  printf("reference: %8.3f s (%7.2f Msamples/s)\n", toSeconds(referenceTime),
+         totalSamples / toSeconds(referenceTime) / 1e6);
+  printf("batched:   %8.3f s (%7.2f Msamples/s)\n", toSeconds(batchedTime),
+         totalSamples / toSeconds(batchedTime) / 1e6);
+  printf("speedup:   %8.2fx\n", toSeconds(referenceTime) /
+                                    toSeconds(batchedTime));
+  printf("%s\n", mismatches == 0 ? "all samples identical"
+                                 : "OUTPUT DIFFERS");
+
+  return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+// Transcodes every audio file of one or more archives into raw PCM clips,
+// packed into an audio pack (see AudioPackArchive) that can be mounted in
+// place of the original archives. Files keep their IDs and names, files no
+// decoder recognizes are copied as they are.
+//
+// Trades disk space for CPU time on devices where decoding HCA, ATRAC9 and
+// friends while playing is too expensive.
+//
+// Usage: audiotranscode <output pack> <archive>...
+
+#include "../../src/io/vfs.h"
+#include "../../src/io/audiopackarchive.h"
+#include "../../src/audio/audiostream.h"
+#include "../../src/audio/pcmaudiostream.h"
+#include "../../src/profile/vfs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Impacto;
+
+// Mounts come from the command line, there is no profile to configure them
+namespace Impacto::Profile::Vfs {
+void Configure() {}
+}  // namespace Impacto::Profile::Vfs
+
+namespace {
+
+char const* const InputMount = "input";
+
+struct PackEntry {
+  uint32_t Id;
+  std::string Name;
+  uint64_t Offset = 0;
+  uint64_t Size = 0;
+  bool Written = false;
+};
+
+void PutLE(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) out.push_back((value >> (i * 8)) & 0xFF);
+}
+
+void PutBE32(std::vector<uint8_t>& out, uint32_t value) {
+  for (int i = 3; i >= 0; i--) out.push_back((value >> (i * 8)) & 0xFF);
+}
+
+std::vector<uint8_t> BuildToc(std::vector<PackEntry> const& entries) {
+  std::vector<uint8_t> toc;
+  PutBE32(toc, Io::AudioPackArchive::Magic);
+  PutLE(toc, Io::AudioPackArchive::Version, 4);
+  PutLE(toc,
+        std::count_if(entries.begin(), entries.end(),
+                      [](PackEntry const& entry) { return entry.Written; }),
+        4);
+  for (PackEntry const& entry : entries) {
+    if (!entry.Written) continue;
+    PutLE(toc, entry.Id, 4);
+    PutLE(toc, entry.Offset, 8);
+    PutLE(toc, entry.Size, 8);
+    PutLE(toc, entry.Name.size(), 2);
+    toc.insert(toc.end(), entry.Name.begin(), entry.Name.end());
+  }
+  return toc;
+}
+
+// Decodes the whole stream into a PCM clip, empty if it can't be represented
+std::vector<uint8_t> Transcode(Audio::AudioStream& stream) {
+  if (stream.Duration < 0 || stream.ReadPosition > stream.Duration ||
+      (stream.BitDepth != 16 && stream.BitDepth != 32)) {
+    return {};
+  }
+
+  std::vector<uint8_t> clip;
+  PutBE32(clip, Audio::PcmClipHeader::Magic);
+  clip.push_back(Audio::PcmClipHeader::Version);
+  clip.push_back((uint8_t)stream.ChannelCount);
+  clip.push_back((uint8_t)stream.BitDepth);
+  clip.push_back(0);
+  PutLE(clip, stream.SampleRate, 4);
+  PutLE(clip, stream.ReadPosition, 4);
+  PutLE(clip, stream.Duration, 4);
+  PutLE(clip, stream.LoopStart, 4);
+  PutLE(clip, stream.LoopEnd, 4);
+
+  const size_t bytesPerSample = stream.BytesPerSample();
+  const size_t headerSize = clip.size();
+  clip.resize(headerSize +
+              (stream.Duration - stream.ReadPosition) * bytesPerSample);
+
+  uint8_t* out = clip.data() + headerSize;
+  while (stream.ReadPosition < stream.Duration) {
+    const int samples = std::min(4096, stream.Duration - stream.ReadPosition);
+    const int read = stream.Read(out, samples);
+    if (read <= 0) {
+      std::fprintf(stderr, "  decoding stopped at sample %d of %d\n",
+                   stream.ReadPosition, stream.Duration);
+      return {};
+    }
+    out += read * bytesPerSample;
+  }
+
+  return clip;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::fprintf(stderr, "Usage: %s <output pack> <archive>...\n", argv[0]);
+    return 1;
+  }
+
+  Io::VfsInit();
+  for (int i = 2; i < argc; i++) {
+    if (Io::VfsMount(InputMount, argv[i]) != IoError_OK) {
+      std::fprintf(stderr, "Could not mount %s\n", argv[i]);
+      return 1;
+    }
+  }
+
+  std::map<uint32_t, std::string> listing;
+  Io::VfsListFiles(InputMount, listing);
+
+  std::vector<PackEntry> entries;
+  // Everything is assumed written until it turns out otherwise, so the
+  // placeholder TOC is as large as it can get
+  for (auto const& [id, name] : listing) {
+    entries.push_back({.Id = id, .Name = name, .Written = true});
+  }
+
+  std::ofstream output(argv[1], std::ios::binary | std::ios::trunc);
+  if (!output) {
+    std::fprintf(stderr, "Could not open %s for writing\n", argv[1]);
+    return 1;
+  }
+
+  // The TOC's size doesn't depend on the offsets, so reserve it now and fill
+  // it in once every file is written
+  const std::vector<uint8_t> placeholder = BuildToc(entries);
+  output.write((char const*)placeholder.data(), placeholder.size());
+
+  uint64_t offset = placeholder.size();
+  uint64_t inputBytes = 0;
+  int transcoded = 0;
+  int copied = 0;
+  double decodeSeconds = 0.0;
+
+  for (PackEntry& entry : entries) {
+    Io::Stream* stream;
+    if (Io::VfsOpen(InputMount, entry.Id, &stream) != IoError_OK) {
+      std::fprintf(stderr, "Could not open %s, skipping\n", entry.Name.c_str());
+      entry.Written = false;
+      continue;
+    }
+    inputBytes += stream->Meta.Size;
+
+    std::vector<uint8_t> data;
+    const auto startTime = std::chrono::steady_clock::now();
+    std::unique_ptr<Audio::AudioStream> audioStream(
+        Audio::AudioStream::Create(stream));
+    if (audioStream) {
+      data = Transcode(*audioStream);
+      audioStream = nullptr;
+      decodeSeconds += std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - startTime)
+                           .count();
+    } else {
+      delete stream;
+    }
+
+    if (!data.empty()) {
+      transcoded++;
+    } else {
+      void* memory;
+      int64_t size;
+      if (Io::VfsSlurp(InputMount, entry.Id, memory, size) != IoError_OK) {
+        std::fprintf(stderr, "Could not read %s, skipping\n",
+                     entry.Name.c_str());
+        entry.Written = false;
+        continue;
+      }
+      data.assign((uint8_t*)memory, (uint8_t*)memory + size);
+      free(memory);
+      copied++;
+    }
+
+    const uint64_t padding =
+        (Io::AudioPackArchive::DataAlignment -
+         offset % Io::AudioPackArchive::DataAlignment) %
+        Io::AudioPackArchive::DataAlignment;
+    output.write(std::string(padding, '\0').data(), padding);
+    offset += padding;
+
+    entry.Offset = offset;
+    entry.Size = data.size();
+    output.write((char const*)data.data(), data.size());
+    offset += data.size();
+  }
+
+  const std::vector<uint8_t> toc = BuildToc(entries);
+  output.seekp(0);
+  output.write((char const*)toc.data(), toc.size());
+  if (!output) {
+    std::fprintf(stderr, "Failed writing %s\n", argv[1]);
+    return 1;
+  }
+
+  std::printf(
+      "%d files transcoded, %d copied\n"
+      "%.2f MiB in, %.2f MiB out, %.2f s spent decoding\n",
+      transcoded, copied, inputBytes / (1024.0 * 1024.0),
+      offset / (1024.0 * 1024.0), decodeSeconds);
+  return 0;
+}
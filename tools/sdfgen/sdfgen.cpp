@@ -0,0 +1,244 @@
+// Converts a basic font's glyph sheet into the signed distance field sheet of
+// an SDF font (see SDFFont). Every cell is padded by the spread on all sides
+// so outlines and shadows have room, and the field can be stored at a fraction
+// of the source resolution since it is magnified without getting blurry.
+//
+// The input is any image stb_image reads, glyph coverage is taken from alpha
+// (or luminance for opaque sheets). The output is a plain 8-bit alpha texture
+// the engine loads as is. The profile values of the new font are printed.
+//
+// Usage: sdfgen <input image> <columns> <rows> <output> [spread] [downscale]
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+// Stands in for infinity, which would turn the parabola intersections into NaN
+float const Far = 1e20f;
+
+// Squared euclidean distance transform of one row or column, after
+// Felzenszwalb and Huttenlocher. f holds 0 at feature pixels and Far
+// everywhere else, and receives the squared distance to the closest feature.
+void DistanceTransform1D(float* f, int n, int stride,
+                         std::vector<float>& scratch, std::vector<int>& v,
+                         std::vector<float>& z) {
+  scratch.resize(n);
+  v.resize(n);
+  z.resize(n + 1);
+  for (int q = 0; q < n; q++) scratch[q] = f[q * stride];
+
+  // Lower envelope of the parabolas rooted at every pixel
+  int k = 0;
+  v[0] = 0;
+  z[0] = -Far;
+  z[1] = Far;
+  for (int q = 1; q < n; q++) {
+    const auto intersection = [&](int r) {
+      return ((scratch[q] + q * q) - (scratch[r] + r * r)) / (2.0f * (q - r));
+    };
+    float s = intersection(v[k]);
+    while (s <= z[k]) s = intersection(v[--k]);
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = Far;
+  }
+
+  k = 0;
+  for (int q = 0; q < n; q++) {
+    while (z[k + 1] < q) k++;
+    const float dq = (float)(q - v[k]);
+    f[q * stride] = dq * dq + scratch[v[k]];
+  }
+}
+
+// Distance from every pixel to the closest pixel for which feature is true
+std::vector<float> DistanceTransform(std::vector<bool> const& feature,
+                                     int width, int height) {
+  std::vector<float> result(feature.size());
+  for (size_t i = 0; i < feature.size(); i++) {
+    result[i] = feature[i] ? 0.0f : Far;
+  }
+
+  std::vector<float> scratch;
+  std::vector<int> v;
+  std::vector<float> z;
+  for (int x = 0; x < width; x++) {
+    DistanceTransform1D(&result[x], height, width, scratch, v, z);
+  }
+  for (int y = 0; y < height; y++) {
+    DistanceTransform1D(&result[y * width], width, 1, scratch, v, z);
+  }
+
+  for (float& distance : result) distance = std::sqrt(distance);
+  return result;
+}
+
+// Signed distance in source pixels to the glyph's edge, positive inside, for
+// every pixel of a cell padded by spread
+std::vector<float> CellDistanceField(std::vector<float> const& coverage,
+                                     int width, int height) {
+  std::vector<bool> inside(coverage.size());
+  std::vector<bool> outside(coverage.size());
+  for (size_t i = 0; i < coverage.size(); i++) {
+    inside[i] = coverage[i] >= 0.5f;
+    outside[i] = !inside[i];
+  }
+
+  const std::vector<float> toInside = DistanceTransform(inside, width, height);
+  const std::vector<float> toOutside =
+      DistanceTransform(outside, width, height);
+
+  std::vector<float> result(coverage.size());
+  for (size_t i = 0; i < coverage.size(); i++) {
+    if (coverage[i] > 0.0f && coverage[i] < 1.0f) {
+      // Antialiased edge pixels know better than the binarized image
+      result[i] = coverage[i] - 0.5f;
+    } else if (inside[i]) {
+      result[i] = toOutside[i] - 0.5f;
+    } else {
+      result[i] = 0.5f - toInside[i];
+    }
+  }
+  return result;
+}
+
+float SampleBilinear(std::vector<float> const& field, int width, int height,
+                     float x, float y) {
+  x = std::clamp(x, 0.0f, (float)(width - 1));
+  y = std::clamp(y, 0.0f, (float)(height - 1));
+  const int x0 = (int)x;
+  const int y0 = (int)y;
+  const int x1 = std::min(x0 + 1, width - 1);
+  const int y1 = std::min(y0 + 1, height - 1);
+  const float fx = x - x0;
+  const float fy = y - y0;
+
+  const float top =
+      field[y0 * width + x0] * (1 - fx) + field[y0 * width + x1] * fx;
+  const float bottom =
+      field[y1 * width + x0] * (1 - fx) + field[y1 * width + x1] * fx;
+  return top * (1 - fy) + bottom * fy;
+}
+
+float Luminance(uint8_t const* rgb) {
+  return (rgb[0] * 0.299f + rgb[1] * 0.587f + rgb[2] * 0.114f) / 255.0f;
+}
+
+void PutLE(std::vector<uint8_t>& out, uint32_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) out.push_back((value >> (i * 8)) & 0xFF);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 5) {
+    std::fprintf(stderr,
+                 "Usage: %s <input image> <columns> <rows> <output> [spread] "
+                 "[downscale]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  const int columns = std::atoi(argv[2]);
+  const int rows = std::atoi(argv[3]);
+  const int spread = argc > 5 ? std::atoi(argv[5]) : 4;
+  const int downscale = argc > 6 ? std::atoi(argv[6]) : 1;
+  if (columns <= 0 || rows <= 0 || spread <= 0 || downscale <= 0) {
+    std::fprintf(stderr, "Columns, rows, spread and downscale must be > 0\n");
+    return 1;
+  }
+
+  int width, height, channels;
+  uint8_t* image = stbi_load(argv[1], &width, &height, &channels, 4);
+  if (!image) {
+    std::fprintf(stderr, "Could not read %s: %s\n", argv[1],
+                 stbi_failure_reason());
+    return 1;
+  }
+  const bool hasAlpha = channels == 2 || channels == 4;
+
+  const int cellWidth = width / columns;
+  const int cellHeight = height / rows;
+  const int paddedWidth = cellWidth + 2 * spread;
+  const int paddedHeight = cellHeight + 2 * spread;
+  // Cells stay on the grid in UV space, so rounding up only stretches each
+  // cell's field very slightly
+  const int outCellWidth = (paddedWidth + downscale - 1) / downscale;
+  const int outCellHeight = (paddedHeight + downscale - 1) / downscale;
+  const int outWidth = outCellWidth * columns;
+  const int outHeight = outCellHeight * rows;
+  if (outWidth > UINT16_MAX || outHeight > UINT16_MAX) {
+    std::fprintf(stderr, "Output of %dx%d is too large\n", outWidth,
+                 outHeight);
+    stbi_image_free(image);
+    return 1;
+  }
+
+  std::vector<uint8_t> output((size_t)outWidth * outHeight);
+  std::vector<float> coverage((size_t)paddedWidth * paddedHeight);
+  for (int row = 0; row < rows; row++) {
+    for (int col = 0; col < columns; col++) {
+      // Every cell on its own, neighbours must not bleed into the padding
+      std::fill(coverage.begin(), coverage.end(), 0.0f);
+      for (int y = 0; y < cellHeight; y++) {
+        for (int x = 0; x < cellWidth; x++) {
+          const size_t index =
+              (size_t)(row * cellHeight + y) * width + col * cellWidth + x;
+          const uint8_t* pixel = image + index * 4;
+          const float value = hasAlpha ? pixel[3] / 255.0f : Luminance(pixel);
+          coverage[(y + spread) * paddedWidth + x + spread] = value;
+        }
+      }
+
+      const std::vector<float> field =
+          CellDistanceField(coverage, paddedWidth, paddedHeight);
+
+      for (int y = 0; y < outCellHeight; y++) {
+        for (int x = 0; x < outCellWidth; x++) {
+          const float distance = SampleBilinear(
+              field, paddedWidth, paddedHeight,
+              (x + 0.5f) * paddedWidth / outCellWidth - 0.5f,
+              (y + 0.5f) * paddedHeight / outCellHeight - 0.5f);
+          const float value =
+              std::clamp(0.5f + distance / (2.0f * spread), 0.0f, 1.0f);
+          output[(size_t)(row * outCellHeight + y) * outWidth +
+                 col * outCellWidth + x] = (uint8_t)std::lround(value * 255);
+        }
+      }
+    }
+  }
+  stbi_image_free(image);
+
+  std::ofstream file(argv[4], std::ios::binary | std::ios::trunc);
+  // Plain texture header: u16 width, u16 height, u32 mode (8-bit alpha)
+  std::vector<uint8_t> header;
+  PutLE(header, outWidth, 2);
+  PutLE(header, outHeight, 2);
+  PutLE(header, 8 | (1 << 16), 4);
+  file.write((char const*)header.data(), header.size());
+  file.write((char const*)output.data(), output.size());
+  if (!file) {
+    std::fprintf(stderr, "Failed writing %s\n", argv[4]);
+    return 1;
+  }
+
+  std::printf(
+      "%dx%d cells of %dx%d, field is %dx%d\n"
+      "Sheet: DesignWidth = %d, DesignHeight = %d\n"
+      "Font: Type = FontType.SDF, Columns = %d, Rows = %d, Spread = %d,\n"
+      "      BitmapEmWidth/BitmapEmHeight and the advance widths of the\n"
+      "      original font (which defaulted to %dx%d), and its sheet as\n"
+      "      FallbackSheet for renderers without the SDF shaders\n",
+      columns, rows, cellWidth, cellHeight, outWidth, outHeight,
+      paddedWidth * columns, paddedHeight * rows, columns, rows, spread,
+      cellWidth, cellHeight);
+  return 0;
+}